@@ -9,15 +9,26 @@
 #include "bench/CodecBenchPriv.h"
 #include "include/codec/SkAndroidCodec.h"
 #include "include/core/SkBitmap.h"
+#include "include/core/SkPixmap.h"
+#include "include/core/SkSamplingOptions.h"
 #include "src/core/SkOSFile.h"
 #include "tools/flags/CommandLineFlags.h"
 
-AndroidCodecBench::AndroidCodecBench(SkString baseName, SkData* encoded, int sampleSize)
+AndroidCodecBench::AndroidCodecBench(SkString baseName, SkData* encoded, int sampleSize,
+                                     Mode mode)
     : fData(SkRef(encoded))
     , fSampleSize(sampleSize)
+    , fMode(mode)
 {
     // Parse filename and the color type to give the benchmark a useful name
-    fName.printf("AndroidCodec_%s_SampleSize%d", baseName.c_str(), sampleSize);
+    const char* modeName = "";
+    switch (mode) {
+        case Mode::kSample:          modeName = "";                 break;
+        case Mode::kBox:             modeName = "Box_";             break;
+        case Mode::kMitchell:        modeName = "Mitchell_";        break;
+        case Mode::kDecodeThenScale: modeName = "DecodeThenScale_"; break;
+    }
+    fName.printf("AndroidCodec_%s_%sSampleSize%d", baseName.c_str(), modeName, sampleSize);
 }
 
 const char* AndroidCodecBench::onGetName() {
@@ -44,8 +55,34 @@ void AndroidCodecBench::onDraw(int n, SkCanvas* canvas) {
     std::unique_ptr<SkAndroidCodec> codec;
     SkAndroidCodec::AndroidOptions options;
     options.fSampleSize = fSampleSize;
+    switch (fMode) {
+        case Mode::kSample:
+        case Mode::kDecodeThenScale:
+            break;
+        case Mode::kBox:
+            options.fResampleFilter = SkAndroidCodec::ResampleFilter::kBox;
+            break;
+        case Mode::kMitchell:
+            options.fResampleFilter = SkAndroidCodec::ResampleFilter::kMitchell;
+            break;
+    }
     for (int i = 0; i < n; i++) {
         codec = SkAndroidCodec::MakeFromData(fData);
+        if (fMode == Mode::kDecodeThenScale) {
+            // Hold the whole image, as a decode followed by a scale must.
+            SkBitmap full;
+            full.allocPixels(codec->getInfo().makeColorType(fInfo.colorType())
+                                             .makeAlphaType(fInfo.alphaType()));
+#ifdef SK_DEBUG
+            const SkCodec::Result result =
+#endif
+            codec->getAndroidPixels(full.info(), full.getPixels(), full.rowBytes());
+            SkASSERT(result == SkCodec::kSuccess || result == SkCodec::kIncompleteInput);
+            const SkPixmap dst(fInfo, fPixelStorage.get(), fInfo.minRowBytes());
+            full.pixmap().scalePixels(dst, SkSamplingOptions(SkFilterMode::kLinear,
+                                                             SkMipmapMode::kLinear));
+            continue;
+        }
 #ifdef SK_DEBUG
         const SkCodec::Result result =
 #endif
@@ -20,8 +20,16 @@
  */
 class AndroidCodecBench : public Benchmark {
 public:
+    enum class Mode {
+        kSample,            // AndroidOptions::fSampleSize.
+        kBox,               // ResampleFilter::kBox to the same size.
+        kMitchell,          // ResampleFilter::kMitchell to the same size.
+        kDecodeThenScale,   // Full decode, then SkPixmap::scalePixels() to the same size.
+    };
+
     // Calls encoded->ref()
-    AndroidCodecBench(SkString basename, SkData* encoded, int sampleSize);
+    AndroidCodecBench(SkString basename, SkData* encoded, int sampleSize,
+                      Mode mode = Mode::kSample);
 
 protected:
     const char* onGetName() override;
@@ -33,6 +41,7 @@ private:
     SkString                fName;
     sk_sp<SkData>           fData;
     const int               fSampleSize;
+    const Mode              fMode;
     SkImageInfo             fInfo;          // Set in onDelayedSetup.
     SkAutoMalloc            fPixelStorage;  // Set in onDelayedSetup.
     using INHERITED = Benchmark;
@@ -7,10 +7,16 @@
 
 #include "bench/Benchmark.h"
 #include "bench/BigPath.h"
+#include "include/core/SkBitmap.h"
 #include "include/core/SkCanvas.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkGraphics.h"
 #include "include/core/SkPath.h"
+#include "src/base/SkRandom.h"
 #include "tools/ToolUtils.h"
 
+#include <memory>
+
 enum Align {
     kLeft_Align,
     kMiddle_Align,
@@ -83,3 +89,93 @@ DEF_BENCH( return new BigPathBench(kRight_Align,    false); )
 DEF_BENCH( return new BigPathBench(kLeft_Align,     true); )
 DEF_BENCH( return new BigPathBench(kMiddle_Align,   true); )
 DEF_BENCH( return new BigPathBench(kRight_Align,    true); )
+
+// Fills a giant path, the size of a map or plot, into its own 2048x2048 bitmap, with a thread
+// pool installed by SkGraphics::SetPathFillExecutor(). threads == 0 fills on this thread.
+class GiantPathBench : public Benchmark {
+public:
+    enum Kind {
+        kParcels,    // ~40K small polygons (~240K points), like a land-use map.
+        kCoastline,  // One jagged ~250K point contour around the whole bitmap.
+    };
+
+    GiantPathBench(Kind kind, int threads) : fKind(kind), fThreads(threads) {
+        fName.printf("giantpath_%s_threads_%d",
+                     kind == kParcels ? "parcels" : "coastline", threads);
+    }
+
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        fBitmap.allocN32Pixels(kSize, kSize);
+
+        SkRandom rand;
+        if (fKind == kParcels) {
+            for (int y = 0; y < 200; y++)
+            for (int x = 0; x < 200; x++) {
+                const SkScalar cx = 6 + x * 10.2f,
+                               cy = 6 + y * 10.2f;
+                const int n = 5 + (rand.nextU() & 1);
+                for (int i = 0; i < n; i++) {
+                    const SkScalar r = rand.nextRangeScalar(3, 5.5f),
+                                   a = i * 2 * SK_ScalarPI / n;
+                    const SkPoint pt = {cx + r * SkScalarCos(a), cy + r * SkScalarSin(a)};
+                    if (i == 0) {
+                        fPath.moveTo(pt);
+                    } else {
+                        fPath.lineTo(pt);
+                    }
+                }
+                fPath.close();
+            }
+        } else {
+            const int n = 250000;
+            for (int i = 0; i < n; i++) {
+                const SkScalar r = 900 + rand.nextRangeScalar(-60, 60),
+                               a = i * 2 * SK_ScalarPI / n;
+                const SkPoint pt = {1024 + r * SkScalarCos(a), 1024 + r * SkScalarSin(a)};
+                if (i == 0) {
+                    fPath.moveTo(pt);
+                } else {
+                    fPath.lineTo(pt);
+                }
+            }
+            fPath.close();
+        }
+
+        if (fThreads > 0) {
+            fExecutor = SkExecutor::MakeFIFOThreadPool(fThreads);
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        SkGraphics::SetPathFillExecutor(fExecutor.get());
+
+        SkPaint paint;
+        paint.setAntiAlias(true);
+        SkCanvas canvas(fBitmap);
+        for (int i = 0; i < loops; i++) {
+            canvas.drawPath(fPath, paint);
+        }
+
+        SkGraphics::SetPathFillExecutor(nullptr);
+    }
+
+private:
+    static constexpr int kSize = 2048;
+
+    Kind                        fKind;
+    int                         fThreads;
+    SkString                    fName;
+    SkPath                      fPath;
+    SkBitmap                    fBitmap;
+    std::unique_ptr<SkExecutor> fExecutor;
+};
+
+DEF_BENCH( return new GiantPathBench(GiantPathBench::kParcels,   0); )
+DEF_BENCH( return new GiantPathBench(GiantPathBench::kParcels,   4); )
+DEF_BENCH( return new GiantPathBench(GiantPathBench::kCoastline, 0); )
+DEF_BENCH( return new GiantPathBench(GiantPathBench::kCoastline, 4); )
@@ -6,8 +6,11 @@
  */
 #include "bench/Benchmark.h"
 #include "include/core/SkCanvas.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkGraphics.h"
 #include "include/core/SkMaskFilter.h"
 #include "include/core/SkPaint.h"
+#include "include/core/SkPath.h"
 #include "include/core/SkShader.h"
 #include "include/core/SkString.h"
 #include "src/base/SkRandom.h"
@@ -75,6 +78,55 @@ private:
     using INHERITED = Benchmark;
 };
 
+// Blurs a large, non-rrect path so the whole mask goes through SkMaskBlurFilter, with a thread
+// pool as the blur executor. threads == 0 blurs on the drawing thread.
+class BlurPathThreadsBench : public Benchmark {
+    SkScalar                    fRadius;
+    int                         fThreads;
+    SkString                    fName;
+    SkPath                      fPath;
+    std::unique_ptr<SkExecutor> fExecutor;
+
+public:
+    BlurPathThreadsBench(SkScalar rad, int threads) : fRadius(rad), fThreads(threads) {
+        fName.printf("blur_path_%d_threads_%d", SkScalarRoundToInt(rad), threads);
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    bool isSuitableFor(Backend backend) override { return backend == kRaster_Backend; }
+
+    void onDelayedSetup() override {
+        // A wobbly star, about 900px across.
+        SkRandom rand;
+        fPath.moveTo(500, 50);
+        for (int i = 1; i < 24; i++) {
+            SkScalar r = (i & 1) ? rand.nextRangeScalar(150, 250) : rand.nextRangeScalar(400, 450);
+            SkScalar a = i * SK_ScalarPI / 12;
+            fPath.lineTo(500 + r * SkScalarSin(a), 500 - r * SkScalarCos(a));
+        }
+        fPath.close();
+        if (fThreads > 0) {
+            fExecutor = SkExecutor::MakeFIFOThreadPool(fThreads);
+        }
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        SkGraphics::SetBlurExecutor(fExecutor.get());
+
+        SkPaint paint;
+        paint.setAntiAlias(true);
+        paint.setMaskFilter(SkMaskFilter::MakeBlur(kNormal_SkBlurStyle,
+                                                   SkBlurMask::ConvertRadiusToSigma(fRadius)));
+        for (int i = 0; i < loops; i++) {
+            canvas->drawPath(fPath, paint);
+        }
+
+        SkGraphics::SetBlurExecutor(nullptr);
+    }
+};
+
 DEF_BENCH(return new BlurBench(MINI, kNormal_SkBlurStyle);)
 DEF_BENCH(return new BlurBench(MINI, kSolid_SkBlurStyle);)
 DEF_BENCH(return new BlurBench(MINI, kOuter_SkBlurStyle);)
@@ -101,3 +153,10 @@ DEF_BENCH(return new BlurBench(REAL, kOuter_SkBlurStyle);)
 DEF_BENCH(return new BlurBench(REAL, kInner_SkBlurStyle);)
 
 DEF_BENCH(return new BlurBench(0, kNormal_SkBlurStyle);)
+
+DEF_BENCH(return new BlurPathThreadsBench(BIG, 0);)
+DEF_BENCH(return new BlurPathThreadsBench(BIG, 4);)
+DEF_BENCH(return new BlurPathThreadsBench(BIG, 8);)
+DEF_BENCH(return new BlurPathThreadsBench(REALBIG, 0);)
+DEF_BENCH(return new BlurPathThreadsBench(REALBIG, 4);)
+DEF_BENCH(return new BlurPathThreadsBench(REALBIG, 8);)
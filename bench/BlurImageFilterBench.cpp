@@ -8,6 +8,8 @@
 #include "bench/Benchmark.h"
 #include "include/core/SkBitmap.h"
 #include "include/core/SkCanvas.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkGraphics.h"
 #include "include/core/SkPaint.h"
 #include "include/core/SkShader.h"
 #include "include/core/SkString.h"
@@ -123,6 +125,46 @@ private:
     using INHERITED = Benchmark;
 };
 
+// Blurs a large raster image with a thread pool as the blur executor, which the CPU blur uses
+// to split its passes into bands. threads == 0 blurs on the drawing thread.
+class BlurImageFilterThreadsBench : public Benchmark {
+public:
+    BlurImageFilterThreadsBench(SkScalar sigma, int threads) : fSigma(sigma), fThreads(threads) {
+        fName.printf("blur_image_filter_huge_%.2f_threads_%d", SkScalarToFloat(sigma), threads);
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    bool isSuitableFor(Backend backend) override { return backend == kRaster_Backend; }
+
+    void onDelayedSetup() override {
+        fCheckerboard = make_checkerboard(1024, 1024);
+        if (fThreads > 0) {
+            fExecutor = SkExecutor::MakeFIFOThreadPool(fThreads);
+        }
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        SkGraphics::SetBlurExecutor(fExecutor.get());
+
+        SkPaint paint;
+        paint.setImageFilter(SkImageFilters::Blur(fSigma, fSigma, nullptr));
+        for (int i = 0; i < loops; i++) {
+            canvas->drawImage(fCheckerboard, 0, 0, SkSamplingOptions(), &paint);
+        }
+
+        SkGraphics::SetBlurExecutor(nullptr);
+    }
+
+private:
+    SkString                    fName;
+    SkScalar                    fSigma;
+    int                         fThreads;
+    sk_sp<SkImage>              fCheckerboard;
+    std::unique_ptr<SkExecutor> fExecutor;
+};
+
 DEF_BENCH(return new BlurImageFilterBench(BLUR_SIGMA_LARGE, 0, false, false, false);)
 DEF_BENCH(return new BlurImageFilterBench(BLUR_SIGMA_SMALL, 0, false, false, false);)
 DEF_BENCH(return new BlurImageFilterBench(0, BLUR_SIGMA_LARGE, false, false, false);)
@@ -161,3 +203,10 @@ DEF_BENCH(return new BlurImageFilterBench(BLUR_SIGMA_LARGE, BLUR_SIGMA_LARGE, tr
 DEF_BENCH(return new BlurImageFilterBench(BLUR_SIGMA_LARGE, BLUR_SIGMA_LARGE, false, true, true);)
 DEF_BENCH(return new BlurImageFilterBench(BLUR_SIGMA_HUGE, BLUR_SIGMA_HUGE, true, true, true);)
 DEF_BENCH(return new BlurImageFilterBench(BLUR_SIGMA_HUGE, BLUR_SIGMA_HUGE, false, true, true);)
+
+DEF_BENCH(return new BlurImageFilterThreadsBench(BLUR_SIGMA_LARGE, 0);)
+DEF_BENCH(return new BlurImageFilterThreadsBench(BLUR_SIGMA_LARGE, 4);)
+DEF_BENCH(return new BlurImageFilterThreadsBench(BLUR_SIGMA_LARGE, 8);)
+DEF_BENCH(return new BlurImageFilterThreadsBench(BLUR_SIGMA_HUGE, 0);)
+DEF_BENCH(return new BlurImageFilterThreadsBench(BLUR_SIGMA_HUGE, 4);)
+DEF_BENCH(return new BlurImageFilterThreadsBench(BLUR_SIGMA_HUGE, 8);)
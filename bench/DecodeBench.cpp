@@ -6,11 +6,22 @@
  */
 
 #include "bench/Benchmark.h"
+#include "include/codec/SkAndroidCodec.h"
+#include "include/codec/SkCodec.h"
 #include "include/core/SkBitmap.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkPictureRecorder.h"
+#include "include/core/SkStream.h"
+#include "include/core/SkTime.h"
+#include "include/utils/SkAnimCodecPlayer.h"
 #include "modules/skottie/include/Skottie.h"
 #include "tools/Resources.h"
 
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <vector>
+
 class DecodeBench : public Benchmark {
 protected:
     DecodeBench(const char* name, const char* source)
@@ -54,6 +65,153 @@ private:
     using INHERITED = DecodeBench;
 };
 
+// Decodes through SkCodec directly, optionally letting it split the image into bands that are
+// decoded on a thread pool (threads == 0 decodes serially).
+class CodecDecodeBench final : public DecodeBench {
+public:
+    CodecDecodeBench(const char* name, const char* source, int threads)
+        : INHERITED(SkStringPrintf("%s_threads_%d", name, threads).c_str(), source)
+        , fThreads(threads)
+    {}
+
+    void onDelayedSetup() override {
+        INHERITED::onDelayedSetup();
+        fCodec = SkCodec::MakeFromData(fData);
+        SkASSERT(fCodec);
+        fBitmap.allocPixels(fCodec->getInfo().makeColorType(kN32_SkColorType));
+        if (fThreads > 0) {
+            fExecutor = SkExecutor::MakeFIFOThreadPool(fThreads);
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        SkCodec::Options options;
+        options.fExecutor = fExecutor.get();
+        while (loops-- > 0) {
+            SkAssertResult(SkCodec::kSuccess == fCodec->getPixels(fBitmap.pixmap(), &options));
+        }
+    }
+
+private:
+    const int                   fThreads;
+    std::unique_ptr<SkCodec>    fCodec;
+    std::unique_ptr<SkExecutor> fExecutor;
+    SkBitmap                    fBitmap;
+
+    using INHERITED = DecodeBench;
+};
+
+// Decodes a grid of tiles through SkAndroidCodec, the way a map or gallery viewer would. Hiding
+// the stream's memory base keeps SkJpegCodec from indexing its restart markers, so every tile
+// decodes all the rows above it.
+class RegionDecodeBench final : public DecodeBench {
+public:
+    RegionDecodeBench(const char* name, const char* source, bool indexed)
+        : INHERITED(SkStringPrintf("%s_%s", name, indexed ? "indexed" : "unindexed").c_str(),
+                    source)
+        , fIndexed(indexed)
+    {}
+
+    void onDelayedSetup() override {
+        INHERITED::onDelayedSetup();
+        std::unique_ptr<SkStream> stream = fIndexed ? std::make_unique<SkMemoryStream>(fData)
+                                                    : std::make_unique<NoBaseStream>(fData);
+        fCodec = SkAndroidCodec::MakeFromStream(std::move(stream));
+        SkASSERT(fCodec);
+        fBitmap.allocPixels(fCodec->getInfo().makeColorType(kN32_SkColorType)
+                                             .makeWH(kTileSize, kTileSize));
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        const SkISize size = fCodec->getInfo().dimensions();
+        while (loops-- > 0) {
+            for (int y = 0; y + kTileSize <= size.height(); y += size.height() / 4) {
+                for (int x = 0; x + kTileSize <= size.width(); x += size.width() / 4) {
+                    SkIRect subset = SkIRect::MakeXYWH(x, y, kTileSize, kTileSize);
+                    SkAndroidCodec::AndroidOptions options;
+                    options.fSubset = &subset;
+                    SkAssertResult(SkCodec::kSuccess == fCodec->getAndroidPixels(
+                            fBitmap.info(), fBitmap.getPixels(), fBitmap.rowBytes(), &options));
+                }
+            }
+        }
+    }
+
+private:
+    class NoBaseStream final : public SkMemoryStream {
+    public:
+        explicit NoBaseStream(sk_sp<SkData> data) : SkMemoryStream(std::move(data)) {}
+        const void* getMemoryBase() override { return nullptr; }
+    };
+
+    static constexpr int kTileSize = 256;
+
+    const bool                      fIndexed;
+    std::unique_ptr<SkAndroidCodec> fCodec;
+    SkBitmap                        fBitmap;
+
+    using INHERITED = DecodeBench;
+};
+
+
+// Plays an animation through SkAnimCodecPlayer at one frame per 120Hz vsync, the way a sticker
+// is shown, with a fresh player every loop. Each vsync the player is seeked to the next frame and
+// asked for it, and then the bench sleeps until the following vsync; a frame that is not ready in
+// time pushes the rest of the schedule back. Anything above frames * kVsyncNs per loop is time
+// playback spent stalled on decode. framesAhead < 0 decodes on demand.
+class AnimPlayerJitterBench final : public DecodeBench {
+public:
+    AnimPlayerJitterBench(const char* name, const char* source, int framesAhead)
+        : INHERITED(framesAhead < 0
+                            ? SkStringPrintf("%s_sync", name).c_str()
+                            : SkStringPrintf("%s_ahead_%d", name, framesAhead).c_str(),
+                    source)
+        , fFramesAhead(framesAhead)
+    {}
+
+    void onDelayedSetup() override {
+        INHERITED::onDelayedSetup();
+        std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(fData);
+        SkASSERT(codec);
+        int start = 0;
+        for (const SkCodec::FrameInfo& info : codec->getFrameInfo()) {
+            fFrameStarts.push_back(start);
+            start += info.fDuration;
+        }
+        if (fFramesAhead >= 0) {
+            fExecutor = SkExecutor::MakeFIFOThreadPool(1);
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        static constexpr double kVsyncNs = 1e9 / 120;
+
+        while (loops-- > 0) {
+            auto player = fExecutor
+                    ? std::make_unique<SkAnimCodecPlayer>(SkCodec::MakeFromData(fData),
+                                                          fExecutor.get(), fFramesAhead)
+                    : std::make_unique<SkAnimCodecPlayer>(SkCodec::MakeFromData(fData));
+            double vsync = SkTime::GetNSecs();
+            for (int start : fFrameStarts) {
+                player->seek(start);
+                SkAssertResult(player->getFrame());
+
+                vsync = std::max(vsync, SkTime::GetNSecs()) + kVsyncNs;
+                double remaining = vsync - SkTime::GetNSecs();
+                if (remaining > 0) {
+                    std::this_thread::sleep_for(std::chrono::nanoseconds((int64_t)remaining));
+                }
+            }
+        }
+    }
+
+private:
+    const int                   fFramesAhead;
+    std::vector<int>            fFrameStarts;
+    std::unique_ptr<SkExecutor> fExecutor;
+
+    using INHERITED = DecodeBench;
+};
 
 class SkottieDecodeBench final : public DecodeBench {
 public:
@@ -233,3 +391,18 @@ DEF_BENCH(return new BitmapDecodeBench("png_small"    /*  32x  32*/, "images/man
 DEF_BENCH(return new BitmapDecodeBench("png_phonehub_connecting"   , "images/Connecting.png"));
 DEF_BENCH(return new BitmapDecodeBench("png_phonehub_generic_error", "images/Generic_Error.png"));
 DEF_BENCH(return new BitmapDecodeBench("png_phonehub_onboard"      , "images/Onboard.png"));
+
+// 3024x4032, with a restart marker at the start of every MCU row.
+DEF_BENCH(return new CodecDecodeBench("jpeg_restart", "images/iphone_13_pro.jpeg", 0));
+DEF_BENCH(return new CodecDecodeBench("jpeg_restart", "images/iphone_13_pro.jpeg", 2));
+DEF_BENCH(return new CodecDecodeBench("jpeg_restart", "images/iphone_13_pro.jpeg", 4));
+DEF_BENCH(return new CodecDecodeBench("jpeg_restart", "images/iphone_13_pro.jpeg", 8));
+
+DEF_BENCH(return new RegionDecodeBench("jpeg_restart_tiles", "images/iphone_13_pro.jpeg", true));
+DEF_BENCH(return new RegionDecodeBench("jpeg_restart_tiles", "images/iphone_13_pro.jpeg", false));
+
+DEF_BENCH(return new AnimPlayerJitterBench("anim_player_flightAnim", "images/flightAnim.gif", -1));
+DEF_BENCH(return new AnimPlayerJitterBench("anim_player_flightAnim", "images/flightAnim.gif", 1));
+DEF_BENCH(return new AnimPlayerJitterBench("anim_player_flightAnim", "images/flightAnim.gif", 4));
+DEF_BENCH(return new AnimPlayerJitterBench("anim_player_stoplight", "images/stoplight.webp", -1));
+DEF_BENCH(return new AnimPlayerJitterBench("anim_player_stoplight", "images/stoplight.webp", 2));
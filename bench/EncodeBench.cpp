@@ -7,6 +7,11 @@
 
 #include "bench/Benchmark.h"
 #include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkRect.h"
 #include "include/core/SkStream.h"
 #include "include/encode/SkJpegEncoder.h"
 #include "include/encode/SkPngEncoder.h"
@@ -123,3 +128,145 @@ DEF_BENCH(return new EncodeBench(srcs[1], PNG(kNone, 3), "PNG_3n"));
 DEF_BENCH(return new EncodeBench(srcs[1], PNG(kNone, 1), "PNG_1n"));
 
 #undef PNG
+
+// Encodes a large upscaled photo with SkPngEncoder::Options::fExecutor set to pools of increasing
+// size, to show how band-parallel PNG encoding scales with core count.  0 threads is serial.
+class ParallelPngEncodeBench : public Benchmark {
+public:
+    ParallelPngEncodeBench(const char* filename, int threads, int zlibLevel)
+        : fSourceFilename(filename)
+        , fThreads(threads)
+        , fZLibLevel(zlibLevel)
+        , fName(SkStringPrintf("Encode_%s_PNG_%d_%dthreads", filename, zlibLevel, threads)) {}
+
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        sk_sp<SkImage> image = GetResourceAsImage(fSourceFilename);
+        SkAssertResult(image);
+        fBitmap.allocN32Pixels(4096, 4096);
+        SkCanvas canvas(fBitmap);
+        canvas.drawImageRect(image, SkRect::MakeWH(4096, 4096),
+                             SkSamplingOptions(SkFilterMode::kLinear));
+        if (fThreads > 0) {
+            fExecutor = SkExecutor::MakeFIFOThreadPool(fThreads);
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        SkPngEncoder::Options opts;
+        opts.fZLibLevel = fZLibLevel;
+        opts.fExecutor = fExecutor.get();
+        while (loops-- > 0) {
+            SkNullWStream dst;
+            SkAssertResult(SkPngEncoder::Encode(&dst, fBitmap.pixmap(), opts));
+            SkASSERT(dst.bytesWritten() > 0);
+        }
+    }
+
+private:
+    const char*                 fSourceFilename;
+    const int                   fThreads;
+    const int                   fZLibLevel;
+    SkString                    fName;
+    SkBitmap                    fBitmap;
+    std::unique_ptr<SkExecutor> fExecutor;
+};
+
+DEF_BENCH(return new ParallelPngEncodeBench(srcs[1], 0, 6));
+DEF_BENCH(return new ParallelPngEncodeBench(srcs[1], 2, 6));
+DEF_BENCH(return new ParallelPngEncodeBench(srcs[1], 4, 6));
+DEF_BENCH(return new ParallelPngEncodeBench(srcs[1], 8, 6));
+DEF_BENCH(return new ParallelPngEncodeBench(srcs[1], 16, 6));
+DEF_BENCH(return new ParallelPngEncodeBench(srcs[1], 0, 1));
+DEF_BENCH(return new ParallelPngEncodeBench(srcs[1], 8, 1));
+
+// Encodes a large photo and a large synthetic screenshot with the WebP configurations an upload
+// pipeline might choose between, with and without SkWebpEncoder::Options::fMultithreaded.
+class WebpEncodeBench : public Benchmark {
+public:
+    enum class Mode { kLossy, kLossless, kFastLossless };
+
+    WebpEncodeBench(bool screenshot, Mode mode, float quality, bool multithreaded)
+        : fScreenshot(screenshot)
+        , fMode(mode)
+        , fQuality(quality)
+        , fMultithreaded(multithreaded)
+        , fName(SkStringPrintf("Encode_WEBP_%s_%s_%d%s",
+                               screenshot ? "screenshot" : "photo",
+                               mode == Mode::kLossy        ? "lossy"
+                               : mode == Mode::kLossless   ? "lossless"
+                                                           : "fastlossless",
+                               (int)quality, multithreaded ? "_multithreaded" : "")) {}
+
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        fBitmap.allocN32Pixels(2048, 2048);
+        SkCanvas canvas(fBitmap);
+        if (fScreenshot) {
+            // Flat backgrounds, bars and repeated icons, like a phone UI capture.
+            sk_sp<SkImage> icon = GetResourceAsImage("images/Onboard.png");
+            SkAssertResult(icon);
+            canvas.clear(0xFFF1F3F4);
+            SkPaint paint;
+            paint.setColor(0xFF1A73E8);
+            canvas.drawRect(SkRect::MakeWH(2048, 160), paint);
+            paint.setColor(SK_ColorWHITE);
+            for (int y = 240; y < 2048; y += 300) {
+                canvas.drawRect(SkRect::MakeXYWH(48, y, 1952, 260), paint);
+                for (int x = 64; x + icon->width() < 2000; x += 400) {
+                    canvas.drawImage(icon, x, y + 20);
+                }
+            }
+        } else {
+            sk_sp<SkImage> image = GetResourceAsImage("images/mandrill_1600.png");
+            SkAssertResult(image);
+            canvas.drawImageRect(image, SkRect::MakeWH(2048, 2048),
+                                 SkSamplingOptions(SkFilterMode::kLinear));
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        SkWebpEncoder::Options opts;
+        opts.fCompression = fMode == Mode::kLossy ? SkWebpEncoder::Compression::kLossy
+                                                  : SkWebpEncoder::Compression::kLossless;
+        opts.fFastLossless = fMode == Mode::kFastLossless;
+        opts.fQuality = fQuality;
+        opts.fMultithreaded = fMultithreaded;
+        while (loops-- > 0) {
+            SkNullWStream dst;
+            SkAssertResult(SkWebpEncoder::Encode(&dst, fBitmap.pixmap(), opts));
+            SkASSERT(dst.bytesWritten() > 0);
+        }
+    }
+
+private:
+    const bool  fScreenshot;
+    const Mode  fMode;
+    const float fQuality;
+    const bool  fMultithreaded;
+    SkString    fName;
+    SkBitmap    fBitmap;
+};
+
+#define WEBP_BENCHES(SCREENSHOT, MODE, QUALITY)                                                    \
+    DEF_BENCH(return new WebpEncodeBench(SCREENSHOT, WebpEncodeBench::Mode::MODE,                  \
+                                         QUALITY, false));                                         \
+    DEF_BENCH(return new WebpEncodeBench(SCREENSHOT, WebpEncodeBench::Mode::MODE,                  \
+                                         QUALITY, true));
+
+WEBP_BENCHES(false, kLossy, 75)
+WEBP_BENCHES(false, kLossy, 90)
+WEBP_BENCHES(false, kLossless, 90)
+WEBP_BENCHES(false, kFastLossless, 0)
+WEBP_BENCHES(true, kLossy, 75)
+WEBP_BENCHES(true, kLossy, 90)
+WEBP_BENCHES(true, kLossless, 90)
+WEBP_BENCHES(true, kFastLossless, 0)
+
+#undef WEBP_BENCHES
@@ -6,7 +6,11 @@
  */
 
 #include "bench/Benchmark.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkString.h"
+#include "src/base/SkRandom.h"
 #include "src/core/SkResourceCache.h"
+#include "src/core/SkTaskGroup.h"
 
 namespace {
 static void* gGlobalAddress;
@@ -75,3 +79,59 @@ private:
 ///////////////////////////////////////////////////////////////////////////////
 
 DEF_BENCH( return new ImageCacheBench(); )
+
+// Many threads hammering one cache with a mix of hits, misses and adds, like decode and raster
+// workers sharing the global bitmap, mask and mipmap caches.  Compares one lock against shards.
+class ImageCacheThreadedBench : public Benchmark {
+    enum {
+        CACHE_COUNT  = 2000,
+        LOOKUPS      = 1000,
+    };
+public:
+    ImageCacheThreadedBench(int threads, int shards)
+            : fThreads(threads)
+            , fCache(shards, CACHE_COUNT * 100) {
+        fName.printf("imagecache_threads_%d_shards_%d", threads, shards);
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        fExecutor = SkExecutor::MakeFIFOThreadPool(fThreads);
+        for (int i = 0; i < CACHE_COUNT; ++i) {
+            fCache.add(new TestRec(TestKey(i), i));
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; ++i) {
+            SkTaskGroup(*fExecutor).batch(fThreads, [&](int thread) {
+                SkRandom rand(thread);
+                for (int j = 0; j < LOOKUPS; ++j) {
+                    // Mostly hits, with about one miss-then-add in eight.
+                    intptr_t value = rand.nextULessThan(CACHE_COUNT + CACHE_COUNT / 8);
+                    TestKey key(value);
+                    if (!fCache.find(key, TestRec::Visitor, nullptr)) {
+                        fCache.add(new TestRec(key, value));
+                    }
+                }
+            });
+        }
+    }
+
+private:
+    int                         fThreads;
+    SkShardedResourceCache      fCache;
+    std::unique_ptr<SkExecutor> fExecutor;
+    SkString                    fName;
+};
+
+DEF_BENCH( return new ImageCacheThreadedBench(1, 1); )
+DEF_BENCH( return new ImageCacheThreadedBench(8, 1); )
+DEF_BENCH( return new ImageCacheThreadedBench(8, 8); )
+DEF_BENCH( return new ImageCacheThreadedBench(8, 32); )
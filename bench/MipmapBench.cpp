@@ -8,6 +8,7 @@
 #include "bench/Benchmark.h"
 #include "include/core/SkBitmap.h"
 #include "include/core/SkColorSpace.h"
+#include "include/core/SkExecutor.h"
 #include "src/core/SkMipmap.h"
 
 class MipmapBench: public Benchmark {
@@ -15,15 +16,21 @@ class MipmapBench: public Benchmark {
     SkString fName;
     const int fW, fH;
     bool fHalfFoat;
+    const int fThreads;
+    std::unique_ptr<SkExecutor> fExecutor;
 
 public:
-    MipmapBench(int w, int h, bool halfFloat = false)
-        : fW(w), fH(h), fHalfFoat(halfFloat)
+    // threads > 0 builds with an SkExecutor of that many threads.
+    MipmapBench(int w, int h, bool halfFloat = false, int threads = 0)
+        : fW(w), fH(h), fHalfFoat(halfFloat), fThreads(threads)
     {
         fName.printf("mipmap_build_%dx%d", w, h);
         if (halfFloat) {
             fName.append("_f16");
         }
+        if (threads > 0) {
+            fName.appendf("_%dthreads", threads);
+        }
     }
 
 protected:
@@ -39,11 +46,14 @@ protected:
                                              SkColorSpace::MakeSRGB());
         fBitmap.allocPixels(info);
         fBitmap.eraseColor(SK_ColorWHITE);  // so we don't read uninitialized memory
+        if (fThreads > 0) {
+            fExecutor = SkExecutor::MakeFIFOThreadPool(fThreads);
+        }
     }
 
     void onDraw(int loops, SkCanvas*) override {
         for (int i = 0; i < loops * 4; i++) {
-            SkMipmap::Build(fBitmap, nullptr)->unref();
+            SkMipmap::Build(fBitmap, nullptr, fExecutor.get())->unref();
         }
     }
 
@@ -66,3 +76,13 @@ DEF_BENCH( return new MipmapBench(2048, 2048); )
 DEF_BENCH( return new MipmapBench(2047, 2047); )
 DEF_BENCH( return new MipmapBench(2048, 2047); )
 DEF_BENCH( return new MipmapBench(2047, 2048); )
+
+// Parallel builds of large photos, where the first levels are split into bands of rows.
+DEF_BENCH( return new MipmapBench(4096, 4096, false, 2); )
+DEF_BENCH( return new MipmapBench(4096, 4096, false, 4); )
+DEF_BENCH( return new MipmapBench(4096, 4096, false, 8); )
+DEF_BENCH( return new MipmapBench(4096, 4096); )
+DEF_BENCH( return new MipmapBench(4095, 4095, false, 4); )
+DEF_BENCH( return new MipmapBench(4095, 4095); )
+DEF_BENCH( return new MipmapBench(4096, 4096, true, 4); )
+DEF_BENCH( return new MipmapBench(4096, 4096, true); )
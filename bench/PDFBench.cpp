@@ -8,11 +8,16 @@
 #include "bench/Benchmark.h"
 
 #include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
 #include "include/core/SkData.h"
 #include "include/core/SkExecutor.h"
+#include "include/core/SkFont.h"
 #include "include/core/SkImage.h"
+#include "include/core/SkPath.h"
 #include "include/core/SkPixmap.h"
 #include "include/core/SkStream.h"
+#include "include/core/SkTypeface.h"
+#include "include/docs/SkPDFDocument.h"
 #include "include/effects/SkGradientShader.h"
 #include "include/private/base/SkTo.h"
 #include "src/base/SkRandom.h"
@@ -303,6 +308,81 @@ struct PDFClipPathBenchmark : public Benchmark {
     }
 };
 
+// A multi-page document with a large image, a block of TrueType text, and a few hundred
+// paths per page; compares end-to-end serialization with and without a thread pool.
+class PDFMultiPageBench : public Benchmark {
+public:
+    explicit PDFMultiPageBench(int threads) : fThreads(threads) {
+        fName.printf("PDFMultiPage_threads_%d", threads);
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+    void onDelayedSetup() override {
+        fTypeface = MakeResourceAsTypeface("fonts/Roboto-Regular.ttf");
+        SkRandom random;
+        for (int page = 0; page < kPageCount; ++page) {
+            SkBitmap bitmap;
+            bitmap.allocN32Pixels(1024, 768, /*isOpaque=*/true);
+            for (int y = 0; y < bitmap.height(); ++y) {
+                uint32_t* row = bitmap.getAddr32(0, y);
+                for (int x = 0; x < bitmap.width(); ++x) {
+                    uint8_t noise = random.nextU() & 0x1F;
+                    row[x] = SkPackARGB32(0xFF, (x >> 2) ^ noise, (y >> 2) ^ noise, page * 16);
+                }
+            }
+            bitmap.setImmutable();
+            fImages[page] = bitmap.asImage();
+        }
+        if (fThreads > 0) {
+            fExecutor = SkExecutor::MakeFIFOThreadPool(fThreads);
+        }
+    }
+    void onDraw(int loops, SkCanvas*) override {
+        SkFont font(fTypeface, 10);
+        SkPaint stroke;
+        stroke.setStyle(SkPaint::kStroke_Style);
+        stroke.setAntiAlias(true);
+        while (loops-- > 0) {
+            SkNullWStream wStream;
+            SkPDF::Metadata metadata;
+            metadata.fExecutor = fExecutor.get();
+            auto doc = SkPDF::MakeDocument(&wStream, metadata);
+            SkRandom random;
+            for (int page = 0; page < kPageCount; ++page) {
+                SkCanvas* canvas = doc->beginPage(612, 792);
+                canvas->drawImageRect(fImages[page], SkRect{36, 36, 576, 441},
+                                      SkSamplingOptions());
+                for (int line = 0; line < 24; ++line) {
+                    canvas->drawString("The quick brown fox jumps over the lazy dog 0123456789",
+                                       36, 460 + 12.0f * line, font, SkPaint());
+                }
+                for (int i = 0; i < 300; ++i) {
+                    SkPath path;
+                    path.moveTo(random.nextRangeF(0, 612), random.nextRangeF(0, 792));
+                    path.quadTo(random.nextRangeF(0, 612), random.nextRangeF(0, 792),
+                                random.nextRangeF(0, 612), random.nextRangeF(0, 792));
+                    stroke.setColor(random.nextU() | 0xFF000000);
+                    canvas->drawPath(path, stroke);
+                }
+                doc->endPage();
+            }
+            doc->close();
+        }
+    }
+
+private:
+    static constexpr int kPageCount = 8;
+    int fThreads;
+    SkString fName;
+    sk_sp<SkTypeface> fTypeface;
+    sk_sp<SkImage> fImages[kPageCount];
+    std::unique_ptr<SkExecutor> fExecutor;
+};
+
 }  // namespace
 DEF_BENCH(return new PDFImageBench;)
 DEF_BENCH(return new PDFJpegImageBench;)
@@ -311,6 +391,10 @@ DEF_BENCH(return new PDFColorComponentBench;)
 DEF_BENCH(return new PDFShaderBench;)
 DEF_BENCH(return new WritePDFTextBenchmark;)
 DEF_BENCH(return new PDFClipPathBenchmark;)
+DEF_BENCH(return new PDFMultiPageBench(0);)
+DEF_BENCH(return new PDFMultiPageBench(2);)
+DEF_BENCH(return new PDFMultiPageBench(4);)
+DEF_BENCH(return new PDFMultiPageBench(8);)
 
 #ifdef SK_PDF_ENABLE_SLOW_TESTS
 #include "include/core/SkExecutor.h"
@@ -21,8 +21,15 @@
 #include "src/core/SkDraw.h"
 #include "src/core/SkMatrixPriv.h"
 
+#include <atomic>
+
 using namespace skia_private;
 
+extern bool gSkForceRasterPipelineBlitter;
+extern bool gDisableRasterPipelineCoverageBatching;
+extern std::atomic<bool> gSkUseAnalyticAA;
+extern std::atomic<bool> gSkForceAnalyticAA;
+
 enum Flags {
     kStroke_Flag = 1 << 0,
     kBig_Flag    = 1 << 1
@@ -710,6 +717,70 @@ private:
     using INHERITED = Benchmark;
 };
 
+// Fills lines of small glyph-like contours through SkRasterPipelineBlitter, with and without
+// gathering the many short coverage runs on each scanline into a single blit.
+class TextLikePathBench : public Benchmark {
+public:
+    TextLikePathBench(bool analyticAA, bool batched)
+            : fAnalyticAA(analyticAA)
+            , fBatched(batched) {
+        fName.printf("path_fill_textlike_%s_%s",
+                     analyticAA ? "aaa" : "supersampled",
+                     batched ? "batched" : "unbatched");
+    }
+
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        fBitmap.allocN32Pixels(kWidth, kHeight);
+
+        // Each "glyph" is an o and an l about 10 pixels tall, at a fractional offset.
+        SkRandom rand;
+        for (float y = 2; y + 12 < kHeight; y += 14) {
+            for (float x = 2; x + 12 < kWidth; x += 11) {
+                const float dx = rand.nextUScalar1(),
+                            dy = rand.nextUScalar1();
+                fPath.addCircle(x + dx + 4, y + dy + 6, 3.5f);
+                fPath.addCircle(x + dx + 4, y + dy + 6, 2.2f, SkPathDirection::kCCW);
+                fPath.addRect(SkRect::MakeXYWH(x + dx + 8.3f, y + dy, 1.4f, 10));
+            }
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        SkPaint paint;
+        paint.setAntiAlias(true);
+        paint.setColor(0xff202020);
+
+        SkCanvas canvas(fBitmap);
+        const bool useAnalyticAA   = gSkUseAnalyticAA,
+                   forceAnalyticAA = gSkForceAnalyticAA;
+        gSkUseAnalyticAA   = fAnalyticAA;
+        gSkForceAnalyticAA = fAnalyticAA;
+        gSkForceRasterPipelineBlitter          = true;
+        gDisableRasterPipelineCoverageBatching = !fBatched;
+        for (int i = 0; i < loops; i++) {
+            canvas.drawPath(fPath, paint);
+        }
+        gSkForceRasterPipelineBlitter          = false;
+        gDisableRasterPipelineCoverageBatching = false;
+        gSkUseAnalyticAA   = useAnalyticAA;
+        gSkForceAnalyticAA = forceAnalyticAA;
+    }
+
+private:
+    static constexpr int kWidth  = 640,
+                         kHeight = 120;
+
+    bool     fAnalyticAA;
+    bool     fBatched;
+    SkString fName;
+    SkPath   fPath;
+    SkBitmap fBitmap;
+};
 
 // Chrome creates its own round rects with each corner possibly being different.
 // In its "zero radius" incarnation it creates degenerate round rects.
@@ -1212,6 +1283,10 @@ DEF_BENCH( return new SkBench_AddPathTest(SkBench_AddPathTest::kReversePathTo_Ad
 
 DEF_BENCH( return new CirclesBench(FLAGS00); )
 DEF_BENCH( return new CirclesBench(FLAGS01); )
+DEF_BENCH( return new TextLikePathBench(false, false); )
+DEF_BENCH( return new TextLikePathBench(false,  true); )
+DEF_BENCH( return new TextLikePathBench( true, false); )
+DEF_BENCH( return new TextLikePathBench( true,  true); )
 DEF_BENCH( return new ArbRoundRectBench(false); )
 DEF_BENCH( return new ArbRoundRectBench(true); )
 DEF_BENCH( return new ConservativelyContainsBench(ConservativelyContainsBench::kRect_Type); )
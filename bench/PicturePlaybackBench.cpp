@@ -16,6 +16,8 @@
 #include "include/core/SkRect.h"
 #include "include/core/SkString.h"
 #include "src/base/SkRandom.h"
+#include "src/core/SkBigPicture.h"
+#include "src/core/SkPicturePriv.h"
 
 // This is designed to emulate about 4 screens of textual content
 
@@ -97,3 +99,59 @@ DEF_BENCH( return new TiledPlaybackBench(kNone,     kRandom); )
 DEF_BENCH( return new TiledPlaybackBench(kNone,     kTiled ); )
 DEF_BENCH( return new TiledPlaybackBench(kRTree,    kRandom); )
 DEF_BENCH( return new TiledPlaybackBench(kRTree,    kTiled ); )
+
+// Emulates an app redrawing several full screens of content into one picture, where each screen
+// starts by clearing to an opaque background.  Only the last screen is visible.
+class OcclusionPlaybackBench : public Benchmark {
+public:
+    OcclusionPlaybackBench(bool occlusion) : fOcclusion(occlusion) {
+        fName.printf("occlusion_playback_%s", occlusion ? "culled" : "plain");
+    }
+
+    const char* onGetName() override { return fName.c_str(); }
+    SkIPoint onGetSize() override { return SkIPoint::Make(1024,1024); }
+
+    void onDelayedSetup() override {
+        SkPictureRecorder recorder;
+        SkCanvas* canvas = recorder.beginRecording(1024, 1024);
+            SkRandom rand;
+            for (int screen = 0; screen < 4; screen++) {
+                SkPaint background;
+                background.setColor(rand.nextU() | 0xFF000000);
+                canvas->drawRect(SkRect::MakeWH(1024, 1024), background);
+
+                canvas->save();
+                canvas->translate(rand.nextRangeScalar(-4, 4), rand.nextRangeScalar(-4, 4));
+                for (int i = 0; i < 1000; i++) {
+                    SkPaint paint;
+                    paint.setAntiAlias(true);
+                    paint.setColor(rand.nextU());
+                    canvas->drawOval(SkRect::MakeXYWH(rand.nextRangeScalar(0, 960),
+                                                      rand.nextRangeScalar(0, 960),
+                                                      rand.nextRangeScalar(4, 64),
+                                                      rand.nextRangeScalar(4, 64)), paint);
+                }
+                canvas->restore();
+            }
+        fPic = recorder.finishRecordingAsPicture();
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        const SkBigPicture* big = SkPicturePriv::AsSkBigPicture(fPic);
+        for (int i = 0; i < loops; i++) {
+            if (fOcclusion && big) {
+                big->playbackWithOcclusion(canvas);
+            } else {
+                fPic->playback(canvas);
+            }
+        }
+    }
+
+private:
+    bool                fOcclusion;
+    SkString            fName;
+    sk_sp<SkPicture>    fPic;
+};
+
+DEF_BENCH( return new OcclusionPlaybackBench(false); )
+DEF_BENCH( return new OcclusionPlaybackBench(true ); )
@@ -25,8 +25,12 @@ typedef SkRect (*MakeRectProc)(SkRandom&, int, int);
 // Time how long it takes to build an R-Tree.
 class RTreeBuildBench : public Benchmark {
 public:
-    RTreeBuildBench(const char* name, MakeRectProc proc) : fProc(proc) {
+    RTreeBuildBench(const char* name, MakeRectProc proc, int numRects = NUM_BUILD_RECTS)
+            : fProc(proc), fNumRects(numRects) {
         fName.printf("rtree_%s_build", name);
+        if (numRects != NUM_BUILD_RECTS) {
+            fName.appendf("_%d", numRects);
+        }
     }
 
     bool isSuitableFor(Backend backend) override {
@@ -39,19 +43,20 @@ protected:
     }
     void onDraw(int loops, SkCanvas* canvas) override {
         SkRandom rand;
-        AutoTMalloc<SkRect> rects(NUM_BUILD_RECTS);
-        for (int i = 0; i < NUM_BUILD_RECTS; ++i) {
-            rects[i] = fProc(rand, i, NUM_BUILD_RECTS);
+        AutoTMalloc<SkRect> rects(fNumRects);
+        for (int i = 0; i < fNumRects; ++i) {
+            rects[i] = fProc(rand, i, fNumRects);
         }
 
         for (int i = 0; i < loops; ++i) {
             SkRTree tree;
-            tree.insert(rects.get(), NUM_BUILD_RECTS);
+            tree.insert(rects.get(), fNumRects);
             SkASSERT(rects != nullptr);  // It'd break this bench if the tree took ownership of rects.
         }
     }
 private:
     MakeRectProc fProc;
+    int fNumRects;
     SkString fName;
     using INHERITED = Benchmark;
 };
@@ -59,8 +64,12 @@ private:
 // Time how long it takes to perform queries on an R-Tree.
 class RTreeQueryBench : public Benchmark {
 public:
-    RTreeQueryBench(const char* name, MakeRectProc proc) : fProc(proc) {
+    RTreeQueryBench(const char* name, MakeRectProc proc, int numRects = NUM_QUERY_RECTS)
+            : fProc(proc), fNumRects(numRects) {
         fName.printf("rtree_%s_query", name);
+        if (numRects != NUM_QUERY_RECTS) {
+            fName.appendf("_%d", numRects);
+        }
     }
 
     bool isSuitableFor(Backend backend) override {
@@ -72,17 +81,18 @@ protected:
     }
     void onDelayedSetup() override {
         SkRandom rand;
-        AutoTMalloc<SkRect> rects(NUM_QUERY_RECTS);
-        for (int i = 0; i < NUM_QUERY_RECTS; ++i) {
-            rects[i] = fProc(rand, i, NUM_QUERY_RECTS);
+        AutoTMalloc<SkRect> rects(fNumRects);
+        for (int i = 0; i < fNumRects; ++i) {
+            rects[i] = fProc(rand, i, fNumRects);
         }
-        fTree.insert(rects.get(), NUM_QUERY_RECTS);
+        fTree.insert(rects.get(), fNumRects);
     }
 
     void onDraw(int loops, SkCanvas* canvas) override {
         SkRandom rand;
+        std::vector<int> hits;
         for (int i = 0; i < loops; ++i) {
-            std::vector<int> hits;
+            hits.clear();
             SkRect query;
             query.fLeft   = rand.nextRangeF(0, GENERATE_EXTENTS);
             query.fTop    = rand.nextRangeF(0, GENERATE_EXTENTS);
@@ -94,6 +104,7 @@ protected:
 private:
     SkRTree fTree;
     MakeRectProc fProc;
+    int fNumRects;
     SkString fName;
     using INHERITED = Benchmark;
 };
@@ -139,3 +150,12 @@ DEF_BENCH(return new RTreeQueryBench("XY", &make_XYordered_rects));
 DEF_BENCH(return new RTreeQueryBench("YX", &make_YXordered_rects));
 DEF_BENCH(return new RTreeQueryBench("random", &make_random_rects));
 DEF_BENCH(return new RTreeQueryBench("concentric", &make_concentric_rects));
+
+// Very large pictures, where search dominates partial-redraw cost.
+DEF_BENCH(return new RTreeBuildBench("XY",     &make_XYordered_rects, 100000));
+DEF_BENCH(return new RTreeBuildBench("random", &make_random_rects,    100000));
+DEF_BENCH(return new RTreeBuildBench("random", &make_random_rects,    500000));
+
+DEF_BENCH(return new RTreeQueryBench("XY",     &make_XYordered_rects, 100000));
+DEF_BENCH(return new RTreeQueryBench("random", &make_random_rects,    100000));
+DEF_BENCH(return new RTreeQueryBench("random", &make_random_rects,    500000));
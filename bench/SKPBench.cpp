@@ -8,6 +8,7 @@
 #include "bench/SKPBench.h"
 #include "include/core/SkSurface.h"
 #include "include/gpu/GrDirectContext.h"
+#include "src/core/SkTiledPictureDraw.h"
 #include "src/gpu/ganesh/GrDirectContextPriv.h"
 #include "tools/flags/CommandLineFlags.h"
 
@@ -140,6 +141,54 @@ void SKPBench::drawPicture() {
     }
 }
 
+SKPParallelBench::SKPParallelBench(const char* name, const SkPicture* pic, const SkIRect& clip,
+                                   SkScalar scale, int threads)
+    : fPic(SkRef(pic))
+    , fClip(clip)
+    , fScale(scale)
+    , fThreads(threads) {
+    fName.printf("%s_%dthreads", name, threads);
+    fUniqueName.printf("%s_%.2g", fName.c_str(), scale);
+}
+
+const char* SKPParallelBench::onGetName() {
+    return fName.c_str();
+}
+
+const char* SKPParallelBench::onGetUniqueName() {
+    return fUniqueName.c_str();
+}
+
+bool SKPParallelBench::isSuitableFor(Backend backend) {
+    return backend == kRaster_Backend;
+}
+
+void SKPParallelBench::onDelayedSetup() {
+    if (fThreads > 1) {
+        fExecutor = SkExecutor::MakeFIFOThreadPool(fThreads - 1);
+    }
+}
+
+SkIPoint SKPParallelBench::onGetSize() {
+    return SkIPoint::Make(fClip.width(), fClip.height());
+}
+
+void SKPParallelBench::onDraw(int loops, SkCanvas* canvas) {
+    SkPixmap dst;
+    if (!canvas->peekPixels(&dst)) {
+        return;
+    }
+    SkMatrix matrix = canvas->getLocalToDeviceAs3x3();
+    matrix.preScale(fScale, fScale);
+    const SkSurfaceProps props = canvas->getBaseProps();
+
+    const SkISize tileSize = {FLAGS_CPUbenchTileW, FLAGS_CPUbenchTileH};
+    for (int i = 0; i < loops; i++) {
+        SkTiledPictureDraw(fPic.get(), dst, &matrix, &props, tileSize,
+                           fExecutor.get());
+    }
+}
+
 #include "src/gpu/ganesh/GrGpu.h"
 static void draw_pic_for_stats(SkCanvas* canvas,
                                GrDirectContext* dContext,
@@ -10,6 +10,7 @@
 
 #include "bench/Benchmark.h"
 #include "include/core/SkCanvas.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkPicture.h"
 #include "include/private/base/SkTDArray.h"
 
@@ -62,4 +63,35 @@ private:
     using INHERITED = Benchmark;
 };
 
+/**
+ * Rasterizes an SkPicture with SkTiledPictureDraw(), replaying CPU-sized tiles on fThreads threads.
+ * Running the same SKP with several thread counts shows how tiled raster playback scales.
+ */
+class SKPParallelBench : public Benchmark {
+public:
+    SKPParallelBench(const char* name, const SkPicture*, const SkIRect& devClip, SkScalar scale,
+                     int threads);
+
+protected:
+    const char* onGetName() override;
+    const char* onGetUniqueName() override;
+    bool isSuitableFor(Backend backend) override;
+    void onDelayedSetup() override;
+    void onDraw(int loops, SkCanvas* canvas) override;
+    SkIPoint onGetSize() override;
+
+private:
+    sk_sp<const SkPicture> fPic;
+    const SkIRect fClip;
+    const SkScalar fScale;
+    const int fThreads;
+    SkString fName;
+    SkString fUniqueName;
+
+    // Null when fThreads is 1, otherwise fThreads-1 workers that the calling thread helps out.
+    std::unique_ptr<SkExecutor> fExecutor;
+
+    using INHERITED = Benchmark;
+};
+
 #endif
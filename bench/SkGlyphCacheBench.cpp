@@ -10,7 +10,9 @@
 #include "bench/Benchmark.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColorSpace.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkGraphics.h"
+#include "include/core/SkSurface.h"
 #include "include/core/SkTypeface.h"
 #include "include/private/chromium/SkChromeRemoteGlyphCache.h"
 #include "src/base/SkTLazy.h"
@@ -118,6 +120,58 @@ DEF_BENCH( return new SkGlyphCacheBasic(32 * 1024 * 1024); )
 DEF_BENCH( return new SkGlyphCacheStressTest(256 * 1024); )
 DEF_BENCH( return new SkGlyphCacheStressTest(32 * 1024 * 1024); )
 
+// Many threads drawing the same few fonts, so nearly every strike lookup is a cache hit and the
+// cost is dominated by contention on the global strike cache's lock.
+class SkGlyphCacheContentionBench : public Benchmark {
+public:
+    explicit SkGlyphCacheContentionBench(int threads) : fThreads(threads) {
+        fName.printf("SkGlyphCacheContention_threads_%d", threads);
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+    void onDelayedSetup() override {
+        fExecutor = SkExecutor::MakeFIFOThreadPool(fThreads);
+        fTypefaces[0] = ToolUtils::create_portable_typeface("serif", SkFontStyle::Normal());
+        fTypefaces[1] = ToolUtils::create_portable_typeface("sans-serif", SkFontStyle::Bold());
+        for (int i = 0; i < fThreads; i++) {
+            fSurfaces.push_back(SkSurface::MakeRasterN32Premul(256, 64));
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        static constexpr char kText[] = "The quick brown fox jumps over the lazy dog.";
+        for (int work = 0; work < loops; work++) {
+            SkTaskGroup(*fExecutor).batch(fThreads, [&](int thread) {
+                SkCanvas* canvas = fSurfaces[thread]->getCanvas();
+                SkFont font(fTypefaces[thread % 2]);
+                SkPaint paint;
+                for (int line = 0; line < 20; line++) {
+                    font.setSize(10 + line % 4);
+                    canvas->drawSimpleText(kText, sizeof(kText) - 1, SkTextEncoding::kUTF8,
+                                           0, 16 + line % 3 * 16, font, paint);
+                }
+            });
+        }
+    }
+
+private:
+    const int                     fThreads;
+    SkString                      fName;
+    std::unique_ptr<SkExecutor>   fExecutor;
+    sk_sp<SkTypeface>             fTypefaces[2];
+    std::vector<sk_sp<SkSurface>> fSurfaces;
+};
+
+DEF_BENCH( return new SkGlyphCacheContentionBench(8); )
+DEF_BENCH( return new SkGlyphCacheContentionBench(16); )
+DEF_BENCH( return new SkGlyphCacheContentionBench(32); )
+
 namespace {
 class DiscardableManager : public SkStrikeServer::DiscardableHandleManager,
                            public SkStrikeClient::DiscardableHandleManager {
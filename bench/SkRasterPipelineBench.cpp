@@ -0,0 +1,111 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/Benchmark.h"
+#include "include/core/SkBlendMode.h"
+#include "include/core/SkString.h"
+#include "src/base/SkArenaAlloc.h"
+#include "src/core/SkBlendModePriv.h"
+#include "src/core/SkRasterPipeline.h"
+
+#include <functional>
+
+extern bool gDisableRasterPipelineStageFusion;
+
+// Blends a row of pixels into 8888 the way SkRasterPipelineBlitter::blitAntiH() does, with and
+// without fusing runs of stages. Only SrcOver has fused stages, so the other modes show what
+// fusing costs when it finds nothing to fuse.
+class RasterPipelineFusionBench : public Benchmark {
+public:
+    RasterPipelineFusionBench(SkBlendMode mode, bool uniformColor, bool coverage, bool fused)
+            : fMode(mode)
+            , fUniformColor(uniformColor)
+            , fCoverage(coverage)
+            , fFused(fused) {
+        fName.printf("SkRasterPipeline_fusion_%s_%s%s_%s",
+                     SkBlendMode_Name(mode),
+                     uniformColor ? "uniform" : "load",
+                     coverage ? "_coverage" : "",
+                     fused ? "fused" : "unfused");
+    }
+
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        for (int i = 0; i < kWidth; i++) {
+            fSrc[i] = 0x80406080;
+            fDst[i] = 0xff204060;
+        }
+
+        SkRasterPipeline p(&fAlloc);
+        if (fUniformColor) {
+            const float color[] = {0.25f, 0.125f, 0.375f, 0.5f};
+            p.append_constant_color(&fAlloc, color);
+        } else {
+            p.append(SkRasterPipelineOp::load_8888, &fSrcPtr);
+        }
+        p.append(SkRasterPipelineOp::clamp_01);
+        if (fCoverage && SkBlendMode_ShouldPreScaleCoverage(fMode, /*rgb_coverage=*/false)) {
+            p.append(SkRasterPipelineOp::scale_1_float, &fCoverageValue);
+            p.append(SkRasterPipelineOp::load_8888_dst, &fDstPtr);
+            SkBlendMode_AppendStages(fMode, &p);
+        } else {
+            p.append(SkRasterPipelineOp::load_8888_dst, &fDstPtr);
+            SkBlendMode_AppendStages(fMode, &p);
+            if (fCoverage) {
+                p.append(SkRasterPipelineOp::lerp_1_float, &fCoverageValue);
+            }
+        }
+        p.append(SkRasterPipelineOp::store_8888, &fDstPtr);
+
+        gDisableRasterPipelineStageFusion = !fFused;
+        fBlit = p.compile();
+        gDisableRasterPipelineStageFusion = false;
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; i++) {
+            fBlit(0,0, kWidth,1);
+        }
+    }
+
+private:
+    static constexpr int kWidth = 1024;
+
+    SkBlendMode fMode;
+    bool        fUniformColor;
+    bool        fCoverage;
+    bool        fFused;
+    SkString    fName;
+
+    uint32_t fSrc[kWidth];
+    uint32_t fDst[kWidth];
+    float    fCoverageValue = 0.75f;
+    SkRasterPipeline_MemoryCtx fSrcPtr = {fSrc, 0},
+                               fDstPtr = {fDst, 0};
+
+    SkSTArenaAlloc<512> fAlloc;
+    std::function<void(size_t, size_t, size_t, size_t)> fBlit;
+};
+
+#define FUSION_BENCH(mode)                                                                  \
+    DEF_BENCH( return new RasterPipelineFusionBench(mode, false, false, false); )           \
+    DEF_BENCH( return new RasterPipelineFusionBench(mode, false, false,  true); )           \
+    DEF_BENCH( return new RasterPipelineFusionBench(mode, false,  true, false); )           \
+    DEF_BENCH( return new RasterPipelineFusionBench(mode, false,  true,  true); )           \
+    DEF_BENCH( return new RasterPipelineFusionBench(mode,  true, false, false); )           \
+    DEF_BENCH( return new RasterPipelineFusionBench(mode,  true, false,  true); )           \
+    DEF_BENCH( return new RasterPipelineFusionBench(mode,  true,  true, false); )           \
+    DEF_BENCH( return new RasterPipelineFusionBench(mode,  true,  true,  true); )
+
+FUSION_BENCH(SkBlendMode::kSrcOver)
+FUSION_BENCH(SkBlendMode::kSrcATop)
+FUSION_BENCH(SkBlendMode::kModulate)
+FUSION_BENCH(SkBlendMode::kScreen)
@@ -6,7 +6,10 @@
  */
 
 #include "bench/Benchmark.h"
+#include "include/codec/SkCodec.h"
+#include "include/core/SkBitmap.h"
 #include "include/core/SkStream.h"
+#include "tools/Resources.h"
 
 class StreamBench : public Benchmark {
     SkString    fName;
@@ -44,7 +47,85 @@ private:
     using INHERITED = Benchmark;
 };
 
+// Opens and decodes a file through SkFILEStream, either letting the codec read the mapped file
+// directly or hiding the mapping so the codec has to copy the file through read().
+class FileDecodeBench : public Benchmark {
+    SkString    fName;
+    SkString    fPath;
+    const bool  fMapped;
+    SkBitmap    fBitmap;
+public:
+    FileDecodeBench(const char* name, const char* path, bool mapped)
+        : fPath(path), fMapped(mapped) {
+        fName.printf("decode_file_%s_%s", name, mapped ? "mapped" : "read");
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        fPath = GetResourcePath(fPath.c_str());
+        std::unique_ptr<SkCodec> codec = SkCodec::MakeFromStream(this->openStream());
+        SkASSERT(codec);
+        fBitmap.allocPixels(codec->getInfo().makeColorType(kN32_SkColorType)
+                                            .makeAlphaType(kPremul_SkAlphaType));
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; ++i) {
+            std::unique_ptr<SkCodec> codec = SkCodec::MakeFromStream(this->openStream());
+            codec->getPixels(fBitmap.pixmap());
+        }
+    }
+
+private:
+    class UnmappedStream final : public SkStream {
+    public:
+        explicit UnmappedStream(std::unique_ptr<SkStreamAsset> stream)
+            : fStream(std::move(stream)) {}
+
+        size_t read(void* buffer, size_t size) override { return fStream->read(buffer, size); }
+        bool isAtEnd() const override { return fStream->isAtEnd(); }
+        bool rewind() override { return fStream->rewind(); }
+        bool hasPosition() const override { return true; }
+        size_t getPosition() const override { return fStream->getPosition(); }
+        bool seek(size_t position) override { return fStream->seek(position); }
+        bool move(long offset) override { return fStream->move(offset); }
+        bool hasLength() const override { return true; }
+        size_t getLength() const override { return fStream->getLength(); }
+
+    private:
+        std::unique_ptr<SkStreamAsset> fStream;
+    };
+
+    std::unique_ptr<SkStream> openStream() const {
+        std::unique_ptr<SkStreamAsset> stream = SkFILEStream::Make(fPath.c_str());
+        SkASSERT(stream);
+        if (fMapped) {
+            return stream;
+        }
+        return std::make_unique<UnmappedStream>(std::move(stream));
+    }
+
+    using INHERITED = Benchmark;
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 
 DEF_BENCH(return new StreamBench(false);)
 DEF_BENCH(return new StreamBench(true);)
+
+DEF_BENCH(return new FileDecodeBench("gif", "images/flightAnim.gif", true);)
+DEF_BENCH(return new FileDecodeBench("gif", "images/flightAnim.gif", false);)
+DEF_BENCH(return new FileDecodeBench("jpeg", "images/iphone_13_pro.jpeg", true);)
+DEF_BENCH(return new FileDecodeBench("jpeg", "images/iphone_13_pro.jpeg", false);)
+DEF_BENCH(return new FileDecodeBench("webp", "images/stoplight.webp", true);)
+DEF_BENCH(return new FileDecodeBench("webp", "images/stoplight.webp", false);)
+#if defined(SK_CODEC_DECODES_RAW) && (!defined(_WIN32))
+DEF_BENCH(return new FileDecodeBench("dng", "images/dng_with_preview.dng", true);)
+DEF_BENCH(return new FileDecodeBench("dng", "images/dng_with_preview.dng", false);)
+#endif
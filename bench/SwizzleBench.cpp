@@ -6,6 +6,10 @@
  */
 
 #include "bench/Benchmark.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkString.h"
+#include "include/private/SkEncodedInfo.h"
+#include "src/codec/SkSwizzler.h"
 #include "src/core/SkOpts.h"
 
 class SwizzleBench : public Benchmark {
@@ -18,7 +22,7 @@ public:
     const char* onGetName() override { return fName; }
     void onDraw(int loops, SkCanvas*) override {
         static const int K = 1023; // Arbitrary, but nice to be a non-power-of-two to trip up SIMD.
-        uint32_t dst[K], src[K];
+        uint32_t dst[K], src[2*K];  // Big enough for 8 bytes per source pixel.
         while (loops --> 0) {
             if (fFn_u32) { fFn_u32(dst,                 src, K); }
             if (fFn_u8)  { fFn_u8 (dst, (const uint8_t*)src, K); }
@@ -30,6 +34,80 @@ private:
     SkOpts::Swizzle_8888_u8  fFn_u8  = nullptr;
 };
 
+// Expands palette indices of 1, 2, 4, or 8 bits into colors.
+class IndexBench : public Benchmark {
+public:
+    IndexBench(int bits) : fBits(bits) {
+        fName.printf("SkOpts::%sindex_to_8888_%d", bits < 8 ? "small_" : "", bits);
+        for (int i = 0; i < 256; i++) {
+            fColorTable[i] = 0xff000000 | (i * 0x010101);
+        }
+    }
+
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+    const char* onGetName() override { return fName.c_str(); }
+    void onDraw(int loops, SkCanvas*) override {
+        static const int K = 1023;
+        uint32_t dst[K];
+        uint8_t src[K];
+        for (int i = 0; i < K; i++) {
+            src[i] = (uint8_t)(i * 37);
+        }
+        while (loops --> 0) {
+            if (fBits < 8) {
+                SkOpts::small_index_to_8888(dst, src, K, fBits, fColorTable);
+            } else {
+                SkOpts::index_to_8888(dst, src, K, fColorTable);
+            }
+        }
+    }
+private:
+    SkString  fName;
+    const int fBits;
+    uint32_t  fColorTable[256];
+};
+
+// Swizzles a row through SkSwizzler, as a codec would, optionally sampling every sampleX pixels.
+class SwizzlerBench : public Benchmark {
+public:
+    SwizzlerBench(const char* name, SkEncodedInfo::Color color, SkEncodedInfo::Alpha alpha,
+                  int bitsPerComponent, int sampleX)
+        : fColor(color), fAlpha(alpha), fBitsPerComponent(bitsPerComponent), fSampleX(sampleX) {
+        fName.printf("SkSwizzler_%s_sampleX_%d", name, sampleX);
+    }
+
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        const SkEncodedInfo encodedInfo = SkEncodedInfo::Make(kWidth, 1, fColor, fAlpha,
+                                                              fBitsPerComponent);
+        const SkImageInfo dstInfo = SkImageInfo::MakeN32Premul(kWidth, 1);
+        fSwizzler = SkSwizzler::Make(encodedInfo, fColorTable, dstInfo, SkCodec::Options());
+        SkASSERT(fSwizzler);
+        fSwizzler->setSampleX(fSampleX);
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        while (loops --> 0) {
+            fSwizzler->swizzle(fDst, fSrc);
+        }
+    }
+
+private:
+    static constexpr int kWidth = 1023;
+
+    SkString                    fName;
+    const SkEncodedInfo::Color  fColor;
+    const SkEncodedInfo::Alpha  fAlpha;
+    const int                   fBitsPerComponent;
+    const int                   fSampleX;
+    std::unique_ptr<SkSwizzler> fSwizzler;
+    uint32_t                    fDst[kWidth];
+    uint8_t                     fSrc[kWidth * 8] = {};
+    SkPMColor                   fColorTable[256] = {};  // Only read by the palette formats.
+};
+
 
 DEF_BENCH(return new SwizzleBench("SkOpts::RGBA_to_rgbA", SkOpts::RGBA_to_rgbA));
 DEF_BENCH(return new SwizzleBench("SkOpts::RGBA_to_bgrA", SkOpts::RGBA_to_bgrA));
@@ -41,3 +119,30 @@ DEF_BENCH(return new SwizzleBench("SkOpts::grayA_to_RGBA", SkOpts::grayA_to_RGBA
 DEF_BENCH(return new SwizzleBench("SkOpts::grayA_to_rgbA", SkOpts::grayA_to_rgbA));
 DEF_BENCH(return new SwizzleBench("SkOpts::inverted_CMYK_to_RGB1", SkOpts::inverted_CMYK_to_RGB1));
 DEF_BENCH(return new SwizzleBench("SkOpts::inverted_CMYK_to_BGR1", SkOpts::inverted_CMYK_to_BGR1));
+DEF_BENCH(return new SwizzleBench("SkOpts::RGB16_to_RGB1",  SkOpts::RGB16_to_RGB1));
+DEF_BENCH(return new SwizzleBench("SkOpts::RGB16_to_BGR1",  SkOpts::RGB16_to_BGR1));
+DEF_BENCH(return new SwizzleBench("SkOpts::RGBA16_to_RGBA", SkOpts::RGBA16_to_RGBA));
+DEF_BENCH(return new SwizzleBench("SkOpts::RGBA16_to_BGRA", SkOpts::RGBA16_to_BGRA));
+
+DEF_BENCH(return new IndexBench(1));
+DEF_BENCH(return new IndexBench(2));
+DEF_BENCH(return new IndexBench(4));
+DEF_BENCH(return new IndexBench(8));
+
+#define SWIZZLER_BENCHES(name, color, alpha, bits)                                        \
+    DEF_BENCH(return new SwizzlerBench(name, SkEncodedInfo::color, SkEncodedInfo::alpha, \
+                                       bits, 1));                                         \
+    DEF_BENCH(return new SwizzlerBench(name, SkEncodedInfo::color, SkEncodedInfo::alpha, \
+                                       bits, 2));                                         \
+    DEF_BENCH(return new SwizzlerBench(name, SkEncodedInfo::color, SkEncodedInfo::alpha, \
+                                       bits, 4));
+
+SWIZZLER_BENCHES("rgb",     kRGB_Color,       kOpaque_Alpha,    8)
+SWIZZLER_BENCHES("rgba",    kRGBA_Color,      kUnpremul_Alpha,  8)
+SWIZZLER_BENCHES("grayA",   kGrayAlpha_Color, kUnpremul_Alpha,  8)
+SWIZZLER_BENCHES("rgb16",   kRGB_Color,       kOpaque_Alpha,   16)
+SWIZZLER_BENCHES("rgba16",  kRGBA_Color,      kUnpremul_Alpha, 16)
+SWIZZLER_BENCHES("index1",  kPalette_Color,   kOpaque_Alpha,    1)
+SWIZZLER_BENCHES("index2",  kPalette_Color,   kOpaque_Alpha,    2)
+SWIZZLER_BENCHES("index4",  kPalette_Color,   kOpaque_Alpha,    4)
+SWIZZLER_BENCHES("index8",  kPalette_Color,   kOpaque_Alpha,    8)
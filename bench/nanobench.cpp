@@ -36,6 +36,7 @@
 #include "src/base/SkLeanWindows.h"
 #include "src/core/SkColorSpacePriv.h"
 #include "src/core/SkOSFile.h"
+#include "src/core/SkOpts.h"
 #include "src/core/SkTaskGroup.h"
 #include "src/core/SkTraceEvent.h"
 #include "src/utils/SkJSONWriter.h"
@@ -141,6 +142,9 @@ static DEFINE_string(zoom, "1.0,0",
                      "function that ping-pongs between 1.0 and zoomMax.");
 static DEFINE_bool(bbh, true, "Build a BBH for SKPs?");
 static DEFINE_bool(loopSKP, true, "Loop SKPs like we do for micro benches?");
+static DEFINE_string(skpThreads, "",
+                     "Space-separated thread counts for tiled, parallel raster SKP playback, "
+                     "e.g. '1 2 4 8'.  Each SKP is benched once per count.");
 static DEFINE_int(flushEvery, 10, "Flush --outResultsFile every Nth run.");
 static DEFINE_bool(gpuStats, false, "Print GPU stats after each gpu benchmark?");
 static DEFINE_bool(gpuStatsDump, false, "Dump GPU stats after each benchmark to json");
@@ -155,6 +159,8 @@ static DEFINE_string(benchType,  "",
 
 static DEFINE_bool(forceRasterPipeline, false, "sets gSkForceRasterPipelineBlitter");
 static DEFINE_bool(forceRasterPipelineHP, false, "sets gSkForceRasterPipelineBlitter and gForceHighPrecisionRasterPipeline");
+static DEFINE_string(rasterPipelineBackend, "",
+                     "If set, run SkRasterPipeline with this backend: baseline, hsw or skx.");
 static DEFINE_bool(skvm, false, "sets gUseSkVMBlitter");
 static DEFINE_bool(jit, true, "JIT SkVM?");
 static DEFINE_bool(dylib, false, "JIT via dylib (much slower compile but easier to debug/profile)");
@@ -804,6 +810,15 @@ public:
             }
         }
 
+        for (int i = 0; i < FLAGS_skpThreads.size(); i++) {
+            if (1 != sscanf(FLAGS_skpThreads[i], "%d", &fSKPThreads.push_back()) ||
+                fSKPThreads.back() < 1) {
+                SkDebugf("Can't parse %s from --skpThreads as a thread count.\n",
+                         FLAGS_skpThreads[i]);
+                exit(1);
+            }
+        }
+
         if (2 != sscanf(FLAGS_zoom[0], "%f,%lf", &fZoomMax, &fZoomPeriodMs)) {
             SkDebugf("Can't parse %s from --zoom as a zoomMax,zoomPeriodMs.\n", FLAGS_zoom[0]);
             exit(1);
@@ -998,8 +1013,37 @@ public:
                 }
             }
 
+            // Then once per --skpThreads count as tiled, parallel raster playback.
+            while (fCurrentParallelSKP < fSKPs.size() && !fSKPThreads.empty()) {
+                const SkString& path = fSKPs[fCurrentParallelSKP];
+                const int threads = fSKPThreads[fCurrentSKPThreads];
+                if (++fCurrentSKPThreads == fSKPThreads.size()) {
+                    fCurrentSKPThreads = 0;
+                    fCurrentParallelSKP++;
+                }
+                sk_sp<SkPicture> pic = ReadPicture(path.c_str());
+                if (!pic) {
+                    continue;
+                }
+
+                if (FLAGS_bbh) {
+                    SkRTreeFactory factory;
+                    SkPictureRecorder recorder;
+                    pic->playback(recorder.beginRecording(pic->cullRect().width(),
+                                                          pic->cullRect().height(),
+                                                          &factory));
+                    pic = recorder.finishRecordingAsPicture();
+                }
+                SkString name = SkOSPath::Basename(path.c_str());
+                fSourceType = "skp";
+                fBenchType = "parallel_playback";
+                return new SKPParallelBench(name.c_str(), pic.get(), fClip,
+                                            fScales[fCurrentScale], threads);
+            }
+
             fCurrentSKP = 0;
             fCurrentSVG = 0;
+            fCurrentParallelSKP = 0;
             fCurrentScale++;
         }
 
@@ -1129,18 +1173,30 @@ public:
                 continue;
             }
 
+            // Compare sampling with resampling, and with decoding then scaling, at each size.
+            const AndroidCodecBench::Mode modes[] = {
+                AndroidCodecBench::Mode::kSample,
+                AndroidCodecBench::Mode::kBox,
+                AndroidCodecBench::Mode::kMitchell,
+                AndroidCodecBench::Mode::kDecodeThenScale,
+            };
             while (fCurrentSampleSize < (int) std::size(sampleSizes)) {
                 int sampleSize = sampleSizes[fCurrentSampleSize];
-                fCurrentSampleSize++;
                 if (10 * sampleSize > std::min(codec->getInfo().width(), codec->getInfo().height())) {
                     // Avoid benchmarking scaled decodes of already small images.
                     break;
                 }
 
+                AndroidCodecBench::Mode mode = modes[fCurrentAndroidCodecMode];
+                if (++fCurrentAndroidCodecMode == (int) std::size(modes)) {
+                    fCurrentAndroidCodecMode = 0;
+                    fCurrentSampleSize++;
+                }
                 return new AndroidCodecBench(SkOSPath::Basename(path.c_str()),
-                                             encoded.get(), sampleSize);
+                                             encoded.get(), sampleSize, mode);
             }
             fCurrentSampleSize = 0;
+            fCurrentAndroidCodecMode = 0;
         }
 
 #ifdef SK_ENABLE_ANDROID_UTILS
@@ -1270,6 +1326,7 @@ private:
     const skiagm::GMRegistry* fGMs;
     SkIRect            fClip;
     SkTArray<SkScalar> fScales;
+    SkTArray<int>      fSKPThreads;
     SkTArray<SkString> fSKPs;
     SkTArray<SkString> fMSKPs;
     SkTArray<SkString> fSVGs;
@@ -1289,9 +1346,12 @@ private:
     int fCurrentScale = 0;
     int fCurrentSKP = 0;
     int fCurrentSVG = 0;
+    int fCurrentParallelSKP = 0;
+    int fCurrentSKPThreads = 0;
     int fCurrentTextBlobTrace = 0;
     int fCurrentCodec = 0;
     int fCurrentAndroidCodec = 0;
+    int fCurrentAndroidCodecMode = 0;
 #ifdef SK_ENABLE_ANDROID_UTILS
     int fCurrentBRDImage = 0;
     int fCurrentSubsetType = 0;
@@ -1425,6 +1485,12 @@ int main(int argc, char** argv) {
 
     gSkForceRasterPipelineBlitter     = FLAGS_forceRasterPipelineHP || FLAGS_forceRasterPipeline;
     gForceHighPrecisionRasterPipeline = FLAGS_forceRasterPipelineHP;
+    if (!FLAGS_rasterPipelineBackend.isEmpty() &&
+        !SkOpts::SetRasterPipelineBackend(FLAGS_rasterPipelineBackend[0])) {
+        SkDebugf("ERROR: --rasterPipelineBackend %s is not available on this CPU.\n",
+                 FLAGS_rasterPipelineBackend[0]);
+        return 1;
+    }
     gUseSkVMBlitter = FLAGS_skvm;
     gSkVMAllowJIT = FLAGS_jit;
     gSkVMJITViaDylib = FLAGS_dylib;
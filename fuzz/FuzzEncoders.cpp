@@ -69,6 +69,8 @@ DEF_FUZZ(WEBPEncoder, fuzz) {
     } else {
         opts.fCompression = SkWebpEncoder::Compression::kLossless;
     }
+    fuzz->next(&opts.fMultithreaded);
+    fuzz->next(&opts.fFastLossless);
 
     SkDynamicMemoryWStream dest;
     (void)SkWebpEncoder::Encode(&dest, bm.pixmap(), opts);
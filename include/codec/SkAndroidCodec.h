@@ -195,6 +195,15 @@ public:
      */
     SkISize getSampledSubsetDimensions(int sampleSize, const SkIRect& subset) const;
 
+    /**
+     *  Filters getAndroidPixels() may use to downscale to an arbitrary size.
+     */
+    enum class ResampleFilter {
+        kNone,      // Only scale by fSampleSize.
+        kBox,       // Average the source pixels covered by each destination pixel.
+        kMitchell,  // Mitchell-Netravali cubic (B = C = 1/3), sharper than kBox.
+    };
+
     /**
      *  Additional options to pass to getAndroidPixels().
      */
@@ -206,6 +215,7 @@ public:
         AndroidOptions()
             : SkCodec::Options()
             , fSampleSize(1)
+            , fResampleFilter(ResampleFilter::kNone)
         {}
 
         /**
@@ -216,6 +226,21 @@ public:
          *  The default is 1, representing no downscaling.
          */
         int fSampleSize;
+
+        /**
+         *  If not kNone, fSampleSize is ignored, and the info passed to
+         *  getAndroidPixels() may have any dimensions no larger than the image
+         *  (or fSubset, if set).
+         *
+         *  The image is decoded a row at a time, using any scaling the format
+         *  supports natively, and each row is filtered into the output as it
+         *  arrives, so the full resolution image is never held in memory.
+         *  Formats that cannot decode a row at a time, and frames other than
+         *  the first, are decoded whole before they are filtered.
+         *
+         *  The default is kNone.
+         */
+        ResampleFilter fResampleFilter;
     };
 
     /**
@@ -240,7 +265,8 @@ public:
      *
      *  The AndroidOptions object is also used to specify any requested scaling or subsetting
      *  using options->fSampleSize and options->fSubset. If NULL, the defaults (as specified above
-     *  for AndroidOptions) are used.
+     *  for AndroidOptions) are used.  Set options->fResampleFilter to scale to a size that
+     *  fSampleSize cannot reach.
      *
      *  @return Result kSuccess, or another value explaining the type of failure.
      */
@@ -291,6 +317,9 @@ protected:
             size_t rowBytes, const AndroidOptions& options) = 0;
 
 private:
+    SkCodec::Result resampledDecode(const SkImageInfo& info, void* pixels, size_t rowBytes,
+                                    const AndroidOptions& options);
+
     const SkImageInfo               fInfo;
     std::unique_ptr<SkCodec>        fCodec;
 };
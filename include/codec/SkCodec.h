@@ -27,6 +27,7 @@
 
 class SkAndroidCodec;
 class SkData;
+class SkExecutor;
 class SkFrameHolder;
 class SkImage;
 class SkPngChunkReader;
@@ -298,6 +299,7 @@ public:
             , fSubset(nullptr)
             , fFrameIndex(0)
             , fPriorFrame(kNoFrame)
+            , fExecutor(nullptr)
         {}
 
         ZeroInitialized            fZeroInitialized;
@@ -341,6 +343,14 @@ public:
          *  If set to kNoFrame, the codec will decode any necessary required frame(s) first.
          */
         int                        fPriorFrame;
+
+        /**
+         *  If not NULL, codecs that can split a decode into independent pieces may use this
+         *  executor to decode them in parallel (currently only JPEGs with restart markers).
+         *  The output is identical to a serial decode. Ignored by scanline decodes.
+         *  The decoding thread helps with the work, so it may be one of the executor's threads.
+         */
+        SkExecutor*                fExecutor;
     };
 
     /**
@@ -13,8 +13,10 @@
 #include <memory>
 
 class SkData;
+class SkExecutor;
 class SkImageGenerator;
 class SkOpenTypeSVGDecoder;
+class SkString;
 class SkTraceMemoryDump;
 
 class SK_API SkGraphics {
@@ -156,6 +158,61 @@ public:
      *  Call early in main() to allow Skia to use a JIT to accelerate CPU-bound operations.
      */
     static void AllowJIT();
+
+    /**
+     *  Abstract cache of JIT-compiled programs, kept between runs of the process (e.g. on disk).
+     */
+    class SK_API PersistentCache {
+    public:
+        virtual ~PersistentCache() = default;
+
+        /**
+         *  Returns the data for the key if it exists in the cache, otherwise returns null.
+         */
+        virtual sk_sp<SkData> load(const SkData& key) = 0;
+
+        /**
+         *  Stores data in the cache, indexed by key. description provides a human-readable
+         *  version of the key.
+         */
+        virtual void store(const SkData& key, const SkData& data, const SkString& description) = 0;
+
+    protected:
+        PersistentCache() = default;
+        PersistentCache(const PersistentCache&) = delete;
+        PersistentCache& operator=(const PersistentCache&) = delete;
+    };
+
+    /**
+     *  Programs JIT-compiled for the CPU backend are shared by every thread of the process. If a
+     *  cache is set, they are also looked for there before being optimized, and stored there once
+     *  optimized, so later runs of the process need not optimize them again. Programs are stored
+     *  in a portable form and compiled to machine code again when loaded. Programs that read
+     *  memory at computed addresses, as image shaders do, are not stored.
+     *
+     *  Blitters made after this call use the new cache. The cache must outlive any drawing, and
+     *  is used from any thread that draws, so it must be thread-safe. Pass nullptr to stop using
+     *  a cache.
+     */
+    static void SetJITProgramCache(PersistentCache*);
+
+    /**
+     *  Anti-aliased fills of paths with very many points (65536 or more) are split into bands of
+     *  rows, which are scan converted on this executor and then blit on the drawing thread.
+     *  The drawing thread scan converts bands as well and never waits on queued work, so it is
+     *  fine to draw from the executor's own threads. Only worthwhile if the executor has several
+     *  threads. The executor must outlive any drawing. Pass nullptr, the default, to scan
+     *  convert every path on the drawing thread.
+     */
+    static void SetPathFillExecutor(SkExecutor*);
+
+    /**
+     *  Large CPU blurs, from blur mask filters and blur image filters, are split into bands of
+     *  rows that are blurred on this executor and on the drawing thread. The result is the same.
+     *  Only worthwhile if the executor has several threads. The executor must outlive any
+     *  drawing. Pass nullptr, the default, to blur on the drawing thread.
+     */
+    static void SetBlurExecutor(SkExecutor*);
 };
 
 class SkAutoGraphics {
@@ -23,9 +23,12 @@ class GrSurfaceProxyView;
 class GrSamplerState;
 class SkBitmap;
 class SkData;
+class SkDiscardableMemory;
 class SkMatrix;
+class SkMipmap;
 class SkPaint;
 class SkPicture;
+class SkString;
 
 enum class GrImageTexGenPolicy : int;
 
@@ -158,6 +161,52 @@ public:
     static std::unique_ptr<SkImageGenerator> MakeFromEncoded(
             sk_sp<SkData>, std::optional<SkAlphaType> = std::nullopt);
 
+    /**
+     *  Storage for decoded pixels that outlives the process, e.g. files on disk. This plays the
+     *  role for decoded images that GrContextOptions::PersistentCache plays for shaders.
+     */
+    class SK_API PersistentCache {
+    public:
+        virtual ~PersistentCache() = default;
+
+        /**
+         *  Returns the data for the key if it exists in the cache, otherwise returns null.
+         *  Pixels are copied straight out of the returned data, so data that maps a file (see
+         *  SkData::MakeFromFD) need not be read into memory first.
+         */
+        virtual sk_sp<SkData> load(const SkData& key) = 0;
+
+        /**
+         *  Stores data in the cache, indexed by key. description provides a human-readable
+         *  version of the key.
+         */
+        virtual void store(const SkData& key, const SkData& data, const SkString& description) = 0;
+
+    protected:
+        PersistentCache() = default;
+        PersistentCache(const PersistentCache&) = delete;
+        PersistentCache& operator=(const PersistentCache&) = delete;
+    };
+
+    /**
+     *  Returns a generator that looks for its pixels in the cache before asking the specified
+     *  generator for them, and stores the pixels that generator produces there. Entries are
+     *  keyed by an MD5 digest of the generator's encoded data (see refEncodedData()) and the
+     *  requested SkImageInfo, so a later process decoding the same data finds them. A generator
+     *  without encoded data is returned as is.
+     *
+     *  If withMipmaps is true, the mipmaps built for drawing images made from the returned
+     *  generator are stored in the cache as well.
+     *
+     *  The cache must outlive the returned generator, and may be called from any thread.
+     *
+     *  Keys are only as trustworthy as MD5: whoever can supply encoded data can craft data with
+     *  the same digest as another image, and have the pixels it decodes to drawn in that image's
+     *  place. Don't share a cache between trusted images and untrusted encoded data.
+     */
+    static std::unique_ptr<SkImageGenerator> MakeWithPersistentCache(
+            std::unique_ptr<SkImageGenerator>, PersistentCache*, bool withMipmaps = false);
+
     /** Return a new image generator backed by the specified picture.  If the size is empty or
      *  the picture is NULL, this returns NULL.
      *  The optional matrix and paint arguments are passed to drawPicture() at rasterization
@@ -181,6 +230,13 @@ protected:
     virtual bool onQueryYUVAInfo(const SkYUVAPixmapInfo::SupportedDataTypes&,
                                  SkYUVAPixmapInfo*) const { return false; }
     virtual bool onGetYUVAPlanes(const SkYUVAPixmaps&) { return false; }
+
+    // Returns the mipmaps of base, the pixels this generator produced for base.info(), allocated
+    // with the factory if it is not null. Returning nullptr has the caller build them instead.
+    virtual SkMipmap* onMakeMipmaps(const SkPixmap& base,
+                                    SkDiscardableMemory* (*factory)(size_t bytes)) {
+        return nullptr;
+    }
 #if defined(SK_GANESH)
     // returns nullptr
     virtual GrSurfaceProxyView onGenerateTexture(GrRecordingContext*, const SkImageInfo&,
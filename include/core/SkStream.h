@@ -350,6 +350,12 @@ public:
 
     size_t getLength() const override;
 
+    /** Maps the file into memory the first time this is called, so readers that can work from
+     *  memory (e.g. codecs) avoid copying it through read(). Returns nullptr if the file
+     *  cannot be mapped.
+     */
+    const void* getMemoryBase() override;
+
 private:
     explicit SkFILEStream(FILE*, size_t size, size_t start);
     explicit SkFILEStream(std::shared_ptr<FILE>, size_t end, size_t start);
@@ -365,6 +371,10 @@ private:
     size_t fStart;
     size_t fCurrent;
 
+    // The whole file, mapped lazily by getMemoryBase() and shared with duplicates and forks.
+    sk_sp<SkData> fMapping;
+    bool fTriedMapping = false;
+
     using INHERITED = SkStreamAsset;
 };
 
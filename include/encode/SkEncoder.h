@@ -15,6 +15,9 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <functional>
+
+class SkCanvas;
 
 class SK_API SkEncoder : SkNoncopyable {
 public:
@@ -43,6 +46,27 @@ public:
      */
     bool encodeRows(int numRows);
 
+    /**
+     *  Encode the rows in |rows|, which continue the image from the last row encoded, instead
+     *  of reading them from the src.  |rows| must match the width, color type and alpha type
+     *  of the src; any rows past the end of the image are ignored.  Returns false once every
+     *  row of the image has been encoded.
+     *
+     *  This lets the caller produce the image a band at a time without ever holding all of it,
+     *  e.g. with an encoder made from an SkImageInfo rather than an SkPixmap.
+     */
+    bool encodeRows(const SkPixmap& rows);
+
+    /**
+     *  Draw the remaining rows of the image band by band and encode each band as soon as it
+     *  has been drawn.  |draw| is called once per band with a canvas that covers that band
+     *  (translated so that it draws in image coordinates) and has been cleared to transparent.
+     *
+     *  Only one band of |bandHeight| rows is allocated, so peak memory does not grow with the
+     *  height of the image.
+     */
+    bool encodeBands(int bandHeight, const std::function<void(SkCanvas*)>& draw);
+
     virtual ~SkEncoder() {}
 
 protected:
@@ -55,7 +79,16 @@ protected:
         , fStorage(storageBytes)
     {}
 
-    const SkPixmap&        fSrc;
+    /**
+     *  Returns the address of row |fCurrRow + i|, from the rows passed to
+     *  encodeRows(const SkPixmap&) if there are any and from the src otherwise.
+     */
+    const void* currRowAddr(int i) const {
+        return fRows.addr() ? fRows.addr(0, i) : fSrc.addr(0, fCurrRow + i);
+    }
+
+    const SkPixmap         fSrc;
+    SkPixmap               fRows;
     int                    fCurrRow;
     skia_private::AutoTMalloc<uint8_t> fStorage;
 };
@@ -114,6 +114,15 @@ public:
                                            const SkColorSpace* srcColorSpace,
                                            const Options& options);
 
+    /**
+     *  Create a jpeg encoder for an image described by |info| whose pixels are supplied later,
+     *  in order, through SkEncoder::encodeRows(const SkPixmap&) or SkEncoder::encodeBands().
+     *
+     *  This returns nullptr on an invalid or unsupported |info|.
+     */
+    static std::unique_ptr<SkEncoder> Make(SkWStream* dst, const SkImageInfo& info,
+                                           const Options& options);
+
     ~SkJpegEncoder() override;
 
 protected:
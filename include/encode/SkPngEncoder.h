@@ -15,6 +15,7 @@
 
 #include <memory>
 
+class SkExecutor;
 class SkPixmap;
 class SkPngEncoderMgr;
 class SkWStream;
@@ -75,6 +76,15 @@ public:
          */
         const skcms_ICCProfile* fICCProfile = nullptr;
         const char* fICCProfileDescription = nullptr;
+
+        /**
+         *  If set, Encode() splits large images into horizontal bands that are filtered and
+         *  compressed in parallel on this executor, then stitched into a single zlib stream.
+         *
+         *  The result decodes to the same pixels as a serial encode, but is not byte-identical
+         *  to it and may be slightly larger.  Encoders returned by Make() always encode serially.
+         */
+        SkExecutor* fExecutor = nullptr;
     };
 
     /**
@@ -96,6 +106,15 @@ public:
     static std::unique_ptr<SkEncoder> Make(SkWStream* dst, const SkPixmap& src,
                                            const Options& options);
 
+    /**
+     *  Create a png encoder for an image described by |info| whose pixels are supplied later,
+     *  in order, through SkEncoder::encodeRows(const SkPixmap&) or SkEncoder::encodeBands().
+     *
+     *  This returns nullptr on an invalid or unsupported |info|.
+     */
+    static std::unique_ptr<SkEncoder> Make(SkWStream* dst, const SkImageInfo& info,
+                                           const Options& options);
+
     ~SkPngEncoder() override;
 
 protected:
@@ -105,6 +124,10 @@ protected:
 
     std::unique_ptr<SkPngEncoderMgr> fEncoderMgr;
     using INHERITED = SkEncoder;
+
+private:
+    static std::unique_ptr<SkEncoder> MakeEncoder(SkWStream* dst, const SkPixmap& src,
+                                                  const Options& options);
 };
 
 static inline SkPngEncoder::FilterFlag operator|(SkPngEncoder::FilterFlag x,
@@ -39,6 +39,21 @@ namespace SkWebpEncoder {
         Compression fCompression = Compression::kLossy;
         float fQuality = 100.0f;
 
+        /**
+         *  If set, libwebp may use extra threads (WebPConfig::thread_level): lossy encodes split
+         *  the analysis pass that assigns macroblocks to segments across two threads and compress
+         *  the alpha plane alongside the color planes, while lossless encodes try their candidate
+         *  configurations concurrently.
+         */
+        bool fMultithreaded = false;
+
+        /**
+         *  Only used with kLossless.  If set, |fQuality| is ignored in favor of libwebp's fastest
+         *  lossless settings, hinted for discrete-tone content.  This suits screenshots and other
+         *  UI captures, which compress well without libwebp's more expensive searches.
+         */
+        bool fFastLossless = false;
+
         /**
          * An optional ICC profile to override the default behavior.
          *
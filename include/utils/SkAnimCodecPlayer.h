@@ -17,11 +17,22 @@
 #include <memory>
 #include <vector>
 
+class SkExecutor;
 class SkImage;
 
 class SkAnimCodecPlayer {
 public:
     SkAnimCodecPlayer(std::unique_ptr<SkCodec> codec);
+
+    /**
+     *  Like the above, but decodes the current frame and the framesAhead frames after it on
+     *  executor, ahead of getFrame(). Frames are decoded one at a time, in playback order, and
+     *  only those frames (plus the one before the current frame) are kept, rather than every
+     *  frame of the animation. getFrame() waits if its frame is still being decoded.
+     *  The executor must outlive the player.
+     */
+    SkAnimCodecPlayer(std::unique_ptr<SkCodec> codec, SkExecutor* executor, int framesAhead);
+
     ~SkAnimCodecPlayer();
 
     /**
@@ -53,14 +64,25 @@ public:
 
 
 private:
+    struct LookAhead;
+
     std::unique_ptr<SkCodec>        fCodec;
     SkImageInfo                     fImageInfo;
     std::vector<SkCodec::FrameInfo> fFrameInfos;
     std::vector<sk_sp<SkImage> >    fImages;
     int                             fCurrIndex = 0;
     uint32_t                        fTotalDuration;
+    std::unique_ptr<LookAhead>      fLookAhead;
 
     sk_sp<SkImage> getFrameAt(int index);
+    sk_sp<SkImage> decodeFrame(int index, sk_sp<SkImage> requiredImage);
+
+    // These require fLookAhead's mutex.
+    int nextFrameToDecode() const;
+    void trimFrames();
+
+    void startLookAhead();
+    void runLookAhead();
 };
 
 #endif
@@ -673,6 +673,8 @@ BASE_SRCS_ALL = [
     "src/core/SkTextBlobTrace.cpp",
     "src/core/SkTextBlobTrace.h",
     "src/core/SkTextFormatParams.h",
+    "src/core/SkTiledPictureDraw.cpp",
+    "src/core/SkTiledPictureDraw.h",
     "src/core/SkTime.cpp",
     "src/core/SkTraceEvent.h",
     "src/core/SkTraceEventCommon.h",
@@ -13,13 +13,18 @@
 #include "include/core/SkColorType.h"
 #include "include/core/SkData.h"
 #include "include/core/SkEncodedImageFormat.h"
+#include "include/core/SkPixmap.h"
 #include "include/core/SkRect.h"
 #include "include/core/SkStream.h"
 #include "include/private/SkGainmapInfo.h"
 #include "include/private/base/SkFloatingPoint.h"
+#include "include/private/base/SkTemplates.h"
 #include "modules/skcms/skcms.h"
 #include "src/codec/SkCodecPriv.h"
+#include "src/codec/SkRowResampler.h"
 #include "src/codec/SkSampledCodec.h"
+#include "src/codec/SkSampler.h"
+#include "src/core/SkAutoPixmapStorage.h"
 
 #if defined(SK_CODEC_DECODES_WEBP) || defined(SK_CODEC_DECODES_RAW) || \
         defined(SK_HAS_WUFFS_LIBRARY) || defined(SK_CODEC_DECODES_AVIF)
@@ -525,6 +530,10 @@ SkCodec::Result SkAndroidCodec::getAndroidPixels(const SkImageInfo& requestInfo,
         }
     }
 
+    if (options->fResampleFilter != ResampleFilter::kNone) {
+        return this->resampledDecode(requestInfo, requestPixels, requestRowBytes, *options);
+    }
+
     if (auto result = fCodec->handleFrameIndex(requestInfo, requestPixels, requestRowBytes,
             *options, this); result != SkCodec::kSuccess) {
         return result;
@@ -538,6 +547,124 @@ SkCodec::Result SkAndroidCodec::getAndroidPixels(const SkImageInfo& info, void*
     return this->getAndroidPixels(info, pixels, rowBytes, nullptr);
 }
 
+// Returns the smallest size the codec can scale to natively that is at least |size|.
+static SkISize native_size_at_least(const SkCodec* codec, const SkISize& size) {
+    const SkISize dims = codec->dimensions();
+    const float desiredScale = std::max((float) size.width()  / dims.width(),
+                                        (float) size.height() / dims.height());
+    SkISize nativeSize = codec->getScaledDimensions(desiredScale);
+    if (!smaller_than(nativeSize, size)) {
+        return nativeSize;
+    }
+
+    // Some codecs round to the nearest scale they support, which may be too small.  Step up
+    // through the eighths that libjpeg supports.
+    for (int eighths = 1; eighths < 8; eighths++) {
+        const float scale = eighths / 8.0f;
+        if (scale > desiredScale) {
+            nativeSize = codec->getScaledDimensions(scale);
+            if (!smaller_than(nativeSize, size)) {
+                return nativeSize;
+            }
+        }
+    }
+    return dims;
+}
+
+SkCodec::Result SkAndroidCodec::resampledDecode(const SkImageInfo& info, void* pixels,
+        size_t rowBytes, const AndroidOptions& options) {
+    const SkIRect srcRect = options.fSubset ? *options.fSubset
+                                            : SkIRect::MakeSize(fCodec->dimensions());
+    if (info.isEmpty() || smaller_than(srcRect.size(), info.dimensions())) {
+        return SkCodec::kInvalidScale;
+    }
+
+    AndroidOptions plainOptions = options;
+    plainOptions.fSampleSize = 1;
+    plainOptions.fResampleFilter = ResampleFilter::kNone;
+
+    // Let the codec scale natively as far as it can.  Subsets are decoded at full size, rather
+    // than trying to line the subset up with the codec's scaled output.
+    const SkISize srcSize = options.fSubset ? srcRect.size()
+                                            : native_size_at_least(fCodec.get(), info.dimensions());
+    if (srcSize == info.dimensions()) {
+        return this->getAndroidPixels(info, pixels, rowBytes, &plainOptions);
+    }
+
+    // Rows are filtered premultiplied, so decode them that way.  Every row of the destination
+    // will be written, so the decode does not need to know if it was zero initialized.
+    SkImageInfo decodeInfo = info.makeDimensions(srcSize);
+    if (kUnpremul_SkAlphaType == decodeInfo.alphaType()) {
+        decodeInfo = decodeInfo.makeAlphaType(kPremul_SkAlphaType);
+    }
+    const SkImageInfo rowInfo = decodeInfo.makeWH(srcSize.width(), 1);
+    plainOptions.fZeroInitialized = SkCodec::kNo_ZeroInitialized;
+
+    const SkPixmap dst(info, pixels, rowBytes);
+    SkRowResampler resampler(srcSize.width(), srcSize.height(), dst, options.fResampleFilter);
+
+    if (0 == options.fFrameIndex &&
+            SkCodec::kTopDown_SkScanlineOrder == fCodec->getScanlineOrder()) {
+        // The scanline decoder only subsets in x.  Skip rows to subset in y.
+        AndroidOptions scanlineOptions = plainOptions;
+        SkImageInfo scanlineInfo = decodeInfo;
+        SkIRect scanlineSubset;
+        if (options.fSubset) {
+            scanlineSubset = SkIRect::MakeXYWH(srcRect.x(), 0, srcRect.width(),
+                                               fCodec->dimensions().height());
+            scanlineOptions.fSubset = &scanlineSubset;
+            scanlineInfo = decodeInfo.makeDimensions(fCodec->dimensions());
+        }
+
+        // Like getAndroidPixels(), rewind and set up the color xform before decoding.
+        SkCodec::Result startResult = fCodec->handleFrameIndex(scanlineInfo, nullptr, 0,
+                                                               scanlineOptions, this);
+        if (SkCodec::kSuccess == startResult) {
+            startResult = fCodec->startScanlineDecode(scanlineInfo, &scanlineOptions);
+        }
+        if (SkCodec::kSuccess == startResult) {
+            if (srcRect.y() > 0 && !fCodec->skipScanlines(srcRect.y())) {
+                SkSampler::Fill(info, pixels, rowBytes, options.fZeroInitialized);
+                return SkCodec::kIncompleteInput;
+            }
+
+            SkCodec::Result result = SkCodec::kSuccess;
+            skia_private::AutoTMalloc<uint8_t> row(rowInfo.minRowBytes());
+            for (int y = 0; y < srcSize.height(); y++) {
+                if (1 != fCodec->getScanlines(row.get(), 1, rowInfo.minRowBytes())) {
+                    // The codec has filled in the row, so carry on to fill in the output.
+                    result = SkCodec::kIncompleteInput;
+                }
+                resampler.addRow(SkPixmap(rowInfo, row.get(), rowInfo.minRowBytes()));
+            }
+            SkASSERT(resampler.rowsWritten() == info.height());
+            return result;
+        } else if (SkCodec::kIncompleteInput == startResult ||
+                   SkCodec::kErrorInInput == startResult) {
+            return SkCodec::kInvalidInput;
+        } else if (SkCodec::kUnimplemented != startResult) {
+            return startResult;
+        }
+        // kUnimplemented means the whole image needs to be decoded first.
+    }
+
+    SkAutoPixmapStorage src;
+    if (!src.tryAlloc(decodeInfo)) {
+        return SkCodec::kInternalError;
+    }
+    const SkCodec::Result result = this->getAndroidPixels(decodeInfo, src.writable_addr(),
+                                                          src.rowBytes(), &plainOptions);
+    if (SkCodec::kSuccess != result && SkCodec::kIncompleteInput != result &&
+            SkCodec::kErrorInInput != result) {
+        return result;
+    }
+    for (int y = 0; y < srcSize.height(); y++) {
+        resampler.addRow(SkPixmap(rowInfo, src.addr(0, y), src.rowBytes()));
+    }
+    SkASSERT(resampler.rowsWritten() == info.height());
+    return result;
+}
+
 bool SkAndroidCodec::getAndroidGainmap(SkGainmapInfo* info,
                                        std::unique_ptr<SkStream>* outGainmapImageStream) {
     if (!fCodec->onGetGainmapInfo(info, outGainmapImageStream)) {
@@ -14,6 +14,7 @@
 #include "include/core/SkAlphaType.h"
 #include "include/core/SkColorType.h"
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkPixmap.h"
 #include "include/core/SkRefCnt.h"
@@ -28,16 +29,18 @@
 #include "src/codec/SkJpegConstants.h"
 #include "src/codec/SkJpegDecoderMgr.h"
 #include "src/codec/SkJpegPriv.h"
+#include "src/codec/SkJpegSegmentScan.h"
 #include "src/codec/SkParseEncodedOrigin.h"
 #include "src/codec/SkSwizzler.h"
+#include "src/core/SkTaskGroup.h"
 
 #ifdef SK_CODEC_DECODES_JPEG_GAINMAPS
 #include "include/private/SkGainmapInfo.h"
 #include "src/codec/SkJpegMultiPicture.h"
-#include "src/codec/SkJpegSegmentScan.h"
 #include "src/codec/SkJpegXmp.h"
 #endif  // SK_CODEC_DECODES_JPEG_GAINMAPS
 
+#include <algorithm>
 #include <array>
 #include <csetjmp>
 #include <cstring>
@@ -59,6 +62,32 @@ extern "C" {
     #include "jmorecfg.h"
 }
 
+/*
+ * The restart markers of a single-scan JPEG that start an MCU row. Decoding may begin at any of
+ * them with a fresh decompress struct, since the decoder's bit buffer and DC predictions are
+ * reset there. See make_restart_range().
+ */
+struct SkJpegRestartIndex {
+    // The header runs from SOI through the SOS segment.
+    size_t fHeaderSize = 0;
+    size_t fFrameHeightOffset = 0;
+    size_t fEndOfImage = 0;
+    int fMcuHeight = 0;
+    int fHeight = 0;
+    int64_t fIntervals = 0;
+
+    // The offset of every RSTn marker.
+    std::vector<size_t> fRestarts;
+    // The restart intervals that start an MCU row, and the MCU row each one starts.
+    std::vector<int64_t> fRowIntervals;
+    std::vector<int> fRowStarts;
+
+    int count() const { return SkToInt(fRowIntervals.size()); }
+
+    // The first image row of entry i, or the image height for i == count().
+    int top(int i) const { return i < this->count() ? fRowStarts[i] * fMcuHeight : fHeight; }
+};
+
 bool SkJpegCodec::IsJpeg(const void* buffer, size_t bytesRead) {
     return bytesRead >= sizeof(kJpegSig) && !memcmp(buffer, kJpegSig, sizeof(kJpegSig));
 }
@@ -420,6 +449,8 @@ bool SkJpegCodec::onRewind() {
     }
     SkASSERT(nullptr != decoderMgr);
     fDecoderMgr.reset(decoderMgr);
+    fSeekStream.reset();
+    fDecoderTop = 0;
 
     fSwizzler.reset(nullptr);
     fSwizzleSrcRow = nullptr;
@@ -614,6 +645,326 @@ static inline bool needs_swizzler_to_convert_from_cmyk(J_COLOR_SPACE jpegColorTy
     return !hasCMYKColorSpace || !hasColorSpaceXform;
 }
 
+// Below this many pixels, the cost of re-reading the header for each band outweighs the win.
+static constexpr int64_t kMinParallelJpegPixels = 256 * 256;
+static constexpr int kMaxJpegBands = 16;
+static constexpr int kMinMcuRowsPerBand = 4;
+
+static bool is_restart_marker(uint8_t marker) {
+    return marker >= kJpegMarkerRestart0 && marker < kJpegMarkerRestart0 + 8;
+}
+
+static std::unique_ptr<SkJpegRestartIndex> make_restart_index(const uint8_t* data, size_t size,
+                                                              const jpeg_decompress_struct* dinfo,
+                                                              SkISize dimensions) {
+    const int restartInterval = dinfo->restart_interval;
+    if (restartInterval <= 0 || dinfo->progressive_mode) {
+        return nullptr;
+    }
+
+    SkJpegSegmentScanner scanner(kJpegMarkerEndOfImage);
+    scanner.onBytes(data, size);
+    if (!scanner.isDone()) {
+        return nullptr;
+    }
+
+    auto index = std::make_unique<SkJpegRestartIndex>();
+    const SkJpegSegment* sof = nullptr;
+    const SkJpegSegment* sos = nullptr;
+    for (const SkJpegSegment& segment : scanner.getSegments()) {
+        if (segment.marker == kJpegMarkerStartOfFrameBaseline ||
+            segment.marker == kJpegMarkerStartOfFrameExtended) {
+            sof = &segment;
+        } else if (segment.marker == kJpegMarkerStartOfScan) {
+            if (sos) {
+                // Multi-scan images interleave their rows across scans.
+                return nullptr;
+            }
+            sos = &segment;
+        } else if (segment.marker == kJpegMarkerDefineNumberOfLines) {
+            return nullptr;
+        } else if (is_restart_marker(segment.marker)) {
+            index->fRestarts.push_back(segment.offset);
+        } else if (segment.marker == kJpegMarkerEndOfImage) {
+            index->fEndOfImage = segment.offset;
+        }
+    }
+    // The SOF parameters are the length, precision, height and width, followed by components.
+    if (!sof || !sos || sof->offset > sos->offset || sof->parameterLength < 8 ||
+        sos->parameterLength < 3) {
+        return nullptr;
+    }
+    index->fHeaderSize = sos->offset + kJpegMarkerCodeSize + sos->parameterLength;
+    index->fFrameHeightOffset = sof->offset + kJpegMarkerCodeSize +
+                                kJpegSegmentParameterLengthSize + 1;
+    const int componentsInScan = data[sos->offset + kJpegMarkerCodeSize +
+                                      kJpegSegmentParameterLengthSize];
+    if (componentsInScan != dinfo->num_components || index->fHeaderSize > index->fEndOfImage) {
+        return nullptr;
+    }
+
+    // See section A.2: a non-interleaved scan has one block per MCU, an interleaved scan one
+    // block per unit of the largest sampling factors.
+    int maxH = 1, maxV = 1;
+    for (int i = 0; i < dinfo->num_components; ++i) {
+        maxH = std::max(maxH, dinfo->comp_info[i].h_samp_factor);
+        maxV = std::max(maxV, dinfo->comp_info[i].v_samp_factor);
+    }
+    const int mcuWidth = DCTSIZE * (componentsInScan == 1 ? 1 : maxH);
+    index->fMcuHeight  = DCTSIZE * (componentsInScan == 1 ? 1 : maxV);
+    index->fHeight = dimensions.height();
+    const int mcusPerRow = (dimensions.width() + mcuWidth - 1) / mcuWidth;
+    const int mcuRows = (index->fHeight + index->fMcuHeight - 1) / index->fMcuHeight;
+    index->fIntervals = ((int64_t)mcusPerRow * mcuRows + restartInterval - 1) / restartInterval;
+    if ((int64_t)index->fRestarts.size() != index->fIntervals - 1) {
+        return nullptr;
+    }
+
+    for (int64_t k = 0; k < index->fIntervals; ++k) {
+        if ((k * restartInterval) % mcusPerRow == 0) {
+            index->fRowIntervals.push_back(k);
+            index->fRowStarts.push_back(SkToInt(k * restartInterval / mcusPerRow));
+        }
+    }
+    return index;
+}
+
+/*
+ * Makes a standalone JPEG of the rows [index.top(first), index.top(last)): the original header
+ * with the frame height patched, the entropy-coded data of those rows with their restart markers
+ * renumbered from RST0, and an EOI.
+ */
+static sk_sp<SkData> make_restart_range(const uint8_t* data, const SkJpegRestartIndex& index,
+                                        int first, int last) {
+    const int64_t firstInterval = index.fRowIntervals[first];
+    const int64_t endInterval = last < index.count() ? index.fRowIntervals[last]
+                                                     : index.fIntervals;
+    // From just after the restart marker that opens the first interval to the restart marker
+    // (or EOI) that ends the last one.
+    const size_t entropyBegin = firstInterval == 0
+                                        ? index.fHeaderSize
+                                        : index.fRestarts[firstInterval - 1] + kJpegMarkerCodeSize;
+    const size_t entropyEnd = endInterval == index.fIntervals
+                                        ? index.fEndOfImage
+                                        : index.fRestarts[endInterval - 1];
+    const size_t headerSize = index.fHeaderSize;
+    const size_t entropySize = entropyEnd - entropyBegin;
+
+    sk_sp<SkData> range = SkData::MakeUninitialized(headerSize + entropySize + kJpegMarkerCodeSize);
+    uint8_t* bytes = static_cast<uint8_t*>(range->writable_data());
+    memcpy(bytes, data, headerSize);
+    memcpy(bytes + headerSize, data + entropyBegin, entropySize);
+    bytes[headerSize + entropySize] = 0xFF;
+    bytes[headerSize + entropySize + 1] = kJpegMarkerEndOfImage;
+
+    const int height = index.top(last) - index.top(first);
+    bytes[index.fFrameHeightOffset] = (height >> 8) & 0xFF;
+    bytes[index.fFrameHeightOffset + 1] = height & 0xFF;
+
+    // The decoder expects the first restart marker to be RST0.
+    for (int64_t k = firstInterval + 1; k < endInterval; ++k) {
+        const size_t offset = headerSize + (index.fRestarts[k - 1] - entropyBegin) + 1;
+        bytes[offset] = SkToU8(kJpegMarkerRestart0 + ((k - firstInterval - 1) & 7));
+    }
+    return range;
+}
+
+namespace {
+/*
+ * A range of MCU rows that a fresh decompress struct can decode from fData.
+ *
+ * Fancy upsampling reads the chroma rows on either side of each output row, so the encoded rows
+ * [fDecodeTop, fDecodeBottom) extend one restart boundary beyond the rows [fTop, fBottom) that
+ * the band actually writes. The extra rows are decoded and dropped, which makes the output
+ * identical to a serial decode.
+ */
+struct JpegBand {
+    sk_sp<SkData> fData;
+    int fDecodeTop;
+    int fDecodeBottom;
+    int fTop;
+    int fBottom;
+};
+}  // namespace
+
+/*
+ * Splits an indexed JPEG into at most maxBands bands. Returns false if the restart markers do not
+ * let us split it into at least two bands.
+ */
+static bool make_jpeg_bands(const uint8_t* data, const SkJpegRestartIndex& index, int maxBands,
+                            std::vector<JpegBand>* bands) {
+    const int mcuRows = (index.fHeight + index.fMcuHeight - 1) / index.fMcuHeight;
+    const int numEntries = index.count();
+
+    // Indices into the index where each band starts, as evenly spaced as the markers allow.
+    const int bandCount = std::min(maxBands, mcuRows / kMinMcuRowsPerBand);
+    std::vector<int> starts;
+    for (int b = 0, i = 0; b < bandCount; ++b) {
+        const int targetRow = (int)((int64_t)b * mcuRows / bandCount);
+        while (i + 1 < numEntries && index.fRowStarts[i + 1] <= targetRow) {
+            ++i;
+        }
+        if (starts.empty() || starts.back() != i) {
+            starts.push_back(i);
+        }
+    }
+    if (starts.size() < 2) {
+        return false;
+    }
+
+    bands->clear();
+    bands->reserve(starts.size());
+    for (size_t b = 0; b < starts.size(); ++b) {
+        const int first = starts[b];
+        const int last  = b + 1 < starts.size() ? starts[b + 1] : numEntries;
+        const int decodeFirst = std::max(0, first - 1);
+        const int decodeLast  = std::min(numEntries, last + 1);
+
+        JpegBand band;
+        band.fData = make_restart_range(data, index, decodeFirst, decodeLast);
+        band.fDecodeTop = index.top(decodeFirst);
+        band.fDecodeBottom = index.top(decodeLast);
+        band.fTop = index.top(first);
+        band.fBottom = index.top(last);
+        bands->push_back(std::move(band));
+    }
+    return true;
+}
+
+const SkJpegRestartIndex* SkJpegCodec::getRestartIndex() {
+    if (!fRestartIndexBuilt) {
+        fRestartIndexBuilt = true;
+        SkStream* stream = this->stream();
+        const void* data = stream->getMemoryBase();
+        if (data && stream->hasLength()) {
+            fRestartIndex = make_restart_index(static_cast<const uint8_t*>(data),
+                                               stream->getLength(), fDecoderMgr->dinfo(),
+                                               this->dimensions());
+        }
+    }
+    return fRestartIndex.get();
+}
+
+bool SkJpegCodec::decodeBandsInParallel(const SkImageInfo& dstInfo, void* dst,
+                                        size_t dstRowBytes, const Options& options) {
+    // Scaled decodes use a different MCU size; leave them to libjpeg-turbo.
+    if (!options.fExecutor || dstInfo.dimensions() != this->dimensions() ||
+        (int64_t)dstInfo.width() * dstInfo.height() < kMinParallelJpegPixels) {
+        return false;
+    }
+
+    const SkJpegRestartIndex* index = this->getRestartIndex();
+    std::vector<JpegBand> bands;
+    if (!index || !make_jpeg_bands(static_cast<const uint8_t*>(this->stream()->getMemoryBase()),
+                                   *index, kMaxJpegBands, &bands)) {
+        return false;
+    }
+
+    const skcms_ICCProfile* profile = this->getEncodedInfo().profile();
+    std::vector<uint8_t> succeeded(bands.size(), 0);
+    // We may be decoding on one of fExecutor's threads, so this must not wait on queued work.
+    SkTaskGroup::BatchAndJoin(*options.fExecutor, SkToInt(bands.size()), [&](int i) {
+        const JpegBand& band = bands[i];
+
+        // Passing our profile as the default keeps the band's color xform in sync with ours,
+        // even if we were created by SkRawCodec with a profile from the Exif data.
+        Result result;
+        std::unique_ptr<SkCodec> codec = SkJpegCodec::MakeFromStream(
+                SkMemoryStream::Make(band.fData), &result,
+                profile ? SkEncodedInfo::ICCProfile::Make(*profile) : nullptr);
+        if (!codec) {
+            return;
+        }
+
+        const SkImageInfo bandInfo =
+                dstInfo.makeWH(dstInfo.width(), band.fDecodeBottom - band.fDecodeTop);
+        Options bandOptions;
+        bandOptions.fZeroInitialized = options.fZeroInitialized;
+        if (kSuccess != codec->startScanlineDecode(bandInfo, &bandOptions)) {
+            return;
+        }
+
+        AutoTMalloc<uint8_t> discard(bandInfo.minRowBytes());
+        for (int y = band.fDecodeTop; y < band.fTop; ++y) {
+            if (1 != codec->getScanlines(discard.get(), 1, 0)) {
+                return;
+            }
+        }
+
+        const int rows = band.fBottom - band.fTop;
+        void* bandDst = SkTAddOffset<void>(dst, band.fTop * dstRowBytes);
+        succeeded[i] = rows == codec->getScanlines(bandDst, rows, dstRowBytes);
+    });
+
+    return std::all_of(succeeded.begin(), succeeded.end(), [](uint8_t ok) { return ok; });
+}
+
+bool SkJpegCodec::skipScanlinesWithRestartIndex(int count) {
+    // Scaled decodes use a different MCU size; leave them to libjpeg-turbo.
+    if (this->dstInfo().dimensions() != this->dimensions()) {
+        return false;
+    }
+    const SkJpegRestartIndex* index = this->getRestartIndex();
+    const jpeg_decompress_struct* currentInfo = fDecoderMgr->dinfo();
+    if (!index || currentInfo->output_scanline >= currentInfo->output_height) {
+        return false;
+    }
+
+    // Jump to the last entry that still leaves an MCU row of context above the target row (see
+    // JpegBand), if that is past the row we have already reached.
+    const int current = fDecoderTop + SkToInt(currentInfo->output_scanline);
+    const int target = current + count;
+    const int maxRowStart = target / index->fMcuHeight - 1;
+    const int entry = SkToInt(std::upper_bound(index->fRowStarts.begin(),
+                                               index->fRowStarts.end(), maxRowStart) -
+                              index->fRowStarts.begin()) - 1;
+    if (entry <= 0 || index->top(entry) <= current) {
+        return false;
+    }
+
+    const uint8_t* data = static_cast<const uint8_t*>(this->stream()->getMemoryBase());
+    std::unique_ptr<SkStream> stream =
+            SkMemoryStream::Make(make_restart_range(data, *index, entry, index->count()));
+    JpegDecoderMgr* decoderMgr = nullptr;
+    if (kSuccess != ReadHeader(stream.get(), nullptr, &decoderMgr, nullptr)) {
+        return false;
+    }
+    std::unique_ptr<JpegDecoderMgr> seekMgr(decoderMgr);
+
+    {
+        skjpeg_error_mgr::AutoPushJmpBuf jmp(seekMgr->errorMgr());
+        if (setjmp(jmp)) {
+            return seekMgr->returnFalse("skipScanlinesWithRestartIndex");
+        }
+
+        jpeg_decompress_struct* dinfo = seekMgr->dinfo();
+        dinfo->out_color_space = currentInfo->out_color_space;
+        dinfo->dither_mode = currentInfo->dither_mode;
+        if (!jpeg_start_decompress(dinfo)) {
+            return false;
+        }
+        if (fCropWidth > 0) {
+            uint32_t startX = fCropX;
+            uint32_t width = fCropWidth;
+            jpeg_crop_scanline(dinfo, &startX, &width);
+        }
+        if (dinfo->output_width != currentInfo->output_width) {
+            return false;
+        }
+
+        const uint32_t rowsToSkip = target - index->top(entry);
+        if (rowsToSkip != jpeg_skip_scanlines(dinfo, rowsToSkip)) {
+            return false;
+        }
+    }
+
+    // The old decoder may still be reading from fSeekStream, so replace it first.
+    fDecoderMgr = std::move(seekMgr);
+    fSeekStream = std::move(stream);
+    fDecoderTop = index->top(entry);
+    return true;
+}
+
 /*
  * Performs the jpeg decode
  */
@@ -626,6 +977,10 @@ SkCodec::Result SkJpegCodec::onGetPixels(const SkImageInfo& dstInfo,
         return kUnimplemented;
     }
 
+    if (options.fExecutor && this->decodeBandsInParallel(dstInfo, dst, dstRowBytes, options)) {
+        return kSuccess;
+    }
+
     // Get a pointer to the decompress info since we will use it quite frequently
     jpeg_decompress_struct* dinfo = fDecoderMgr->dinfo();
 
@@ -769,9 +1124,12 @@ SkCodec::Result SkJpegCodec::onStartScanlineDecode(const SkImageInfo& dstInfo,
     bool needsCMYKToRGB = needs_swizzler_to_convert_from_cmyk(
             fDecoderMgr->dinfo()->out_color_space, this->getEncodedInfo().profile(),
             this->colorXform());
+    fCropWidth = 0;
     if (options.fSubset) {
         uint32_t startX = options.fSubset->x();
         uint32_t width = options.fSubset->width();
+        fCropX = startX;
+        fCropWidth = width;
 
         // libjpeg-turbo may need to align startX to a multiple of the IDCT
         // block size.  If this is the case, it will decrease the value of
@@ -829,6 +1187,10 @@ int SkJpegCodec::onGetScanlines(void* dst, int count, size_t dstRowBytes) {
 }
 
 bool SkJpegCodec::onSkipScanlines(int count) {
+    if (this->skipScanlinesWithRestartIndex(count)) {
+        return true;
+    }
+
     // Set the jump location for libjpeg errors
     skjpeg_error_mgr::AutoPushJmpBuf jmp(fDecoderMgr->errorMgr());
     if (setjmp(jmp)) {
@@ -27,6 +27,7 @@ class SkSampler;
 class SkStream;
 class SkSwizzler;
 struct SkGainmapInfo;
+struct SkJpegRestartIndex;
 struct SkImageInfo;
 
 /*
@@ -131,6 +132,28 @@ private:
     bool SK_WARN_UNUSED_RESULT allocateStorage(const SkImageInfo& dstInfo);
     int readRows(const SkImageInfo& dstInfo, void* dst, size_t rowBytes, int count, const Options&);
 
+    /*
+     * If the image has restart markers that fall on MCU row boundaries, decodes bands of MCU rows
+     * in parallel on options.fExecutor, each with its own decompress struct.
+     * Returns false without touching fDecoderMgr if the image cannot be split or any band fails,
+     * in which case the caller should decode serially.
+     */
+    bool decodeBandsInParallel(const SkImageInfo& dstInfo, void* dst, size_t dstRowBytes,
+                               const Options& options);
+
+    /*
+     * Returns the restart markers that start MCU rows, scanning the stream's memory the first
+     * time this is called. Returns nullptr if there are none or the stream has no memory base.
+     */
+    const SkJpegRestartIndex* getRestartIndex();
+
+    /*
+     * Skips count scanlines by starting a new decompress struct at a restart marker close to the
+     * target row, rather than entropy decoding every skipped row. Returns false, leaving
+     * fDecoderMgr untouched, if there is no restart marker to jump to.
+     */
+    bool skipScanlinesWithRestartIndex(int count);
+
     /*
      * Scanline decoding.
      */
@@ -140,6 +163,11 @@ private:
     int onGetScanlines(void* dst, int count, size_t rowBytes) override;
     bool onSkipScanlines(int count) override;
 
+    // After skipScanlinesWithRestartIndex(), fDecoderMgr reads from this stream, whose first row
+    // is row fDecoderTop of the image. Declared first so that it outlives fDecoderMgr.
+    std::unique_ptr<SkStream>          fSeekStream;
+    int                                fDecoderTop = 0;
+
     std::unique_ptr<JpegDecoderMgr>    fDecoderMgr;
 
     // We will save the state of the decompress struct after reading the header.
@@ -158,6 +186,13 @@ private:
 
     std::unique_ptr<SkSwizzler>        fSwizzler;
 
+    // The horizontal crop requested from libjpeg-turbo, if fCropWidth is non-zero.
+    uint32_t                           fCropX = 0;
+    uint32_t                           fCropWidth = 0;
+
+    std::unique_ptr<SkJpegRestartIndex> fRestartIndex;
+    bool                               fRestartIndexBuilt = false;
+
     friend class SkRawCodec;
 
     using INHERITED = SkCodec;
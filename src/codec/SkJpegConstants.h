@@ -19,6 +19,17 @@ static constexpr uint8_t kJpegMarkerEndOfImage = 0xD9;
 // The header of a JPEG file is the data in all segments before the first StartOfScan.
 static constexpr uint8_t kJpegMarkerStartOfScan = 0xDA;
 
+// Baseline and extended sequential Huffman frames start with these markers.
+static constexpr uint8_t kJpegMarkerStartOfFrameBaseline = 0xC0;
+static constexpr uint8_t kJpegMarkerStartOfFrameExtended = 0xC1;
+
+// Entropy-coded data may be split by the restart markers RST0 through RST7, which reset the
+// decoder's state and are numbered modulo 8.
+static constexpr uint8_t kJpegMarkerRestart0 = 0xD0;
+
+// The DefineNumberOfLines marker can redefine the frame height after the first scan.
+static constexpr uint8_t kJpegMarkerDefineNumberOfLines = 0xDC;
+
 // Metadata and auxiliary images are stored in the APP1 through APP15 markers.
 static constexpr uint8_t kJpegMarkerAPP0 = 0xE0;
 
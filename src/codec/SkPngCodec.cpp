@@ -869,14 +869,8 @@ void AutoCleanPng::infoCallback(size_t idatLength) {
     SkEncodedInfo::Alpha alpha;
     switch (encodedColorType) {
         case PNG_COLOR_TYPE_PALETTE:
-            // Extract multiple pixels with bit depths of 1, 2, and 4 from a single
-            // byte into separate bytes (useful for paletted and grayscale images).
-            if (bitDepth < 8) {
-                // TODO: Should we use SkSwizzler here?
-                bitDepth = 8;
-                png_set_packing(fPng_ptr);
-            }
-
+            // Leave indices with bit depths of 1, 2, and 4 packed.  The swizzler unpacks
+            // them and looks up their colors in a single pass.
             color = SkEncodedInfo::kPalette_Color;
             // Set the alpha depending on if a transparency chunk exists.
             alpha = png_get_valid(fPng_ptr, fInfo_ptr, PNG_INFO_tRNS) ?
@@ -393,10 +393,13 @@ public:
             return nullptr;
         }
 
-        if (fStream->getMemoryBase()) {  // directly copy if getMemoryBase() is available.
-            sk_sp<SkData> data(SkData::MakeWithCopy(
-                static_cast<const uint8_t*>(fStream->getMemoryBase()) + offset, bytesToRead));
-            fStream.reset();
+        if (const void* base = fStream->getMemoryBase()) {
+            // Hand the stream's memory over without copying it. The data keeps the stream (and
+            // so its memory) alive, which is fine because transferBuffer() is destructive.
+            sk_sp<SkData> data(SkData::MakeWithProc(
+                static_cast<const uint8_t*>(base) + offset, bytesToRead,
+                [](const void*, void* stream) { delete static_cast<SkStream*>(stream); },
+                fStream.release()));
             return SkMemoryStream::Make(data);
         } else {
             sk_sp<SkData> data(SkData::MakeUninitialized(bytesToRead));
@@ -0,0 +1,171 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/codec/SkRowResampler.h"
+
+#include "include/core/SkColorType.h"
+#include "include/core/SkPixmap.h"
+#include "include/private/base/SkTemplates.h"
+#include "src/base/SkVx.h"
+#include "src/core/SkImageInfoPriv.h"
+
+#include <algorithm>
+#include <cmath>
+
+using ResampleFilter = SkAndroidCodec::ResampleFilter;
+
+// Mitchell-Netravali cubic with B = C = 1/3, which is nonzero on (-2, 2).
+static float mitchell(float x) {
+    constexpr float B = 1.0f / 3, C = 1.0f / 3;
+    x = std::fabs(x);
+    if (x < 1) {
+        return ((12 - 9*B - 6*C) * x*x*x + (-18 + 12*B + 6*C) * x*x + (6 - 2*B)) / 6;
+    }
+    if (x < 2) {
+        return ((-B - 6*C) * x*x*x + (6*B + 30*C) * x*x + (-12*B - 48*C) * x + (8*B + 24*C)) / 6;
+    }
+    return 0;
+}
+
+void SkRowResampler::ComputeContributions(int srcSize, int dstSize, ResampleFilter filter,
+                                          std::vector<Contribution>* contributions,
+                                          std::vector<float>* weights) {
+    SkASSERT(0 < dstSize && dstSize <= srcSize);
+    contributions->resize(dstSize);
+    weights->clear();
+
+    // Filtering an axis that is not being scaled would only blur it.
+    if (srcSize == dstSize) {
+        for (int d = 0; d < dstSize; d++) {
+            (*contributions)[d] = {d, 1, (int) weights->size()};
+            weights->push_back(1);
+        }
+        return;
+    }
+
+    const double scale = (double) srcSize / dstSize;
+    for (int d = 0; d < dstSize; d++) {
+        Contribution& c = (*contributions)[d];
+        c.fWeights = (int) weights->size();
+
+        double total = 0;
+        if (filter == ResampleFilter::kBox) {
+            // Weigh each source pixel by how much of it the destination pixel covers.
+            const double lo = d * scale,
+                         hi = (d + 1) * scale;
+            c.fFirst = (int) lo;
+            c.fCount = std::min(srcSize, (int) std::ceil(hi)) - c.fFirst;
+            for (int i = c.fFirst; i < c.fFirst + c.fCount; i++) {
+                const double w = std::min(hi, i + 1.0) - std::max(lo, (double) i);
+                weights->push_back((float) w);
+                total += w;
+            }
+        } else {
+            // Stretch the filter to cover the destination pixel's footprint.  Taps that fall
+            // off the edge are dropped, and the rest renormalized.
+            const double center = (d + 0.5) * scale,
+                         radius = 2 * scale;
+            c.fFirst = std::max(0, (int) std::floor(center - radius - 0.5));
+            c.fCount = std::min(srcSize - 1, (int) std::ceil(center + radius - 0.5)) - c.fFirst + 1;
+            for (int i = c.fFirst; i < c.fFirst + c.fCount; i++) {
+                const float w = mitchell((float) ((i + 0.5 - center) / scale));
+                weights->push_back(w);
+                total += w;
+            }
+        }
+
+        SkASSERT(total > 0);
+        for (int i = 0; i < c.fCount; i++) {
+            (*weights)[c.fWeights + i] = (float) ((*weights)[c.fWeights + i] / total);
+        }
+    }
+}
+
+SkRowResampler::SkRowResampler(int srcWidth, int srcHeight, const SkPixmap& dst,
+                               ResampleFilter filter)
+        : fSrcWidth(srcWidth)
+        , fSrcHeight(srcHeight)
+        , fDstWidth(dst.width())
+        , fDstInfo(dst.info())
+        , fDstPixels(dst.writable_addr())
+        , fDstRowBytes(dst.rowBytes()) {
+    SkASSERT(filter != ResampleFilter::kNone);
+    ComputeContributions(srcWidth,  dst.width(),  filter, &fX, &fXWeights);
+    ComputeContributions(srcHeight, dst.height(), filter, &fY, &fYWeights);
+
+    for (const Contribution& c : fY) {
+        fRingRows = std::max(fRingRows, c.fCount);
+    }
+    fRing  .resize((size_t) fRingRows * fDstWidth * 4);
+    fSrcRow.resize((size_t) fSrcWidth * 4);
+    fDstRow.resize((size_t) fDstWidth * 4);
+}
+
+void SkRowResampler::addRow(const SkPixmap& row) {
+    SkASSERT(row.width() == fSrcWidth);
+    SkASSERT(fSrcY < fSrcHeight);
+
+    const SkImageInfo floatInfo = SkImageInfo::Make(fSrcWidth, 1, kRGBA_F32_SkColorType,
+                                                    kPremul_SkAlphaType, fDstInfo.refColorSpace());
+    SkAssertResult(row.readPixels(floatInfo, fSrcRow.data(), floatInfo.minRowBytes(), 0, 0));
+
+    float* filtered = this->ringRow(fSrcY);
+    for (int x = 0; x < fDstWidth; x++) {
+        const Contribution& c = fX[x];
+        const float* weights = fXWeights.data() + c.fWeights;
+        const float* src = fSrcRow.data() + c.fFirst * 4;
+
+        skvx::float4 sum = 0;
+        for (int i = 0; i < c.fCount; i++) {
+            sum += weights[i] * skvx::float4::Load(src + i * 4);
+        }
+        sum.store(filtered + x * 4);
+    }
+    fSrcY++;
+
+    while (fDstY < (int) fY.size() && fY[fDstY].fFirst + fY[fDstY].fCount <= fSrcY) {
+        this->writeRow();
+    }
+}
+
+void SkRowResampler::writeRow() {
+    const Contribution& c = fY[fDstY];
+    const float* weights = fYWeights.data() + c.fWeights;
+    // Every row this needs is still in the ring, since it is written as soon as its last row
+    // arrives and the ring holds as many rows as any destination row needs.
+    SkASSERT(fSrcY - c.fFirst <= fRingRows);
+
+    std::fill(fDstRow.begin(), fDstRow.end(), 0.0f);
+    for (int i = 0; i < c.fCount; i++) {
+        const float* src = this->ringRow(c.fFirst + i);
+        for (int x = 0; x < fDstWidth * 4; x++) {
+            fDstRow[x] += weights[i] * src[x];
+        }
+    }
+
+    // Mitchell's negative lobes can ring past the valid range.  Keep the result premultiplied,
+    // leaving room for extended colors if the destination can hold them.
+    const bool normalized = SkColorTypeIsNormalized(fDstInfo.colorType());
+    for (int x = 0; x < fDstWidth; x++) {
+        skvx::float4 px = skvx::float4::Load(fDstRow.data() + x * 4);
+        const float a = std::min(std::max(px[3], 0.0f), 1.0f);
+        px = max(px, 0.0f);
+        if (normalized) {
+            px = min(px, a);
+        }
+        px[3] = a;
+        px.store(fDstRow.data() + x * 4);
+    }
+
+    const SkImageInfo floatInfo = SkImageInfo::Make(fDstWidth, 1, kRGBA_F32_SkColorType,
+                                                    kPremul_SkAlphaType, fDstInfo.refColorSpace());
+    const SkPixmap filtered(floatInfo, fDstRow.data(), floatInfo.minRowBytes());
+    SkAssertResult(filtered.readPixels(fDstInfo.makeWH(fDstWidth, 1),
+                                       SkTAddOffset<void>(fDstPixels, fDstY * fDstRowBytes),
+                                       fDstRowBytes, 0, 0));
+    fDstY++;
+}
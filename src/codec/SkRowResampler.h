@@ -0,0 +1,87 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+#ifndef SkRowResampler_DEFINED
+#define SkRowResampler_DEFINED
+
+#include "include/codec/SkAndroidCodec.h"
+#include "include/core/SkImageInfo.h"
+#include "include/private/base/SkNoncopyable.h"
+
+#include <cstddef>
+#include <vector>
+
+class SkPixmap;
+
+/**
+ *  Downscales an image that arrives one row at a time, top to bottom.
+ *
+ *  The filter is separable.  Each source row is filtered horizontally as soon as it is added,
+ *  and only the few filtered rows the vertical filter still needs are kept, so memory use is
+ *  proportional to the width of the image rather than its area.  Filtering happens on premul
+ *  floats, in the color space of the destination.
+ */
+class SkRowResampler : SkNoncopyable {
+public:
+    /**
+     *  @param srcWidth  Width of the rows that will be added.
+     *  @param srcHeight Number of rows that will be added.
+     *  @param dst       Destination, no larger than srcWidth x srcHeight.
+     *  @param filter    Any filter but ResampleFilter::kNone.
+     */
+    SkRowResampler(int srcWidth, int srcHeight, const SkPixmap& dst,
+                   SkAndroidCodec::ResampleFilter filter);
+
+    /**
+     *  Add the next source row, which must be srcWidth pixels wide and have the color space of
+     *  the destination.  Writes each destination row as soon as all of its source rows have
+     *  been added.
+     */
+    void addRow(const SkPixmap& row);
+
+    /**
+     *  Number of destination rows written so far.
+     */
+    int rowsWritten() const { return fDstY; }
+
+private:
+    // The source pixels, fCount of them starting at fFirst, that contribute to one destination
+    // pixel, and where their weights start in the weight array.
+    struct Contribution {
+        int fFirst;
+        int fCount;
+        int fWeights;
+    };
+
+    static void ComputeContributions(int srcSize, int dstSize,
+                                     SkAndroidCodec::ResampleFilter filter,
+                                     std::vector<Contribution>* contributions,
+                                     std::vector<float>* weights);
+
+    float* ringRow(int srcY) { return fRing.data() + (srcY % fRingRows) * fDstWidth * 4; }
+
+    void writeRow();
+
+    const int                 fSrcWidth;
+    const int                 fSrcHeight;
+    const int                 fDstWidth;
+    const SkImageInfo         fDstInfo;
+    void* const               fDstPixels;
+    const size_t              fDstRowBytes;
+
+    std::vector<Contribution> fX, fY;
+    std::vector<float>        fXWeights, fYWeights;
+
+    int                       fRingRows = 0;
+    std::vector<float>        fRing;     // fRingRows horizontally filtered rows.
+    std::vector<float>        fSrcRow;   // The latest source row, as premul floats.
+    std::vector<float>        fDstRow;   // The next destination row, as premul floats.
+
+    int                       fSrcY = 0;
+    int                       fDstY = 0;
+};
+
+#endif  // SkRowResampler_DEFINED
@@ -26,6 +26,7 @@
     #include "include/android/SkAndroidFrameworkUtils.h"
 #endif
 
+#include <algorithm>
 #include <cstring>
 
 static void copy(void* dst, const uint8_t* src, int width, int bpp, int deltaSrc, int offset,
@@ -240,8 +241,38 @@ static void swizzle_small_index_to_n32(
     }
 }
 
+static void fast_swizzle_small_index_to_n32(
+        void* dst, const uint8_t* src, int width, int bpp, int deltaSrc, int offset,
+        const SkPMColor ctable[]) {
+
+    // This function must not be called if we are sampling.  If we are not
+    // sampling, deltaSrc should equal bpp.
+    SkASSERT(deltaSrc == bpp);
+
+    // |offset| is in bits.  The optimized version starts at a byte boundary, so finish off
+    // any partial byte first.
+    int leading = 0;
+    if (offset % 8) {
+        leading = std::min(width, (8 - offset % 8) / bpp);
+        swizzle_small_index_to_n32(dst, src, leading, bpp, bpp, offset, ctable);
+    }
+    SkOpts::small_index_to_8888((uint32_t*) dst + leading, src + (offset + leading * bpp) / 8,
+                                width - leading, bpp, ctable);
+}
+
 // kIndex
 
+static void fast_swizzle_index_to_n32(
+        void* dst, const uint8_t* src, int width, int bpp, int deltaSrc, int offset,
+        const SkPMColor ctable[]) {
+
+    // This function must not be called if we are sampling.  If we are not
+    // sampling, deltaSrc should equal bpp.
+    SkASSERT(deltaSrc == bpp);
+
+    SkOpts::index_to_8888((uint32_t*) dst, src + offset, width, ctable);
+}
+
 static void swizzle_index_to_n32(
         void* SK_RESTRICT dstRow, const uint8_t* SK_RESTRICT src, int dstWidth,
         int bpp, int deltaSrc, int offset, const SkPMColor ctable[]) {
@@ -636,6 +667,76 @@ static void swizzle_rgba16_to_bgra_premul(
     }
 }
 
+static void fast_swizzle_rgb16_to_rgba(
+        void* dst, const uint8_t* src, int width, int bpp, int deltaSrc, int offset,
+        const SkPMColor ctable[]) {
+
+    // This function must not be called if we are sampling.  If we are not
+    // sampling, deltaSrc should equal bpp.
+    SkASSERT(deltaSrc == bpp);
+
+    SkOpts::RGB16_to_RGB1((uint32_t*) dst, src + offset, width);
+}
+
+static void fast_swizzle_rgb16_to_bgra(
+        void* dst, const uint8_t* src, int width, int bpp, int deltaSrc, int offset,
+        const SkPMColor ctable[]) {
+
+    // This function must not be called if we are sampling.  If we are not
+    // sampling, deltaSrc should equal bpp.
+    SkASSERT(deltaSrc == bpp);
+
+    SkOpts::RGB16_to_BGR1((uint32_t*) dst, src + offset, width);
+}
+
+static void fast_swizzle_rgba16_to_rgba_unpremul(
+        void* dst, const uint8_t* src, int width, int bpp, int deltaSrc, int offset,
+        const SkPMColor ctable[]) {
+
+    // This function must not be called if we are sampling.  If we are not
+    // sampling, deltaSrc should equal bpp.
+    SkASSERT(deltaSrc == bpp);
+
+    SkOpts::RGBA16_to_RGBA((uint32_t*) dst, src + offset, width);
+}
+
+static void fast_swizzle_rgba16_to_rgba_premul(
+        void* dst, const uint8_t* src, int width, int bpp, int deltaSrc, int offset,
+        const SkPMColor ctable[]) {
+
+    // This function must not be called if we are sampling.  If we are not
+    // sampling, deltaSrc should equal bpp.
+    SkASSERT(deltaSrc == bpp);
+
+    // Premultiply in place once the row is down to 8 bits.
+    SkOpts::RGBA16_to_RGBA((uint32_t*) dst, src + offset, width);
+    SkOpts::RGBA_to_rgbA((uint32_t*) dst, (const uint32_t*) dst, width);
+}
+
+static void fast_swizzle_rgba16_to_bgra_unpremul(
+        void* dst, const uint8_t* src, int width, int bpp, int deltaSrc, int offset,
+        const SkPMColor ctable[]) {
+
+    // This function must not be called if we are sampling.  If we are not
+    // sampling, deltaSrc should equal bpp.
+    SkASSERT(deltaSrc == bpp);
+
+    SkOpts::RGBA16_to_BGRA((uint32_t*) dst, src + offset, width);
+}
+
+static void fast_swizzle_rgba16_to_bgra_premul(
+        void* dst, const uint8_t* src, int width, int bpp, int deltaSrc, int offset,
+        const SkPMColor ctable[]) {
+
+    // This function must not be called if we are sampling.  If we are not
+    // sampling, deltaSrc should equal bpp.
+    SkASSERT(deltaSrc == bpp);
+
+    // Premultiply in place once the row is down to 8 bits (and already swapped).
+    SkOpts::RGBA16_to_BGRA((uint32_t*) dst, src + offset, width);
+    SkOpts::RGBA_to_rgbA((uint32_t*) dst, (const uint32_t*) dst, width);
+}
+
 // kCMYK
 //
 // CMYK is stored as four bytes per pixel.
@@ -751,6 +852,15 @@ static void swizzle_cmyk_to_565(
     }
 }
 
+template <int kBPP>
+static void gather_samples(uint8_t* dst, const uint8_t* src, int width, int deltaSrc) {
+    for (int x = 0; x < width; x++) {
+        memcpy(dst, src, kBPP);
+        dst += kBPP;
+        src += deltaSrc;
+    }
+}
+
 template <SkSwizzler::RowProc proc>
 void SkSwizzler::SkipLeadingGrayAlphaZerosThen(
         void* dst, const uint8_t* src, int width,
@@ -922,6 +1032,7 @@ std::unique_ptr<SkSwizzler> SkSwizzler::Make(const SkEncodedInfo& encodedInfo,
                         case kRGBA_8888_SkColorType:
                         case kBGRA_8888_SkColorType:
                             proc = &swizzle_small_index_to_n32;
+                            fastProc = &fast_swizzle_small_index_to_n32;
                             break;
                         case kRGB_565_SkColorType:
                             proc = &swizzle_small_index_to_565;
@@ -938,6 +1049,7 @@ std::unique_ptr<SkSwizzler> SkSwizzler::Make(const SkEncodedInfo& encodedInfo,
                                 proc = &swizzle_index_to_n32_skipZ;
                             } else {
                                 proc = &swizzle_index_to_n32;
+                                fastProc = &fast_swizzle_index_to_n32;
                             }
                             break;
                         case kRGB_565_SkColorType:
@@ -960,6 +1072,7 @@ std::unique_ptr<SkSwizzler> SkSwizzler::Make(const SkEncodedInfo& encodedInfo,
                 case kRGBA_8888_SkColorType:
                     if (16 == encodedInfo.bitsPerComponent()) {
                         proc = &swizzle_rgb16_to_rgba;
+                        fastProc = &fast_swizzle_rgb16_to_rgba;
                         break;
                     }
 
@@ -970,6 +1083,7 @@ std::unique_ptr<SkSwizzler> SkSwizzler::Make(const SkEncodedInfo& encodedInfo,
                 case kBGRA_8888_SkColorType:
                     if (16 == encodedInfo.bitsPerComponent()) {
                         proc = &swizzle_rgb16_to_bgra;
+                        fastProc = &fast_swizzle_rgb16_to_bgra;
                         break;
                     }
 
@@ -995,6 +1109,8 @@ std::unique_ptr<SkSwizzler> SkSwizzler::Make(const SkEncodedInfo& encodedInfo,
                     if (16 == encodedInfo.bitsPerComponent()) {
                         proc = premultiply ? &swizzle_rgba16_to_rgba_premul :
                                              &swizzle_rgba16_to_rgba_unpremul;
+                        fastProc = premultiply ? &fast_swizzle_rgba16_to_rgba_premul :
+                                                 &fast_swizzle_rgba16_to_rgba_unpremul;
                         break;
                     }
 
@@ -1022,6 +1138,8 @@ std::unique_ptr<SkSwizzler> SkSwizzler::Make(const SkEncodedInfo& encodedInfo,
                     if (16 == encodedInfo.bitsPerComponent()) {
                         proc = premultiply ? &swizzle_rgba16_to_bgra_premul :
                                              &swizzle_rgba16_to_bgra_unpremul;
+                        fastProc = premultiply ? &fast_swizzle_rgba16_to_bgra_premul :
+                                                 &fast_swizzle_rgba16_to_bgra_unpremul;
                         break;
                     }
 
@@ -1231,13 +1349,31 @@ int SkSwizzler::onSetSampleX(int sampleX) {
         }
     }
 
-    // The optimized swizzler functions do not support sampling.  Sampled swizzles
-    // are already fast because they skip pixels.  We haven't seen a situation
-    // where speeding up sampling has a significant impact on total decode time.
-    if (1 == fSampleX && fFastProc) {
-        fActualProc = fFastProc;
-    } else {
-        fActualProc = fSlowProc;
+    // The optimized swizzler functions do not support sampling.  Rather than falling back
+    // to the per-pixel procs, gather the sampled pixels into a contiguous row and run the
+    // optimized function over that.  This pays off for everything but plain copies, which
+    // the sampling procs already do as cheaply as the gather would.
+    fGatherProc = nullptr;
+    fActualProc = fFastProc ? fFastProc : fSlowProc;
+    if (1 != fSampleX && fFastProc) {
+        // Sub-byte indices count fSrcBPP in bits, which the gather cannot step by.
+        if (fFastProc != &copy && fFastProc != &SkipLeading8888ZerosThen<copy> &&
+            fFastProc != &fast_swizzle_small_index_to_n32) {
+            switch (fSrcBPP) {
+                case 1: fGatherProc = &gather_samples<1>; break;
+                case 2: fGatherProc = &gather_samples<2>; break;
+                case 3: fGatherProc = &gather_samples<3>; break;
+                case 4: fGatherProc = &gather_samples<4>; break;
+                case 6: fGatherProc = &gather_samples<6>; break;
+                case 8: fGatherProc = &gather_samples<8>; break;
+                default: break;
+            }
+        }
+        if (fGatherProc) {
+            fSampledRow.reset(fSwizzleWidth * fSrcBPP);
+        } else {
+            fActualProc = fSlowProc;
+        }
     }
 
     return fAllocatedWidth;
@@ -1245,6 +1381,12 @@ int SkSwizzler::onSetSampleX(int sampleX) {
 
 void SkSwizzler::swizzle(void* dst, const uint8_t* SK_RESTRICT src) {
     SkASSERT(nullptr != dst && nullptr != src);
+    if (fGatherProc) {
+        fGatherProc(fSampledRow.get(), src + fSrcOffsetUnits, fSwizzleWidth, fSampleX * fSrcBPP);
+        fActualProc(SkTAddOffset<void>(dst, fDstOffsetBytes), fSampledRow.get(), fSwizzleWidth,
+                fSrcBPP, fSrcBPP, 0, fColorTable);
+        return;
+    }
     fActualProc(SkTAddOffset<void>(dst, fDstOffsetBytes), src, fSwizzleWidth, fSrcBPP,
             fSampleX * fSrcBPP, fSrcOffsetUnits, fColorTable);
 }
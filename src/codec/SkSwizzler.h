@@ -11,6 +11,7 @@
 #include "include/codec/SkCodec.h"
 #include "include/core/SkColor.h"
 #include "include/core/SkTypes.h"
+#include "include/private/base/SkTemplates.h"
 #include "src/codec/SkSampler.h"
 
 #include <cstddef>
@@ -132,6 +133,12 @@ private:
     // whether or not we are sampling.
     RowProc             fActualProc;
 
+    // When sampling with fFastProc, the sampled source pixels are first gathered into
+    // fSampledRow so that fFastProc can convert them as a contiguous row.
+    typedef void (*GatherProc)(uint8_t* dst, const uint8_t* src, int width, int deltaSrc);
+    GatherProc                          fGatherProc = nullptr;
+    skia_private::AutoTMalloc<uint8_t>  fSampledRow;
+
     const SkPMColor*    fColorTable;      // Unowned pointer
 
     // Subset Swizzles
@@ -79,7 +79,26 @@
 #define SK_WUFFS_INITIALIZE_FLAGS WUFFS_INITIALIZE__DEFAULT_OPTIONS
 #endif
 
+// If the stream is backed by memory, point the io_buffer at that memory instead of copying the
+// stream through a buffer. The io_buffer then holds the whole stream and is closed, so
+// fill_buffer has nothing left to read and seek_buffer only moves the read index.
+static bool use_memory_base(wuffs_base__io_buffer* b, SkStream* s) {
+    const void* base = s->getMemoryBase();
+    if (!base || !s->hasLength() || !s->hasPosition()) {
+        return false;
+    }
+    // Wuffs never writes to the buffer it reads from, and neither does fill_buffer once the
+    // buffer is closed.
+    b->data = wuffs_base__make_slice_u8(const_cast<uint8_t*>(static_cast<const uint8_t*>(base)),
+                                        s->getLength());
+    b->meta = wuffs_base__make_io_buffer_meta(s->getLength(), s->getPosition(), 0, true);
+    return true;
+}
+
 static bool fill_buffer(wuffs_base__io_buffer* b, SkStream* s) {
+    if (b->meta.closed) {
+        return false;
+    }
     b->compact();
     size_t num_read = s->read(b->data.ptr + b->meta.wi, b->data.len - b->meta.wi);
     b->meta.wi += num_read;
@@ -387,6 +406,11 @@ SkWuffsCodec::SkWuffsCodec(SkEncodedInfo&&
     // Initialize fIOBuffer's fields, copying any outstanding data from iobuf to
     // fIOBuffer, as iobuf's backing array may not be valid for the lifetime of
     // this SkWuffsCodec object, but fIOBuffer's backing array (fBuffer) is.
+    // If iobuf reads straight from fStream's memory, that stays valid as long as fStream does.
+    if (iobuf.data.ptr == fStream->getMemoryBase()) {
+        fIOBuffer = iobuf;
+        return;
+    }
     SkASSERT(iobuf.data.len == SK_WUFFS_CODEC_BUFFER_SIZE);
     memmove(fBuffer, iobuf.data.ptr, iobuf.meta.wi);
     fIOBuffer.data = wuffs_base__make_slice_u8(fBuffer, SK_WUFFS_CODEC_BUFFER_SIZE);
@@ -874,7 +898,10 @@ SkCodec::Result SkWuffsCodec::resetDecoder() {
     if (!fStream->rewind()) {
         return SkCodec::kInternalError;
     }
-    fIOBuffer.meta = wuffs_base__empty_io_buffer_meta();
+    if (!use_memory_base(&fIOBuffer, fStream.get())) {
+        fIOBuffer.data = wuffs_base__make_slice_u8(fBuffer, SK_WUFFS_CODEC_BUFFER_SIZE);
+        fIOBuffer.meta = wuffs_base__empty_io_buffer_meta();
+    }
 
     SkCodec::Result result =
         reset_and_decode_image_config(fDecoder.get(), nullptr, &fIOBuffer, fStream.get());
@@ -948,6 +975,7 @@ std::unique_ptr<SkCodec> SkWuffsCodec_MakeFromStream(std::unique_ptr<SkStream> s
     wuffs_base__io_buffer iobuf =
         wuffs_base__make_io_buffer(wuffs_base__make_slice_u8(buffer, SK_WUFFS_CODEC_BUFFER_SIZE),
                                    wuffs_base__empty_io_buffer_meta());
+    use_memory_base(&iobuf, stream.get());
     wuffs_base__image_config imgcfg = wuffs_base__null_image_config();
 
     // Wuffs is primarily a C library, not a C++ one. Furthermore, outside of
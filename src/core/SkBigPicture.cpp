@@ -38,6 +38,30 @@ void SkBigPicture::playback(SkCanvas* canvas, AbortCallback* callback) const {
                  callback);
 }
 
+int SkBigPicture::playbackWithOcclusion(SkCanvas* canvas, AbortCallback* callback) const {
+    SkASSERT(canvas);
+    TRACE_EVENT0("skia", TRACE_FUNC);
+
+    fOpBoundsOnce([this] {
+        fOpBounds.reset(fRecord->count());
+        fOpOpaque.reset(fRecord->count());
+        skia_private::AutoTMalloc<SkBBoxHierarchy::Metadata> meta(fRecord->count());
+        SkRecordFillBounds(fCullRect, *fRecord, fOpBounds.get(), meta.get(), fOpOpaque.get());
+    });
+
+    const bool useBBH = !canvas->getLocalClipBounds().contains(this->cullRect());
+
+    return SkRecordDrawWithOcclusion(*fRecord,
+                                     canvas,
+                                     this->drawablePicts(),
+                                     nullptr,
+                                     this->drawableCount(),
+                                     fOpBounds.get(),
+                                     fOpOpaque.get(),
+                                     useBBH ? fBBH.get() : nullptr,
+                                     callback);
+}
+
 void SkBigPicture::partialPlayback(SkCanvas* canvas,
                                    int start,
                                    int stop,
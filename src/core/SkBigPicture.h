@@ -51,6 +51,10 @@ public:
     size_t approximateBytesUsed() const override;
     const SkBigPicture* asSkBigPicture() const override { return this; }
 
+    // Like playback(), but skips ops completely hidden by later opaque draws.
+    // Returns how many ops were skipped.
+    int playbackWithOcclusion(SkCanvas*, AbortCallback* = nullptr) const;
+
 // Used by GrLayerHoister
     void partialPlayback(SkCanvas*,
                          int start,
@@ -69,6 +73,11 @@ private:
     sk_sp<const SkRecord>                fRecord;
     std::unique_ptr<const SnapshotArray> fDrawablePicts;
     sk_sp<const SkBBoxHierarchy>         fBBH;
+
+    // Per-op bounds and opacity for playbackWithOcclusion(), computed on first use.
+    mutable SkOnce                             fOpBoundsOnce;
+    mutable skia_private::AutoTMalloc<SkRect>  fOpBounds;
+    mutable skia_private::AutoTMalloc<bool>    fOpOpaque;
 };
 
 #endif//SkBigPicture_DEFINED
@@ -307,6 +307,19 @@ void SkBlitter::blitRegion(const SkRegion& clip) {
     });
 }
 
+void SkBlitter::blitAntiHRow(int x, int y, const SkAlpha antialias[], int width) {
+    SkASSERT(width > 0);
+    SkIRect clip = {x, y, x + width, y + 1};
+
+    SkMask mask;
+    mask.fImage    = const_cast<SkAlpha*>(antialias);
+    mask.fBounds   = clip;
+    mask.fRowBytes = width;
+    mask.fFormat   = SkMask::kA8_Format;
+
+    this->blitMask(mask, clip);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 void SkNullBlitter::blitH(int x, int y, int width) {}
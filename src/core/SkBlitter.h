@@ -137,6 +137,11 @@ public:
 #endif
     void blitRectRegion(const SkIRect& rect, const SkRegion& clip);
     void blitRegion(const SkRegion& clip);
+
+    /// Blit width pixels starting at (x, y), each with its own alpha from antialias[]. This is
+    /// blitAntiH() with every run one pixel long, passed on as a one-row A8 mask so that blitters
+    /// with a fast blitMask() cover the whole row at once.
+    void blitAntiHRow(int x, int y, const SkAlpha antialias[], int width);
     ///@}
 
     /** @name Factories
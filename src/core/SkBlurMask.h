@@ -13,6 +13,8 @@
 #include "include/core/SkShader.h"
 #include "src/core/SkMask.h"
 
+class SkExecutor;
+
 class SkBlurMask {
 public:
     static bool SK_WARN_UNUSED_RESULT BlurRect(SkScalar sigma, SkMask *dst, const SkRect &src,
@@ -34,10 +36,12 @@ public:
     // * calculate margin - if src.fImage is null, then this call only calculates the border.
     // * failure          - if src.fImage is not null, failure is signal with dst->fImage being
     //                      null.
+    // * executor         - if not null, large blurs are split into bands of rows on it.
 
     static bool SK_WARN_UNUSED_RESULT BoxBlur(SkMask* dst, const SkMask& src,
                                               SkScalar sigma, SkBlurStyle style,
-                                              SkIPoint* margin = nullptr);
+                                              SkIPoint* margin = nullptr,
+                                              SkExecutor* executor = nullptr);
 
     // the "ground truth" blur does a gaussian convolution; it's slow
     // but useful for comparison purposes.
@@ -71,6 +71,10 @@ public:
         return canvas->topDevice();
     }
 
+    static bool IsClipAA(const SkCanvas* canvas) {
+        return canvas->androidFramework_isClipAA();
+    }
+
 #if GR_TEST_UTILS && defined(SK_GANESH)
     static skgpu::v1::SurfaceDrawContext* TopDeviceSurfaceDrawContext(SkCanvas*);
     static skgpu::v1::SurfaceFillContext* TopDeviceSurfaceFillContext(SkCanvas*);
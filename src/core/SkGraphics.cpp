@@ -22,11 +22,14 @@
 #include "src/core/SkCpu.h"
 #include "src/core/SkGeometry.h"
 #include "src/core/SkImageFilter_Base.h"
+#include "src/core/SkMaskBlurFilter.h"
 #include "src/core/SkOpts.h"
 #include "src/core/SkResourceCache.h"
 #include "src/core/SkScalerContext.h"
+#include "src/core/SkScan.h"
 #include "src/core/SkStrikeCache.h"
 #include "src/core/SkTypefaceCache.h"
+#include "src/core/SkVMBlitter.h"
 
 #include <stdlib.h>
 
@@ -47,6 +50,7 @@ void SkGraphics::PurgeAllCaches() {
     SkGraphics::PurgeFontCache();
     SkGraphics::PurgeResourceCache();
     SkImageFilter_Base::PurgeCache();
+    SkVMBlitter::PurgeProgramCache();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -144,3 +148,15 @@ extern bool gSkVMAllowJIT;
 void SkGraphics::AllowJIT() {
     gSkVMAllowJIT = true;
 }
+
+void SkGraphics::SetJITProgramCache(PersistentCache* cache) {
+    SkVMBlitter::SetPersistentCache(cache);
+}
+
+void SkGraphics::SetPathFillExecutor(SkExecutor* executor) {
+    gSkAntiFillPathExecutor = executor;
+}
+
+void SkGraphics::SetBlurExecutor(SkExecutor* executor) {
+    gSkBlurExecutor = executor;
+}
@@ -15,10 +15,18 @@
 #include "include/private/base/SkTo.h"
 #include "src/base/SkArenaAlloc.h"
 #include "src/core/SkGaussFilter.h"
+#include "src/core/SkTaskGroup.h"
 
 #include <cmath>
 #include <climits>
 
+std::atomic<SkExecutor*> gSkBlurExecutor{nullptr};
+
+// Blurs with at least this many pixels in their intermediate buffer are split into bands
+// when blur() is given an executor.
+static constexpr int64_t kMinParallelBlurPixels = 256 * 256;
+static constexpr int     kMaxBlurBands = 32;
+
 namespace {
 static const double kPi = 3.14159265358979323846264338327950288;
 
@@ -952,7 +960,7 @@ static SkIPoint small_blur(double sigmaX, double sigmaY, const SkMask& src, SkMa
 
 // TODO: assuming sigmaW = sigmaH. Allow different sigmas. Right now the
 // API forces the sigmas to be the same.
-SkIPoint SkMaskBlurFilter::blur(const SkMask& src, SkMask* dst) const {
+SkIPoint SkMaskBlurFilter::blur(const SkMask& src, SkMask* dst, SkExecutor* executor) const {
 
     if (fSigmaW < 2.0 && fSigmaH < 2.0) {
         return small_blur(fSigmaW, fSigmaH, src, dst);
@@ -983,9 +991,6 @@ SkIPoint SkMaskBlurFilter::blur(const SkMask& src, SkMask* dst) const {
         dstH = dst->fBounds.height();
     SkASSERT(srcW >= 0 && srcH >= 0 && dstW >= 0 && dstH >= 0);
 
-    auto bufferSize = std::max(planW.bufferSize(), planH.bufferSize());
-    auto buffer = alloc.makeArrayDefault<uint32_t>(bufferSize);
-
     // Blur both directions.
     int tmpW = srcH,
         tmpH = dstW;
@@ -996,59 +1001,73 @@ SkIPoint SkMaskBlurFilter::blur(const SkMask& src, SkMask* dst) const {
     }
     auto tmp = alloc.makeArrayDefault<uint8_t>(tmpW * tmpH);
 
+    // Every row of each pass is blurred independently, so a large blur can split each pass into
+    // bands of rows, each with its own scan buffer. The output is identical either way.
+    int bands = 1;
+    if (executor && (int64_t)tmpW * tmpH >= kMinParallelBlurPixels) {
+        bands = std::max(1, std::min({kMaxBlurBands, srcH, tmpH}));
+    }
+    auto bufferSize = std::max(planW.bufferSize(), planH.bufferSize());
+    auto buffers = alloc.makeArrayDefault<uint32_t>(bufferSize * bands);
+
+    auto forEachBand = [&](int rows, auto&& blurRows) {
+        if (bands == 1) {
+            blurRows(buffers, 0, rows);
+        } else {
+            // We may be blurring on one of the executor's threads, so we must not wait on it.
+            SkTaskGroup::BatchAndJoin(*executor, bands, [&](int band) {
+                blurRows(buffers + band * bufferSize, rows * band / bands,
+                                                      rows * (band + 1) / bands);
+            });
+        }
+    };
+
     // Blur horizontally, and transpose.
-    const PlanGauss::Scan& scanW = planW.makeBlurScan(srcW, buffer);
-    switch (src.fFormat) {
-        case SkMask::kBW_Format: {
-            const uint8_t* bwStart = src.fImage;
-            auto start = SkMask::AlphaIter<SkMask::kBW_Format>(bwStart, 0);
-            auto end = SkMask::AlphaIter<SkMask::kBW_Format>(bwStart + (srcW / 8), srcW % 8);
-            for (int y = 0; y < srcH; ++y, start >>= src.fRowBytes, end >>= src.fRowBytes) {
-                auto tmpStart = &tmp[y];
-                scanW.blur(start, end, tmpStart, tmpW, tmpStart + tmpW * tmpH);
-            }
-        } break;
-        case SkMask::kA8_Format: {
-            const uint8_t* a8Start = src.fImage;
-            auto start = SkMask::AlphaIter<SkMask::kA8_Format>(a8Start);
-            auto end = SkMask::AlphaIter<SkMask::kA8_Format>(a8Start + srcW);
-            for (int y = 0; y < srcH; ++y, start >>= src.fRowBytes, end >>= src.fRowBytes) {
+    forEachBand(srcH, [&](uint32_t* buffer, int y0, int y1) {
+        const PlanGauss::Scan& scanW = planW.makeBlurScan(srcW, buffer);
+        auto blurRows = [&](auto start, auto end) {
+            for (int y = y0; y < y1; ++y, start >>= src.fRowBytes, end >>= src.fRowBytes) {
                 auto tmpStart = &tmp[y];
                 scanW.blur(start, end, tmpStart, tmpW, tmpStart + tmpW * tmpH);
             }
-        } break;
-        case SkMask::kARGB32_Format: {
-            const uint32_t* argbStart = reinterpret_cast<const uint32_t*>(src.fImage);
-            auto start = SkMask::AlphaIter<SkMask::kARGB32_Format>(argbStart);
-            auto end = SkMask::AlphaIter<SkMask::kARGB32_Format>(argbStart + srcW);
-            for (int y = 0; y < srcH; ++y, start >>= src.fRowBytes, end >>= src.fRowBytes) {
-                auto tmpStart = &tmp[y];
-                scanW.blur(start, end, tmpStart, tmpW, tmpStart + tmpW * tmpH);
-            }
-        } break;
-        case SkMask::kLCD16_Format: {
-            const uint16_t* lcdStart = reinterpret_cast<const uint16_t*>(src.fImage);
-            auto start = SkMask::AlphaIter<SkMask::kLCD16_Format>(lcdStart);
-            auto end = SkMask::AlphaIter<SkMask::kLCD16_Format>(lcdStart + srcW);
-            for (int y = 0; y < srcH; ++y, start >>= src.fRowBytes, end >>= src.fRowBytes) {
-                auto tmpStart = &tmp[y];
-                scanW.blur(start, end, tmpStart, tmpW, tmpStart + tmpW * tmpH);
-            }
-        } break;
-        default:
-            SK_ABORT("Unhandled format.");
-    }
+        };
+        const uint8_t* row = src.fImage + (size_t)y0 * src.fRowBytes;
+        switch (src.fFormat) {
+            case SkMask::kBW_Format: {
+                blurRows(SkMask::AlphaIter<SkMask::kBW_Format>(row, 0),
+                         SkMask::AlphaIter<SkMask::kBW_Format>(row + (srcW / 8), srcW % 8));
+            } break;
+            case SkMask::kA8_Format: {
+                blurRows(SkMask::AlphaIter<SkMask::kA8_Format>(row),
+                         SkMask::AlphaIter<SkMask::kA8_Format>(row + srcW));
+            } break;
+            case SkMask::kARGB32_Format: {
+                const uint32_t* argbStart = reinterpret_cast<const uint32_t*>(row);
+                blurRows(SkMask::AlphaIter<SkMask::kARGB32_Format>(argbStart),
+                         SkMask::AlphaIter<SkMask::kARGB32_Format>(argbStart + srcW));
+            } break;
+            case SkMask::kLCD16_Format: {
+                const uint16_t* lcdStart = reinterpret_cast<const uint16_t*>(row);
+                blurRows(SkMask::AlphaIter<SkMask::kLCD16_Format>(lcdStart),
+                         SkMask::AlphaIter<SkMask::kLCD16_Format>(lcdStart + srcW));
+            } break;
+            default:
+                SK_ABORT("Unhandled format.");
+        }
+    });
 
     // Blur vertically (scan in memory order because of the transposition),
     // and transpose back to the original orientation.
-    const PlanGauss::Scan& scanH = planH.makeBlurScan(tmpW, buffer);
-    for (int y = 0; y < tmpH; y++) {
-        auto tmpStart = &tmp[y * tmpW];
-        auto dstStart = &dst->fImage[y];
-
-        scanH.blur(tmpStart, tmpStart + tmpW,
-                   dstStart, dst->fRowBytes, dstStart + dst->fRowBytes * dstH);
-    }
+    forEachBand(tmpH, [&](uint32_t* buffer, int y0, int y1) {
+        const PlanGauss::Scan& scanH = planH.makeBlurScan(tmpW, buffer);
+        for (int y = y0; y < y1; y++) {
+            auto tmpStart = &tmp[y * tmpW];
+            auto dstStart = &dst->fImage[y];
+
+            scanH.blur(tmpStart, tmpStart + tmpW,
+                       dstStart, dst->fRowBytes, dstStart + dst->fRowBytes * dstH);
+        }
+    });
 
     return {SkTo<int32_t>(borderW), SkTo<int32_t>(borderH)};
 }
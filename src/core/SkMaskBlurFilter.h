@@ -15,6 +15,14 @@
 #include "include/core/SkTypes.h"
 #include "src/core/SkMask.h"
 
+#include <atomic>
+
+class SkExecutor;
+
+// If set, large CPU blurs are split into bands of rows on this executor.
+// See SkGraphics::SetBlurExecutor().
+extern std::atomic<SkExecutor*> gSkBlurExecutor;
+
 // Implement a single channel Gaussian blur. The specifics for implementation are taken from:
 // https://drafts.fxtf.org/filters/#feGaussianBlurElement
 class SkMaskBlurFilter {
@@ -27,7 +35,9 @@ public:
     bool hasNoBlur() const;
 
     // Given a src SkMask, generate dst SkMask returning the border width and height.
-    SkIPoint blur(const SkMask& src, SkMask* dst) const;
+    // With an executor, large blurs run each pass as bands of rows in parallel, on the executor
+    // and the calling thread.
+    SkIPoint blur(const SkMask& src, SkMask* dst, SkExecutor* = nullptr) const;
 
 private:
     const double fSigmaW;
@@ -15,6 +15,7 @@
 #include "src/core/SkImageInfoPriv.h"
 #include "src/core/SkMipmap.h"
 #include "src/core/SkMipmapBuilder.h"
+#include "src/core/SkTaskGroup.h"
 #include <new>
 
 //
@@ -169,7 +170,7 @@ template <typename T> T shift_right(const T& x, int bits) {
     return x >> bits;
 }
 
-skvx::float4 shift_right(const skvx::float4& x, int bits) {
+template <int N> skvx::Vec<N, float> shift_right(const skvx::Vec<N, float>& x, int bits) {
     return x * (1.0f / (1 << bits));
 }
 
@@ -177,7 +178,7 @@ template <typename T> T shift_left(const T& x, int bits) {
     return x << bits;
 }
 
-skvx::float4 shift_left(const skvx::float4& x, int bits) {
+template <int N> skvx::Vec<N, float> shift_left(const skvx::Vec<N, float>& x, int bits) {
     return x * (1 << bits);
 }
 
@@ -381,6 +382,150 @@ template <typename F> void downsample_3_3(void* dst, const void* src, size_t src
     }
 }
 
+// Wider versions of downsample_2_2 and downsample_3_3 for the most common color types.  These
+// filter four dst pixels at a time, and hand any remainder to the one-pixel-at-a-time procs.
+// They do the same math in the same order as those procs, so produce the same results.
+
+static skvx::Vec<16, uint16_t> expand_8888_x4(const skvx::Vec<4, uint32_t>& px) {
+    return skvx::cast<uint16_t>(skvx::bit_pun<skvx::Vec<16, uint8_t>>(px));
+}
+
+// F16 pixels still convert to and from float one at a time, as in ColorTypeFilter_RGBA_F16,
+// because the wider half<->float conversions may round differently (e.g. with F16C).
+static skvx::Vec<16, float> expand_F16_x4(const skvx::Vec<4, uint64_t>& px) {
+    using F = ColorTypeFilter_RGBA_F16;
+    return skvx::join(skvx::join(F::Expand(px[0]), F::Expand(px[1])),
+                      skvx::join(F::Expand(px[2]), F::Expand(px[3])));
+}
+
+static void compact_F16_x4(const skvx::Vec<16, float>& c, uint64_t* d) {
+    using F = ColorTypeFilter_RGBA_F16;
+    d[0] = F::Compact(c.lo.lo);
+    d[1] = F::Compact(c.lo.hi);
+    d[2] = F::Compact(c.hi.lo);
+    d[3] = F::Compact(c.hi.hi);
+}
+
+static void downsample_2_2_8888(void* dst, const void* src, size_t srcRB, int count) {
+    SkASSERT(count > 0);
+    auto p0 = static_cast<const uint32_t*>(src);
+    auto p1 = (const uint32_t*)((const char*)p0 + srcRB);
+    auto d = static_cast<uint32_t*>(dst);
+
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        auto r0 = skvx::Vec<8, uint32_t>::Load(p0 + 2*i),
+             r1 = skvx::Vec<8, uint32_t>::Load(p1 + 2*i);
+
+        auto c00 = expand_8888_x4(skvx::shuffle<0,2,4,6>(r0));
+        auto c01 = expand_8888_x4(skvx::shuffle<1,3,5,7>(r0));
+        auto c10 = expand_8888_x4(skvx::shuffle<0,2,4,6>(r1));
+        auto c11 = expand_8888_x4(skvx::shuffle<1,3,5,7>(r1));
+
+        auto c = c00 + c10 + c01 + c11;
+        skvx::cast<uint8_t>(shift_right(c, 2)).store(d + i);
+    }
+    if (i < count) {
+        downsample_2_2<ColorTypeFilter_8888>(d + i, p0 + 2*i, srcRB, count - i);
+    }
+}
+
+static void downsample_3_3_8888(void* dst, const void* src, size_t srcRB, int count) {
+    SkASSERT(count > 0);
+    auto p0 = static_cast<const uint32_t*>(src);
+    auto p1 = (const uint32_t*)((const char*)p0 + srcRB);
+    auto p2 = (const uint32_t*)((const char*)p1 + srcRB);
+    auto d = static_cast<uint32_t*>(dst);
+
+    // As in downsample_3_3(), dst pixel i is made from src columns a=2i, b=2i+1, and c=2i+2.
+    auto columns = [](const uint32_t* p, int i, skvx::Vec<4, uint32_t>* a,
+                                                skvx::Vec<4, uint32_t>* b,
+                                                skvx::Vec<4, uint32_t>* c) {
+        auto r = skvx::Vec<8, uint32_t>::Load(p + 2*i);
+        *a = skvx::shuffle<0,2,4,6>(r);
+        *b = skvx::shuffle<1,3,5,7>(r);
+        *c = skvx::shuffle<1,2,3,4>(skvx::join(*a, skvx::Vec<4, uint32_t>(p[2*i + 8])));
+    };
+
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        skvx::Vec<4, uint32_t> a0, b0, c0, a1, b1, c1, a2, b2, c2;
+        columns(p0, i, &a0, &b0, &c0);
+        columns(p1, i, &a1, &b1, &c1);
+        columns(p2, i, &a2, &b2, &c2);
+
+        auto a = add_121(expand_8888_x4(a0), expand_8888_x4(a1), expand_8888_x4(a2));
+        auto b = shift_left(add_121(expand_8888_x4(b0), expand_8888_x4(b1), expand_8888_x4(b2)),
+                            1);
+        auto c = add_121(expand_8888_x4(c0), expand_8888_x4(c1), expand_8888_x4(c2));
+
+        auto sum = a + b + c;
+        skvx::cast<uint8_t>(shift_right(sum, 4)).store(d + i);
+    }
+    if (i < count) {
+        downsample_3_3<ColorTypeFilter_8888>(d + i, p0 + 2*i, srcRB, count - i);
+    }
+}
+
+static void downsample_2_2_F16(void* dst, const void* src, size_t srcRB, int count) {
+    SkASSERT(count > 0);
+    auto p0 = static_cast<const uint64_t*>(src);
+    auto p1 = (const uint64_t*)((const char*)p0 + srcRB);
+    auto d = static_cast<uint64_t*>(dst);
+
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        auto r0 = skvx::Vec<8, uint64_t>::Load(p0 + 2*i),
+             r1 = skvx::Vec<8, uint64_t>::Load(p1 + 2*i);
+
+        auto c00 = expand_F16_x4(skvx::shuffle<0,2,4,6>(r0));
+        auto c01 = expand_F16_x4(skvx::shuffle<1,3,5,7>(r0));
+        auto c10 = expand_F16_x4(skvx::shuffle<0,2,4,6>(r1));
+        auto c11 = expand_F16_x4(skvx::shuffle<1,3,5,7>(r1));
+
+        auto c = c00 + c10 + c01 + c11;
+        compact_F16_x4(shift_right(c, 2), d + i);
+    }
+    if (i < count) {
+        downsample_2_2<ColorTypeFilter_RGBA_F16>(d + i, p0 + 2*i, srcRB, count - i);
+    }
+}
+
+static void downsample_3_3_F16(void* dst, const void* src, size_t srcRB, int count) {
+    SkASSERT(count > 0);
+    auto p0 = static_cast<const uint64_t*>(src);
+    auto p1 = (const uint64_t*)((const char*)p0 + srcRB);
+    auto p2 = (const uint64_t*)((const char*)p1 + srcRB);
+    auto d = static_cast<uint64_t*>(dst);
+
+    auto columns = [](const uint64_t* p, int i, skvx::Vec<4, uint64_t>* a,
+                                                skvx::Vec<4, uint64_t>* b,
+                                                skvx::Vec<4, uint64_t>* c) {
+        auto r = skvx::Vec<8, uint64_t>::Load(p + 2*i);
+        *a = skvx::shuffle<0,2,4,6>(r);
+        *b = skvx::shuffle<1,3,5,7>(r);
+        *c = skvx::shuffle<1,2,3,4>(skvx::join(*a, skvx::Vec<4, uint64_t>(p[2*i + 8])));
+    };
+
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        skvx::Vec<4, uint64_t> a0, b0, c0, a1, b1, c1, a2, b2, c2;
+        columns(p0, i, &a0, &b0, &c0);
+        columns(p1, i, &a1, &b1, &c1);
+        columns(p2, i, &a2, &b2, &c2);
+
+        auto a = add_121(expand_F16_x4(a0), expand_F16_x4(a1), expand_F16_x4(a2));
+        auto b = shift_left(add_121(expand_F16_x4(b0), expand_F16_x4(b1), expand_F16_x4(b2)), 1);
+        auto c = add_121(expand_F16_x4(c0), expand_F16_x4(c1), expand_F16_x4(c2));
+
+        auto sum = a + b + c;
+        compact_F16_x4(shift_right(sum, 4), d + i);
+    }
+    if (i < count) {
+        downsample_3_3<ColorTypeFilter_RGBA_F16>(d + i, p0 + 2*i, srcRB, count - i);
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
 SkMipmap::SkMipmap(void* malloc, size_t size) : SkCachedData(malloc, size) {}
@@ -399,8 +544,11 @@ size_t SkMipmap::AllocLevelsSize(int levelCount, size_t pixelSize) {
     return SkTo<int32_t>(size);
 }
 
+// When building with an SkExecutor, levels are filtered in bands of about this many dst pixels.
+static constexpr int kPixelsPerBand = 64 * 1024;
+
 SkMipmap* SkMipmap::Build(const SkPixmap& src, SkDiscardableFactoryProc fact,
-                          bool computeContents) {
+                          bool computeContents, SkExecutor* executor) {
     typedef void FilterProc(void*, const void* srcPtr, size_t srcRB, int count);
 
     FilterProc* proc_1_2 = nullptr;
@@ -421,11 +569,11 @@ SkMipmap* SkMipmap::Build(const SkPixmap& src, SkDiscardableFactoryProc fact,
             proc_1_2 = downsample_1_2<ColorTypeFilter_8888>;
             proc_1_3 = downsample_1_3<ColorTypeFilter_8888>;
             proc_2_1 = downsample_2_1<ColorTypeFilter_8888>;
-            proc_2_2 = downsample_2_2<ColorTypeFilter_8888>;
+            proc_2_2 = downsample_2_2_8888;
             proc_2_3 = downsample_2_3<ColorTypeFilter_8888>;
             proc_3_1 = downsample_3_1<ColorTypeFilter_8888>;
             proc_3_2 = downsample_3_2<ColorTypeFilter_8888>;
-            proc_3_3 = downsample_3_3<ColorTypeFilter_8888>;
+            proc_3_3 = downsample_3_3_8888;
             break;
         case kRGB_565_SkColorType:
             proc_1_2 = downsample_1_2<ColorTypeFilter_565>;
@@ -464,11 +612,11 @@ SkMipmap* SkMipmap::Build(const SkPixmap& src, SkDiscardableFactoryProc fact,
             proc_1_2 = downsample_1_2<ColorTypeFilter_RGBA_F16>;
             proc_1_3 = downsample_1_3<ColorTypeFilter_RGBA_F16>;
             proc_2_1 = downsample_2_1<ColorTypeFilter_RGBA_F16>;
-            proc_2_2 = downsample_2_2<ColorTypeFilter_RGBA_F16>;
+            proc_2_2 = downsample_2_2_F16;
             proc_2_3 = downsample_2_3<ColorTypeFilter_RGBA_F16>;
             proc_3_1 = downsample_3_1<ColorTypeFilter_RGBA_F16>;
             proc_3_2 = downsample_3_2<ColorTypeFilter_RGBA_F16>;
-            proc_3_3 = downsample_3_3<ColorTypeFilter_RGBA_F16>;
+            proc_3_3 = downsample_3_3_F16;
             break;
         case kR8G8_unorm_SkColorType:
             proc_1_2 = downsample_1_2<ColorTypeFilter_88>;
@@ -643,14 +791,30 @@ SkMipmap* SkMipmap::Build(const SkPixmap& src, SkDiscardableFactoryProc fact,
 
         const SkPixmap& dstPM = levels[i].fPixmap;
         if (computeContents) {
-            const void* srcBasePtr = srcPM.addr();
-            void* dstBasePtr = dstPM.writable_addr();
-
-            const size_t srcRB = srcPM.rowBytes();
-            for (int y = 0; y < height; y++) {
-                proc(dstBasePtr, srcBasePtr, srcRB, width);
-                srcBasePtr = (char*)srcBasePtr + srcRB * 2; // jump two rows
-                dstBasePtr = (char*)dstBasePtr + dstPM.rowBytes();
+            auto downsample_rows = [&](int y0, int y1) {
+                const size_t srcRB = srcPM.rowBytes();
+                const void* srcBasePtr = (const char*)srcPM.addr() + srcRB * 2 * y0;
+                void* dstBasePtr = dstPM.writable_addr(0, y0);
+                for (int y = y0; y < y1; y++) {
+                    proc(dstBasePtr, srcBasePtr, srcRB, width);
+                    srcBasePtr = (char*)srcBasePtr + srcRB * 2; // jump two rows
+                    dstBasePtr = (char*)dstBasePtr + dstPM.rowBytes();
+                }
+            };
+
+            // Each level depends on the one before it, but its rows are independent, so big
+            // levels are split into bands of rows that can be filtered in parallel.
+            const int rowsPerBand = std::max(1, kPixelsPerBand / width);
+            const int bands = (height + rowsPerBand - 1) / rowsPerBand;
+            if (executor && bands > 1) {
+                SkTaskGroup tg(*executor);
+                tg.batch(bands, [&](int band) {
+                    const int y0 = band * rowsPerBand;
+                    downsample_rows(y0, std::min(height, y0 + rowsPerBand));
+                });
+                tg.wait();
+            } else {
+                downsample_rows(0, height);
             }
         }
         srcPM = dstPM;
@@ -796,12 +960,13 @@ bool SkMipmap::validForRootLevel(const SkImageInfo& root) const {
 
 // Helper which extracts a pixmap from the src bitmap
 //
-SkMipmap* SkMipmap::Build(const SkBitmap& src, SkDiscardableFactoryProc fact) {
+SkMipmap* SkMipmap::Build(const SkBitmap& src, SkDiscardableFactoryProc fact,
+                          SkExecutor* executor) {
     SkPixmap srcPixmap;
     if (!src.peekPixels(&srcPixmap)) {
         return nullptr;
     }
-    return Build(srcPixmap, fact);
+    return Build(srcPixmap, fact, /*computeContents=*/true, executor);
 }
 
 int SkMipmap::countLevels() const {
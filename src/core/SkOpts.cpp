@@ -10,6 +10,8 @@
 #include "src/core/SkCpu.h"
 #include "src/core/SkOpts.h"
 
+#include <cstring>
+
 #if defined(SK_ARM_HAS_NEON)
     #if defined(SK_ARM_HAS_CRC32)
         #define SK_OPTS_NS neon_and_crc32
@@ -70,6 +72,12 @@ namespace SkOpts {
     DEFINE_DEFAULT(gray_to_RGB1);
     DEFINE_DEFAULT(grayA_to_RGBA);
     DEFINE_DEFAULT(grayA_to_rgbA);
+    DEFINE_DEFAULT(RGB16_to_RGB1);
+    DEFINE_DEFAULT(RGB16_to_BGR1);
+    DEFINE_DEFAULT(RGBA16_to_RGBA);
+    DEFINE_DEFAULT(RGBA16_to_BGRA);
+    DEFINE_DEFAULT(index_to_8888);
+    DEFINE_DEFAULT(small_index_to_8888);
     DEFINE_DEFAULT(inverted_CMYK_to_RGB1);
     DEFINE_DEFAULT(inverted_CMYK_to_BGR1);
 
@@ -116,6 +124,25 @@ namespace SkOpts {
     void Init_skx();
     void Init_erms();
     void Init_crc32();
+    void Init_RasterPipeline_hsw();
+    void Init_RasterPipeline_skx();
+
+    static void init_raster_pipeline_baseline() {
+        raster_pipeline_lowp_stride  = SK_OPTS_NS::raster_pipeline_lowp_stride();
+        raster_pipeline_highp_stride = SK_OPTS_NS::raster_pipeline_highp_stride();
+
+    #define M(st) ops_highp[(int)SkRasterPipelineOp::st] = (StageFn)SK_OPTS_NS::st;
+        SK_RASTER_PIPELINE_OPS_ALL(M)
+        just_return_highp = (StageFn)SK_OPTS_NS::just_return;
+        start_pipeline_highp = SK_OPTS_NS::start_pipeline;
+    #undef M
+
+    #define M(st) ops_lowp[(int)SkRasterPipelineOp::st] = (StageFn)SK_OPTS_NS::lowp::st;
+        SK_RASTER_PIPELINE_OPS_LOWP(M)
+        just_return_lowp = (StageFn)SK_OPTS_NS::lowp::just_return;
+        start_pipeline_lowp = SK_OPTS_NS::lowp::start_pipeline;
+    #undef M
+    }
 
     static void init() {
     #if defined(SK_ENABLE_OPTIMIZE_SIZE)
@@ -150,4 +177,22 @@ namespace SkOpts {
         static SkOnce once;
         once(init);
     }
+
+    bool SetRasterPipelineBackend(const char* name) {
+        if (0 == strcmp(name, "baseline")) {
+            init_raster_pipeline_baseline();
+            return true;
+        }
+    #if !defined(SK_ENABLE_OPTIMIZE_SIZE) && defined(SK_CPU_X86)
+        if (0 == strcmp(name, "hsw") && SkCpu::Supports(SkCpu::HSW)) {
+            Init_RasterPipeline_hsw();
+            return true;
+        }
+        if (0 == strcmp(name, "skx") && SkCpu::Supports(SkCpu::SKX)) {
+            Init_RasterPipeline_skx();
+            return true;
+        }
+    #endif
+        return false;
+    }
 }  // namespace SkOpts
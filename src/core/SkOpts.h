@@ -71,6 +71,12 @@ namespace SkOpts {
     // Called by SkGraphics::Init().
     void Init();
 
+    // Replaces the SkRasterPipeline stages with those of a named backend: "baseline" for the ones
+    // Skia was compiled with, or "hsw" or "skx" on x86 CPUs that support them. Returns false, and
+    // changes nothing, if that backend is unknown or unavailable. For benchmarking; call after
+    // Init() and before building any pipelines.
+    bool SetRasterPipelineBackend(const char* name);
+
     // Declare function pointers here...
 
     // May return nullptr if we haven't specialized the given Mode.
@@ -93,7 +99,19 @@ namespace SkOpts {
                            RGB_to_BGR1,     // i.e. swap RB and insert an opaque alpha
                            gray_to_RGB1,    // i.e. expand to color channels + an opaque alpha
                            grayA_to_RGBA,   // i.e. expand to color channels
-                           grayA_to_rgbA;   // i.e. expand to color channels and premultiply
+                           grayA_to_rgbA,   // i.e. expand to color channels and premultiply
+                           RGB16_to_RGB1,   // i.e. 16-bit (PNG) to 8-bit, insert an opaque alpha
+                           RGB16_to_BGR1,   // i.e. as above, and swap RB
+                           RGBA16_to_RGBA,  // i.e. 16-bit (PNG) to 8-bit
+                           RGBA16_to_BGRA;  // i.e. as above, and swap RB
+
+    // Expand palette indices through a color table of finished 8888 pixels.
+    // small_index_to_8888 takes 1, 2 or 4-bit indices packed from the most significant bit down,
+    // starting at a byte boundary, and a table of (1 << bpp) entries.
+    extern void (*index_to_8888)(uint32_t dst[], const uint8_t* src, int count,
+                                 const uint32_t ctable[]);
+    extern void (*small_index_to_8888)(uint32_t dst[], const uint8_t* src, int count, int bpp,
+                                       const uint32_t ctable[]);
 
     extern void (*memset16)(uint16_t[], uint16_t, int);
     extern void (*memset32)(uint32_t[], uint32_t, int);
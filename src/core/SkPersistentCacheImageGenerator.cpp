@@ -0,0 +1,264 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkColorSpace.h"
+#include "include/core/SkData.h"
+#include "include/core/SkImageGenerator.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkPixmap.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkString.h"
+#include "include/core/SkTypes.h"
+#include "include/private/base/SkAlign.h"
+#include "include/private/base/SkTArray.h"
+#include "include/private/base/SkTemplates.h"
+#include "src/core/SkConvertPixels.h"
+#include "src/core/SkMD5.h"
+#include "src/core/SkMipmap.h"
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <utility>
+
+namespace {
+
+// Bump whenever Key or the entry layout changes, so that stale entries are ignored.
+constexpr uint32_t kVersion = 2;
+constexpr uint32_t kMagic   = SkSetFourByteTag('s', 'k', 'd', 'c');
+
+enum class Kind : uint32_t {
+    kPixels,
+    kMipmaps,
+};
+
+// Describes the encoded data and the pixels decoded from it. Ordered so that there is no padding,
+// as the key is compared byte for byte.
+struct Key {
+    uint32_t fVersion;
+    Kind     fKind;
+    uint64_t fEncodedSize;
+    uint8_t  fEncodedDigest[16];  // MD5 of the encoded data.
+    uint64_t fColorSpaceHash;     // 0 for no color space.
+    int32_t  fWidth;
+    int32_t  fHeight;
+    int32_t  fColorType;
+    int32_t  fAlphaType;
+};
+static_assert(sizeof(Key) == 56);
+
+// An entry is a Header, then a LevelHeader for each level, then the pixels of each level. Each
+// level is tightly packed and starts on a 16-byte boundary, so that pixels can be copied straight
+// out of a mapped file.
+struct Header {
+    uint32_t fMagic;
+    uint32_t fVersion;
+    int32_t  fColorType;
+    int32_t  fLevelCount;
+};
+
+struct LevelHeader {
+    int32_t  fWidth;
+    int32_t  fHeight;
+    uint64_t fOffset;
+};
+
+sk_sp<SkData> write_entry(const SkPixmap levels[], int count) {
+    size_t size = sizeof(Header) + count * sizeof(LevelHeader);
+    for (int i = 0; i < count; i++) {
+        size = SkAlignTo(size, 16) + levels[i].info().computeMinByteSize();
+    }
+
+    sk_sp<SkData> entry = SkData::MakeZeroInitialized(size);
+    auto header = static_cast<Header*>(entry->writable_data());
+    *header = {kMagic, kVersion, levels[0].colorType(), count};
+    auto levelHeaders = SkTAddOffset<LevelHeader>(header, sizeof(Header));
+
+    size_t offset = sizeof(Header) + count * sizeof(LevelHeader);
+    for (int i = 0; i < count; i++) {
+        const SkPixmap& pm = levels[i];
+        offset = SkAlignTo(offset, 16);
+        levelHeaders[i] = {pm.width(), pm.height(), offset};
+        SkRectMemcpy(SkTAddOffset<void>(header, offset), pm.info().minRowBytes(),
+                     pm.addr(), pm.rowBytes(), pm.info().minRowBytes(), pm.height());
+        offset += pm.info().computeMinByteSize();
+    }
+    SkASSERT(offset == size);
+    return entry;
+}
+
+// Copies the levels out of entry, if it holds exactly the levels expected.
+bool read_entry(const SkData& entry, const SkPixmap levels[], int count) {
+    if (entry.size() < sizeof(Header) + count * sizeof(LevelHeader)) {
+        return false;
+    }
+    auto header = static_cast<const Header*>(entry.data());
+    if (header->fMagic != kMagic || header->fVersion != kVersion ||
+        header->fColorType != levels[0].colorType() || header->fLevelCount != count) {
+        return false;
+    }
+
+    auto levelHeaders = SkTAddOffset<const LevelHeader>(header, sizeof(Header));
+    for (int i = 0; i < count; i++) {
+        const LevelHeader& level = levelHeaders[i];
+        const SkPixmap& pm = levels[i];
+        if (level.fWidth != pm.width() || level.fHeight != pm.height() ||
+            level.fOffset > entry.size() ||
+            entry.size() - level.fOffset < pm.info().computeMinByteSize()) {
+            return false;
+        }
+    }
+    for (int i = 0; i < count; i++) {
+        const SkPixmap& pm = levels[i];
+        SkRectMemcpy(pm.writable_addr(), pm.rowBytes(),
+                     entry.bytes() + levelHeaders[i].fOffset, pm.info().minRowBytes(),
+                     pm.info().minRowBytes(), pm.height());
+    }
+    return true;
+}
+
+void collect_levels(const SkMipmap& mips, SkSTArray<16, SkPixmap>* levels) {
+    for (int i = 0; i < mips.countLevels(); i++) {
+        SkMipmap::Level level;
+        SkAssertResult(mips.getLevel(i, &level));
+        levels->push_back(level.fPixmap);
+    }
+}
+
+class SkPersistentCacheImageGenerator final : public SkImageGenerator {
+public:
+    SkPersistentCacheImageGenerator(std::unique_ptr<SkImageGenerator> generator,
+                                    sk_sp<SkData> encoded,
+                                    PersistentCache* cache,
+                                    bool withMipmaps)
+            : SkImageGenerator(generator->getInfo(), generator->uniqueID())
+            , fGenerator(std::move(generator))
+            , fEncoded(std::move(encoded))
+            , fCache(cache)
+            , fWithMipmaps(withMipmaps) {}
+
+protected:
+    sk_sp<SkData> onRefEncodedData() override { return fEncoded; }
+
+    bool onIsValid(GrRecordingContext* context) const override {
+        return fGenerator->isValid(context);
+    }
+
+    bool onGetPixels(const SkImageInfo& info, void* pixels, size_t rowBytes,
+                     const Options&) override {
+        const SkPixmap dst(info, pixels, rowBytes);
+        sk_sp<SkData> key = this->makeKey(Kind::kPixels, info);
+        if (sk_sp<SkData> entry = fCache->load(*key); entry && read_entry(*entry, &dst, 1)) {
+            return true;
+        }
+
+        if (!fGenerator->getPixels(dst)) {
+            return false;
+        }
+        fCache->store(*key, *write_entry(&dst, 1), this->describe(Kind::kPixels, info));
+        return true;
+    }
+
+    bool onQueryYUVAInfo(const SkYUVAPixmapInfo::SupportedDataTypes& supportedDataTypes,
+                         SkYUVAPixmapInfo* yuvaPixmapInfo) const override {
+        return fGenerator->queryYUVAInfo(supportedDataTypes, yuvaPixmapInfo);
+    }
+
+    bool onGetYUVAPlanes(const SkYUVAPixmaps& yuvaPixmaps) override {
+        return fGenerator->getYUVAPlanes(yuvaPixmaps);
+    }
+
+    SkMipmap* onMakeMipmaps(const SkPixmap& base,
+                            SkDiscardableMemory* (*factory)(size_t bytes)) override {
+        if (!fWithMipmaps) {
+            return nullptr;
+        }
+
+        sk_sp<SkData> key = this->makeKey(Kind::kMipmaps, base.info());
+        if (sk_sp<SkData> entry = fCache->load(*key)) {
+            // Allocate the levels without filtering them, then fill them from the entry.
+            sk_sp<SkMipmap> mips(SkMipmap::Build(base, factory, /*computeContents=*/false));
+            if (mips) {
+                SkSTArray<16, SkPixmap> levels;
+                collect_levels(*mips, &levels);
+                if (read_entry(*entry, levels.data(), levels.size())) {
+                    return mips.release();
+                }
+            }
+        }
+
+        SkMipmap* mips = SkMipmap::Build(base, factory);
+        if (mips) {
+            SkSTArray<16, SkPixmap> levels;
+            collect_levels(*mips, &levels);
+            fCache->store(*key, *write_entry(levels.data(), levels.size()),
+                          this->describe(Kind::kMipmaps, base.info()));
+        }
+        return mips;
+    }
+
+private:
+    sk_sp<SkData> makeKey(Kind kind, const SkImageInfo& info) {
+        if (!fHashedEncoded) {
+            // MD5 makes accidental collisions between images vanishingly unlikely, but collisions
+            // can be crafted on purpose; see SkImageGenerator::MakeWithPersistentCache().
+            SkMD5 md5;
+            md5.write(fEncoded->data(), fEncoded->size());
+            fEncodedDigest = md5.finish();
+            fHashedEncoded = true;
+        }
+
+        Key key;
+        memset(&key, 0, sizeof(Key));
+        key.fVersion        = kVersion;
+        key.fKind           = kind;
+        key.fEncodedSize    = fEncoded->size();
+        memcpy(key.fEncodedDigest, fEncodedDigest.data, sizeof(key.fEncodedDigest));
+        key.fColorSpaceHash = info.colorSpace() ? info.colorSpace()->hash() : 0;
+        key.fWidth          = info.width();
+        key.fHeight         = info.height();
+        key.fColorType      = info.colorType();
+        key.fAlphaType      = info.alphaType();
+        return SkData::MakeWithCopy(&key, sizeof(Key));
+    }
+
+    SkString describe(Kind kind, const SkImageInfo& info) const {
+        SkString digest;
+        for (uint8_t byte : fEncodedDigest.data) {
+            digest.appendf("%02x", byte);
+        }
+        return SkStringPrintf("%s of %zu bytes with MD5 %s, %dx%d, ct %d, at %d",
+                              kind == Kind::kPixels ? "Pixels" : "Mipmaps",
+                              fEncoded->size(), digest.c_str(),
+                              info.width(), info.height(), info.colorType(), info.alphaType());
+    }
+
+    const std::unique_ptr<SkImageGenerator> fGenerator;
+    const sk_sp<SkData>                     fEncoded;
+    PersistentCache* const                  fCache;
+    const bool                              fWithMipmaps;
+
+    bool          fHashedEncoded = false;
+    SkMD5::Digest fEncodedDigest;
+};
+
+}  // namespace
+
+std::unique_ptr<SkImageGenerator> SkImageGenerator::MakeWithPersistentCache(
+        std::unique_ptr<SkImageGenerator> generator, PersistentCache* cache, bool withMipmaps) {
+    if (!generator || !cache) {
+        return generator;
+    }
+    sk_sp<SkData> encoded = generator->refEncodedData();
+    if (!encoded) {
+        return generator;
+    }
+    return std::make_unique<SkPersistentCacheImageGenerator>(std::move(generator),
+                                                             std::move(encoded),
+                                                             cache,
+                                                             withMipmaps);
+}
@@ -7,7 +7,13 @@
 
 #include "src/core/SkRTree.h"
 
-SkRTree::SkRTree() : fCount(0) {}
+#include "src/base/SkVx.h"
+
+#include <limits>
+
+static_assert(SkRTree::kMaxChildren == 8, "search() tests all children with one skvx::float8");
+
+SkRTree::SkRTree() : fCount(0), fRoot(-1), fRootBounds(SkRect::MakeEmpty()) {}
 
 void SkRTree::insert(const SkRect boundsArray[], int N) {
     SkASSERT(0 == fCount);
@@ -21,36 +27,48 @@ void SkRTree::insert(const SkRect boundsArray[], int N) {
             continue;
         }
 
-        Branch b;
-        b.fBounds = bounds;
-        b.fOpIndex = i;
-        branches.push_back(b);
+        branches.push_back({bounds, i});
     }
 
     fCount = (int)branches.size();
     if (fCount) {
         if (1 == fCount) {
             fNodes.reserve(1);
-            Node* n = this->allocateNodeAtLevel(0);
-            n->fNumChildren = 1;
-            n->fChildren[0] = branches[0];
-            fRoot.fSubtree = n;
-            fRoot.fBounds  = branches[0].fBounds;
+            fRoot = this->allocateNodeAtLevel(0);
+            this->setChild(&fNodes[fRoot], 0, branches[0]);
+            fNodes[fRoot].fNumChildren = 1;
+            fRootBounds = branches[0].fBounds;
         } else {
             fNodes.reserve(CountNodes(fCount));
-            fRoot = this->bulkLoad(&branches);
+            Branch root = this->bulkLoad(&branches);
+            fRoot       = root.fIndex;
+            fRootBounds = root.fBounds;
         }
     }
 }
 
-SkRTree::Node* SkRTree::allocateNodeAtLevel(uint16_t level) {
+int SkRTree::allocateNodeAtLevel(uint16_t level) {
     SkDEBUGCODE(Node* p = fNodes.data());
     fNodes.push_back(Node{});
     Node& out = fNodes.back();
     SkASSERT(fNodes.data() == p);  // If this fails, we didn't reserve() enough.
+    constexpr float inf = std::numeric_limits<float>::infinity();
+    for (int i = 0; i < kMaxChildren; i++) {
+        out.fLeft  [i] = out.fTop   [i] = +inf;
+        out.fRight [i] = out.fBottom[i] = -inf;
+        out.fChildren[i] = -1;
+    }
     out.fNumChildren = 0;
     out.fLevel = level;
-    return &out;
+    return (int)fNodes.size() - 1;
+}
+
+void SkRTree::setChild(Node* n, int i, const Branch& b) {
+    n->fLeft  [i]   = b.fBounds.fLeft;
+    n->fTop   [i]   = b.fBounds.fTop;
+    n->fRight [i]   = b.fBounds.fRight;
+    n->fBottom[i]   = b.fBounds.fBottom;
+    n->fChildren[i] = b.fIndex;
 }
 
 // This function parallels bulkLoad, but just counts how many nodes bulkLoad would allocate.
@@ -121,16 +139,16 @@ SkRTree::Branch SkRTree::bulkLoad(std::vector<Branch>* branches, int level) {
                 remainder -= kMaxChildren - kMinChildren;
             }
         }
-        Node* n = allocateNodeAtLevel(level);
-        n->fNumChildren = 1;
-        n->fChildren[0] = (*branches)[currentBranch];
         Branch b;
+        b.fIndex = this->allocateNodeAtLevel(level);
         b.fBounds = (*branches)[currentBranch].fBounds;
-        b.fSubtree = n;
+        Node* n = &fNodes[b.fIndex];
+        this->setChild(n, 0, (*branches)[currentBranch]);
+        n->fNumChildren = 1;
         ++currentBranch;
         for (int k = 1; k < incrementBy && currentBranch < (int)branches->size(); ++k) {
             b.fBounds.join((*branches)[currentBranch].fBounds);
-            n->fChildren[k] = (*branches)[currentBranch];
+            this->setChild(n, k, (*branches)[currentBranch]);
             ++n->fNumChildren;
             ++currentBranch;
         }
@@ -142,18 +160,47 @@ SkRTree::Branch SkRTree::bulkLoad(std::vector<Branch>* branches, int level) {
 }
 
 void SkRTree::search(const SkRect& query, std::vector<int>* results) const {
-    if (fCount > 0 && SkRect::Intersects(fRoot.fBounds, query)) {
-        this->search(fRoot.fSubtree, query, results);
+    // Every stored rect is non-empty, so once the query is known to be non-empty,
+    // SkRect::Intersects() reduces to four independent compares per child.
+    if (fCount == 0 || !(query.fLeft < query.fRight && query.fTop < query.fBottom) ||
+            !SkRect::Intersects(fRootBounds, query)) {
+        return;
     }
-}
-
-void SkRTree::search(Node* node, const SkRect& query, std::vector<int>* results) const {
-    for (int i = 0; i < node->fNumChildren; ++i) {
-        if (SkRect::Intersects(node->fChildren[i].fBounds, query)) {
-            if (0 == node->fLevel) {
-                results->push_back(node->fChildren[i].fOpIndex);
-            } else {
-                this->search(node->fChildren[i].fSubtree, query, results);
+    const skvx::float8 qL(query.fLeft),
+                       qT(query.fTop),
+                       qR(query.fRight),
+                       qB(query.fBottom);
+
+    // Each node has at least two children (kMinChildren except perhaps at the root), so the depth
+    // of the tree is bounded by the bits in fCount.  We push at most kMaxChildren per level.
+    constexpr int kMaxStack = 32 * kMaxChildren;
+    int stack[kMaxStack];
+    int top = 0;
+    stack[top++] = fRoot;
+
+    while (top > 0) {
+        const Node& node = fNodes[stack[--top]];
+        auto hit = (skvx::float8::Load(node.fLeft) < qR) & (qL < skvx::float8::Load(node.fRight))
+                 & (skvx::float8::Load(node.fTop)  < qB) & (qT < skvx::float8::Load(node.fBottom));
+        if (!skvx::any(hit)) {
+            continue;
+        }
+        int32_t hits[kMaxChildren];
+        hit.store(hits);
+
+        if (node.fLevel == 0) {
+            for (int i = 0; i < node.fNumChildren; ++i) {
+                if (hits[i]) {
+                    results->push_back(node.fChildren[i]);
+                }
+            }
+        } else {
+            // Push in reverse so children pop in order, keeping results sorted by op index.
+            for (int i = node.fNumChildren; i --> 0;) {
+                if (hits[i]) {
+                    SkASSERT(top < kMaxStack);
+                    stack[top++] = node.fChildren[i];
+                }
             }
         }
     }
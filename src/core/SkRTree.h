@@ -18,6 +18,9 @@
  * It only supports bulk-loading, i.e. creation from a batch of bounding rectangles.
  * This performs a bottom-up bulk load using the STR (sort-tile-recursive) algorithm.
  *
+ * Nodes are packed into one array and store their children's bounds as structure-of-arrays, so
+ * search() tests a whole node with a few SIMD compares, walking the tree with a fixed-size stack.
+ *
  * TODO: Experiment with other bulk-load algorithms (in particular the Hilbert pack variant,
  * which groups rects by position on the Hilbert curve, is probably worth a look). There also
  * exist top-down bulk load variants (VAMSplit, TopDownGreedy, etc).
@@ -38,44 +41,47 @@ public:
     // Methods and constants below here are only public for tests.
 
     // Return the depth of the tree structure.
-    int getDepth() const { return fCount ? fRoot.fSubtree->fLevel + 1 : 0; }
+    int getDepth() const { return fCount ? fNodes[fRoot].fLevel + 1 : 0; }
     // Insertion count (not overall node count, which may be greater).
     int getCount() const { return fCount; }
 
-    // These values were empirically determined to produce reasonable performance in most cases.
-    static const int kMinChildren = 6,
-                     kMaxChildren = 11;
+    // kMaxChildren matches the width of one skvx::float8, so a node's children are tested in a
+    // single compare.  kMinChildren keeps about the same fill ratio as the old 6/11 split.
+    static const int kMinChildren = 4,
+                     kMaxChildren = 8;
 
 private:
-    struct Node;
-
+    // A bounding rect and either an op index (for leaves) or a node index (for everything else).
     struct Branch {
-        union {
-            Node* fSubtree;
-            int fOpIndex;
-        };
         SkRect fBounds;
+        int    fIndex;
     };
 
+    // Child bounds are stored structure-of-arrays.  Unused slots hold an inverted, infinite rect
+    // that never intersects anything.
     struct Node {
+        float    fLeft  [kMaxChildren],
+                 fTop   [kMaxChildren],
+                 fRight [kMaxChildren],
+                 fBottom[kMaxChildren];
+        int      fChildren[kMaxChildren];  // Op indices if fLevel == 0, node indices otherwise.
         uint16_t fNumChildren;
         uint16_t fLevel;
-        Branch fChildren[kMaxChildren];
     };
 
-    void search(Node* root, const SkRect& query, std::vector<int>* results) const;
-
     // Consumes the input array.
     Branch bulkLoad(std::vector<Branch>* branches, int level = 0);
 
     // How many times will bulkLoad() call allocateNodeAtLevel()?
     static int CountNodes(int branches);
 
-    Node* allocateNodeAtLevel(uint16_t level);
+    int allocateNodeAtLevel(uint16_t level);
+    void setChild(Node*, int i, const Branch&);
 
     // This is the count of data elements (rather than total nodes in the tree)
     int fCount;
-    Branch fRoot;
+    int fRoot;
+    SkRect fRootBounds;
     std::vector<Node> fNodes;
 };
 
@@ -24,6 +24,7 @@ using namespace skia_private;
 using Op = SkRasterPipelineOp;
 
 bool gForceHighPrecisionRasterPipeline;
+bool gDisableRasterPipelineStageFusion;
 
 SkRasterPipeline::SkRasterPipeline(SkArenaAlloc* alloc) : fAlloc(alloc) {
     this->reset();
@@ -399,25 +400,88 @@ static void prepend_to_pipeline(SkRasterPipelineStage*& ip, SkOpts::StageFn stag
     ip->ctx = ctx;
 }
 
-bool SkRasterPipeline::build_lowp_pipeline(SkRasterPipelineStage* ip) const {
-    if (gForceHighPrecisionRasterPipeline || fRewindCtx) {
+// Many blits end in a run of stages like
+//     [uniform_color] [clamp_01] [scale_1_float] load_8888_dst srcover store_8888
+// that a single fused stage can replace, saving the dispatch between each. In lowp, a
+// srcover_rgba_8888 stage is exactly that load_8888_dst, srcover and store_8888, and clamp_01 never
+// changes a uniform_color, which only holds colors in gamut. (In highp, srcover_rgba_8888 rounds
+// a little differently, so we leave highp pipelines alone.) Blitters put these runs last, so
+// that's the only place we look for them.
+bool SkRasterPipeline::fuse_lowp_tail(SkRasterPipeline_SrcoverRGBA8888Ctx* fusedCtx,
+                                      FusedTail* fused) const {
+    if (gDisableRasterPipelineStageFusion) {
+        return false;
+    }
+
+    const StageList* st = fStages;
+    bool fusedSrcover = false;
+    if (st && st->stage == Op::store_8888 &&
+        st->prev && st->prev->stage == Op::srcover &&
+        st->prev->prev && st->prev->prev->stage == Op::load_8888_dst &&
+        st->prev->prev->ctx == st->ctx) {
+        fusedSrcover = true;
+    } else if (!st || st->stage != Op::srcover_rgba_8888) {
         return false;
     }
+    auto dst = static_cast<const SkRasterPipeline_MemoryCtx*>(st->ctx);
+    st = fusedSrcover ? st->prev->prev->prev : st->prev;
+
+    const float* coverage = nullptr;
+    if (st && st->stage == Op::scale_1_float) {
+        coverage = static_cast<const float*>(st->ctx);
+        st = st->prev;
+    }
+
+    const SkRasterPipeline_UniformColorCtx* color = nullptr;
+    const StageList* seed = (st && st->stage == Op::clamp_01) ? st->prev : st;
+    if (seed && seed->stage == Op::uniform_color) {
+        color = static_cast<const SkRasterPipeline_UniformColorCtx*>(seed->ctx);
+        st = seed->prev;
+    }
+
+    if (!color && !coverage) {
+        if (!fusedSrcover) {
+            return false;
+        }
+        *fused = {Op::srcover_rgba_8888, const_cast<SkRasterPipeline_MemoryCtx*>(dst), st};
+        return true;
+    }
+
+    *fusedCtx = {dst, color, coverage};
+    Op op = !color    ? Op::scale_1_float_srcover_rgba_8888
+          : !coverage ? Op::uniform_color_srcover_rgba_8888
+                      : Op::uniform_color_scale_1_float_srcover_rgba_8888;
+    *fused = {op, fusedCtx, st};
+    return true;
+}
+
+SkRasterPipelineStage* SkRasterPipeline::build_lowp_pipeline(
+        SkRasterPipelineStage* ip, SkRasterPipeline_SrcoverRGBA8888Ctx* fusedCtx) const {
+    if (gForceHighPrecisionRasterPipeline || fRewindCtx) {
+        return nullptr;
+    }
     // Stages are stored backwards in fStages; to compensate, we assemble the pipeline in reverse
     // here, back to front.
     prepend_to_pipeline(ip, SkOpts::just_return_lowp, /*ctx=*/nullptr);
-    for (const StageList* st = fStages; st; st = st->prev) {
+
+    const StageList* st = fStages;
+    FusedTail fused;
+    if (this->fuse_lowp_tail(fusedCtx, &fused) && SkOpts::ops_lowp[(int)fused.op]) {
+        prepend_to_pipeline(ip, SkOpts::ops_lowp[(int)fused.op], fused.ctx);
+        st = fused.rest;
+    }
+    for (; st; st = st->prev) {
         int opIndex = (int)st->stage;
         if (opIndex >= kNumRasterPipelineLowpOps || !SkOpts::ops_lowp[opIndex]) {
             // This program contains a stage that doesn't exist in lowp.
-            return false;
+            return nullptr;
         }
         prepend_to_pipeline(ip, SkOpts::ops_lowp[opIndex], st->ctx);
     }
-    return true;
+    return ip;
 }
 
-void SkRasterPipeline::build_highp_pipeline(SkRasterPipelineStage* ip) const {
+SkRasterPipelineStage* SkRasterPipeline::build_highp_pipeline(SkRasterPipelineStage* ip) const {
     // We assemble the pipeline in reverse, since the stage list is stored backwards.
     prepend_to_pipeline(ip, SkOpts::just_return_highp, /*ctx=*/nullptr);
     for (const StageList* st = fStages; st; st = st->prev) {
@@ -433,21 +497,24 @@ void SkRasterPipeline::build_highp_pipeline(SkRasterPipelineStage* ip) const {
         const int rewindIndex = (int)Op::stack_checkpoint;
         prepend_to_pipeline(ip, SkOpts::ops_highp[rewindIndex], fRewindCtx);
     }
+    return ip;
 }
 
 SkRasterPipeline::StartPipelineFn SkRasterPipeline::build_pipeline(
-        SkRasterPipelineStage* ip) const {
+        SkRasterPipelineStage* ip,
+        SkRasterPipeline_SrcoverRGBA8888Ctx* fusedCtx,
+        SkRasterPipelineStage** program) const {
     // We try to build a lowp pipeline first; if that fails, we fall back to a highp float pipeline.
-    if (this->build_lowp_pipeline(ip)) {
+    if ((*program = this->build_lowp_pipeline(ip, fusedCtx))) {
         return SkOpts::start_pipeline_lowp;
     }
 
-    this->build_highp_pipeline(ip);
+    *program = this->build_highp_pipeline(ip);
     return SkOpts::start_pipeline_highp;
 }
 
 int SkRasterPipeline::stages_needed() const {
-    // Add 1 to budget for a `just_return` stage at the end.
+    // Add 1 to budget for a `just_return` stage at the end. Fusing stages only needs fewer.
     int stages = fNumStages + 1;
 
     // If we have any stack_rewind stages, we will need to inject a stack_checkpoint stage.
@@ -465,10 +532,12 @@ void SkRasterPipeline::run(size_t x, size_t y, size_t w, size_t h) const {
     int stagesNeeded = this->stages_needed();
 
     // Best to not use fAlloc here... we can't bound how often run() will be called.
-    AutoSTMalloc<32, SkRasterPipelineStage> program(stagesNeeded);
+    AutoSTMalloc<32, SkRasterPipelineStage> storage(stagesNeeded);
+    SkRasterPipeline_SrcoverRGBA8888Ctx fusedCtx;
 
-    auto start_pipeline = this->build_pipeline(program.get() + stagesNeeded);
-    start_pipeline(x,y,x+w,y+h, program.get());
+    SkRasterPipelineStage* program;
+    auto start_pipeline = this->build_pipeline(storage.get() + stagesNeeded, &fusedCtx, &program);
+    start_pipeline(x,y,x+w,y+h, program);
 }
 
 std::function<void(size_t, size_t, size_t, size_t)> SkRasterPipeline::compile() const {
@@ -478,9 +547,11 @@ std::function<void(size_t, size_t, size_t, size_t)> SkRasterPipeline::compile()
 
     int stagesNeeded = this->stages_needed();
 
-    SkRasterPipelineStage* program = fAlloc->makeArray<SkRasterPipelineStage>(stagesNeeded);
+    SkRasterPipelineStage* storage = fAlloc->makeArray<SkRasterPipelineStage>(stagesNeeded);
+    auto fusedCtx = fAlloc->make<SkRasterPipeline_SrcoverRGBA8888Ctx>();
 
-    auto start_pipeline = this->build_pipeline(program + stagesNeeded);
+    SkRasterPipelineStage* program;
+    auto start_pipeline = this->build_pipeline(storage + stagesNeeded, fusedCtx, &program);
     return [=](size_t x, size_t y, size_t w, size_t h) {
         start_pipeline(x,y,x+w,y+h, program);
     };
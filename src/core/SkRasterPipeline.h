@@ -129,11 +129,24 @@ public:
     bool empty() const { return fStages == nullptr; }
 
 private:
-    bool build_lowp_pipeline(SkRasterPipelineStage* ip) const;
-    void build_highp_pipeline(SkRasterPipelineStage* ip) const;
+    // A stage that stands in for the last few stages of the pipeline; see fuse_lowp_tail().
+    struct FusedTail {
+        SkRasterPipelineOp op;
+        void*              ctx;
+        const StageList*   rest;  // The stages before those replaced.
+    };
+    bool fuse_lowp_tail(SkRasterPipeline_SrcoverRGBA8888Ctx* fusedCtx, FusedTail*) const;
+
+    // Each fills in the program backwards from ip, and returns its first stage.
+    // build_lowp_pipeline() returns nullptr if the program has a stage lowp can't run.
+    SkRasterPipelineStage* build_lowp_pipeline(SkRasterPipelineStage* ip,
+                                               SkRasterPipeline_SrcoverRGBA8888Ctx* fusedCtx) const;
+    SkRasterPipelineStage* build_highp_pipeline(SkRasterPipelineStage* ip) const;
 
     using StartPipelineFn = void(*)(size_t,size_t,size_t,size_t, SkRasterPipelineStage* program);
-    StartPipelineFn build_pipeline(SkRasterPipelineStage*) const;
+    StartPipelineFn build_pipeline(SkRasterPipelineStage* ip,
+                                   SkRasterPipeline_SrcoverRGBA8888Ctx* fusedCtx,
+                                   SkRasterPipelineStage** program) const;
 
     void unchecked_append(SkRasterPipelineOp, void*);
     int stages_needed() const;
@@ -25,6 +25,7 @@
 
 #include <semaphore.h>
 #include <assert.h>
+#include <cstring>
 #include <pthread.h>
 #include <sys/sysinfo.h>
 #define SK_BLITTER_TRACE_IS_RASTER_PIPELINE
@@ -56,6 +57,7 @@ public:
 
 private:
     void blitRectWithTrace(int x, int y, int w, int h, bool trace);
+    void blitAntiHRun(int x, int y, int width, SkAlpha alpha);
     void append_load_dst      (SkRasterPipeline*) const;
     void append_store         (SkRasterPipeline*) const;
 
@@ -91,6 +93,9 @@ private:
     float fCurrentCoverage = 0.0f;
     float fDitherRate      = 0.0f;
 
+    // Short runs passed to blitAntiH() are gathered here and blit together as one A8 row.
+    SkAlpha* fAntiHCoverage = nullptr;
+
     using INHERITED = SkBlitter;
 };
 
@@ -531,7 +536,63 @@ fb:
     fBlitRect(x,y,w,h);
 }
 
+// Runs of constant coverage at least this long are blit on their own, where 0x00 and 0xff need no
+// coverage at all. Shorter runs are cheaper to expand into a row of per-pixel coverage, so that a
+// scanline of many short runs, as from small text-like paths, costs one pipeline call, not one each.
+static constexpr int kMinUnbatchedAntiHRun = 16;
+
+bool gDisableRasterPipelineCoverageBatching;
+
 void SkRasterPipelineBlitter::blitAntiH(int x, int y, const SkAlpha aa[], const int16_t runs[]) {
+    SK_BLITTER_TRACE_STEP(blitAntiH, true, /*scanlines=*/1ul, /*pixels=*/0ul);
+
+    // The batch starts at batchX with a run of non-zero coverage. Zero runs after the last
+    // non-zero one are buffered, but only blit if more coverage follows them.
+    int batchX     = x,
+        batchWidth = 0,  // All buffered pixels...
+        batchRuns  = 0,
+        blitWidth  = 0,  // ...and those up to the end of the last non-zero run.
+        blitRuns   = 0;
+    auto flush = [&] {
+        if (blitRuns == 1) {
+            this->blitAntiHRun(batchX, y, blitWidth, fAntiHCoverage[0]);
+        } else if (blitRuns > 1) {
+            this->blitAntiHRow(batchX, y, fAntiHCoverage, blitWidth);
+        }
+        batchWidth = batchRuns = blitWidth = blitRuns = 0;
+    };
+
+    for (int16_t run = *runs; run > 0; run = *runs) {
+        SK_BLITTER_TRACE_STEP_ACCUMULATE(blitAntiH, /*pixels=*/run);
+        if (run < kMinUnbatchedAntiHRun && !gDisableRasterPipelineCoverageBatching) {
+            if (batchRuns == 0) {
+                batchX = x;
+            }
+            if (batchRuns > 0 || *aa != 0x00) {
+                if (!fAntiHCoverage) {
+                    fAntiHCoverage = fAlloc->makeArrayDefault<SkAlpha>(fDst.width());
+                }
+                SkASSERT(batchWidth + run <= fDst.width());
+                memset(fAntiHCoverage + batchWidth, *aa, run);
+                batchWidth += run;
+                batchRuns  += 1;
+                if (*aa != 0x00) {
+                    blitWidth = batchWidth;
+                    blitRuns  = batchRuns;
+                }
+            }
+        } else {
+            flush();
+            this->blitAntiHRun(x, y, run, *aa);
+        }
+        x    += run;
+        runs += run;
+        aa   += run;
+    }
+    flush();
+}
+
+void SkRasterPipelineBlitter::blitAntiHRun(int x, int y, int width, SkAlpha alpha) {
     if (!fBlitAntiH) {
         SkRasterPipeline p(fAlloc);
         p.extend(fColorPipeline);
@@ -552,19 +613,12 @@ void SkRasterPipelineBlitter::blitAntiH(int x, int y, const SkAlpha aa[], const
         fBlitAntiH = p.compile();
     }
 
-    SK_BLITTER_TRACE_STEP(blitAntiH, true, /*scanlines=*/1ul, /*pixels=*/0ul);
-    for (int16_t run = *runs; run > 0; run = *runs) {
-        SK_BLITTER_TRACE_STEP_ACCUMULATE(blitAntiH, /*pixels=*/run);
-        switch (*aa) {
-            case 0x00:                                break;
-            case 0xff:this->blitRectWithTrace(x,y,run, 1, false); break;
-            default:
-                fCurrentCoverage = *aa * (1/255.0f);
-                fBlitAntiH(x,y,run,1);
-        }
-        x    += run;
-        runs += run;
-        aa   += run;
+    switch (alpha) {
+        case 0x00:                                break;
+        case 0xff:this->blitRectWithTrace(x,y,width, 1, false); break;
+        default:
+            fCurrentCoverage = alpha * (1/255.0f);
+            fBlitAntiH(x,y,width,1);
     }
 }
 
@@ -12,8 +12,8 @@
 // of pixels we handle in the highp pipeline. Many of the context structs in this file are only used
 // by stages that have no lowp implementation. They can therefore use the (smaller) highp value to
 // save memory in the arena.
-inline static constexpr int SkRasterPipeline_kMaxStride = 16;
-inline static constexpr int SkRasterPipeline_kMaxStride_highp = 8;
+inline static constexpr int SkRasterPipeline_kMaxStride = 32;
+inline static constexpr int SkRasterPipeline_kMaxStride_highp = 16;
 
 // These structs hold the context data for many of the Raster Pipeline ops.
 struct SkRasterPipeline_MemoryCtx {
@@ -139,6 +139,14 @@ struct SkRasterPipeline_UniformColorCtx {
     uint16_t rgba[4];  // [0,255] in a 16-bit lane.
 };
 
+// The fused *_srcover_rgba_8888 stages stand in for a run of uniform_color, scale_1_float and
+// srcover_rgba_8888 stages, and use the contexts of each.
+struct SkRasterPipeline_SrcoverRGBA8888Ctx {
+    const SkRasterPipeline_MemoryCtx*       dst;
+    const SkRasterPipeline_UniformColorCtx* color;     // uniform_color_* variants only.
+    const float*                            coverage;  // *scale_1_float_* variants only.
+};
+
 struct SkRasterPipeline_EmbossCtx {
     SkRasterPipeline_MemoryCtx mul,
                                add;
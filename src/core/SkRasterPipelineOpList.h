@@ -38,6 +38,9 @@
     M(darken) M(difference)                                        \
     M(exclusion) M(hardlight) M(lighten) M(overlay)                \
     M(srcover_rgba_8888)                                           \
+    M(uniform_color_srcover_rgba_8888)                             \
+    M(scale_1_float_srcover_rgba_8888)                             \
+    M(uniform_color_scale_1_float_srcover_rgba_8888)               \
     M(matrix_translate) M(matrix_scale_translate)                  \
     M(matrix_2x3)                                                  \
     M(matrix_perspective)                                          \
@@ -11,6 +11,7 @@
 #include "src/core/SkCanvasPriv.h"
 #include "src/core/SkColorFilterBase.h"
 #include "src/core/SkImageFilter_Base.h"
+#include "src/core/SkPaintPriv.h"
 #include "src/core/SkRecordDraw.h"
 #include "src/utils/SkPatchUtils.h"
 
@@ -59,6 +60,122 @@ void SkRecordDraw(const SkRecord& record,
     }
 }
 
+namespace {
+
+// Ops that may read pixels outside their own bounds, possibly ones a later draw will hide.
+// Pictures and drawables could hold backdrop layers.
+struct MayReadOutsideBounds {
+    template <typename T> bool operator()(const T&) { return false; }
+    bool operator()(const SkRecords::SaveLayer& op) { return op.backdrop != nullptr; }
+    bool operator()(const SkRecords::SaveBehind&)   { return true; }
+    bool operator()(const SkRecords::DrawBehind&)   { return true; }
+    bool operator()(const SkRecords::DrawPicture&)  { return true; }
+    bool operator()(const SkRecords::DrawDrawable&) { return true; }
+};
+
+// Draws that have no effect other than on pixels in their bounds, so can be skipped when hidden.
+struct IsSkippableDraw {
+    template <typename T> bool operator()(const T&) {
+        return SkToBool(T::kTags & SkRecords::kDraw_Tag);
+    }
+    bool operator()(const SkRecords::DrawBehind&)   { return false; }
+    bool operator()(const SkRecords::DrawDrawable&) { return false; }
+};
+
+}  // namespace
+
+int SkRecordDrawWithOcclusion(const SkRecord& record,
+                              SkCanvas* canvas,
+                              SkPicture const* const drawablePicts[],
+                              SkDrawable* const drawables[],
+                              int drawableCount,
+                              const SkRect bounds[],
+                              const bool opaque[],
+                              const SkBBoxHierarchy* bbh,
+                              SkPicture::AbortCallback* callback) {
+    SkAutoCanvasRestore saveRestore(canvas, true /*save now, restore at exit*/);
+
+    std::vector<int> ops;
+    if (bbh) {
+        bbh->search(canvas->getLocalClipBounds(), &ops);
+    } else {
+        ops.resize(record.count());
+        for (int i = 0; i < record.count(); i++) {
+            ops[i] = i;
+        }
+    }
+
+    // Walk back to front, remembering the device pixels that later ops are sure to replace.
+    // That only works out exactly if rects stay rects and the clip is a rect that fully covers or
+    // misses each pixel.  A clip shader makes the clip complex, so it falls back too.  Otherwise
+    // we just draw everything.
+    static constexpr int kMaxOccluders = 16;
+    SkIRect occluders[kMaxOccluders];
+    int occluderCount = 0;
+    std::vector<bool> skip(ops.size(), false);
+    int skipped = 0;
+
+    const SkMatrix ctm = canvas->getLocalToDeviceAs3x3();
+    if (ctm.rectStaysRect() && canvas->isClipRect() && !SkCanvasPriv::IsClipAA(canvas)) {
+        for (int k = (int)ops.size(); k --> 0;) {
+            const int i = ops[k];
+            if (occluderCount > 0 && record.visit(i, IsSkippableDraw())) {
+                // Any pixel the op might touch.
+                const SkIRect footprint = ctm.mapRect(bounds[i]).roundOut();
+                for (int j = 0; j < occluderCount && !skip[k]; j++) {
+                    skip[k] = occluders[j].contains(footprint);
+                }
+                if (skip[k]) {
+                    skipped++;
+                    continue;
+                }
+            }
+            if (record.visit(i, MayReadOutsideBounds())) {
+                occluderCount = 0;
+                continue;
+            }
+            if (opaque[i]) {
+                // Only the pixels the op covers completely, in case it's anti-aliased.
+                const SkRect dev = ctm.mapRect(bounds[i]);
+                const SkIRect covered = {SkScalarCeilToInt (dev.fLeft),
+                                         SkScalarCeilToInt (dev.fTop),
+                                         SkScalarFloorToInt(dev.fRight),
+                                         SkScalarFloorToInt(dev.fBottom)};
+                if (covered.isEmpty()) {
+                    continue;
+                }
+                if (occluderCount < kMaxOccluders) {
+                    occluders[occluderCount++] = covered;
+                } else {
+                    // Replace the smallest occluder if this one is bigger.
+                    int smallest = 0;
+                    for (int j = 1; j < kMaxOccluders; j++) {
+                        if (occluders[j].width() * (int64_t)occluders[j].height() <
+                            occluders[smallest].width() * (int64_t)occluders[smallest].height()) {
+                            smallest = j;
+                        }
+                    }
+                    if (covered.width() * (int64_t)covered.height() >
+                        occluders[smallest].width() * (int64_t)occluders[smallest].height()) {
+                        occluders[smallest] = covered;
+                    }
+                }
+            }
+        }
+    }
+
+    SkRecords::Draw draw(canvas, drawablePicts, drawables, drawableCount);
+    for (int k = 0; k < (int)ops.size(); k++) {
+        if (callback && callback->abort()) {
+            break;
+        }
+        if (!skip[k]) {
+            record.visit(ops[k], draw);
+        }
+    }
+    return skipped;
+}
+
 void SkRecordPartialDraw(const SkRecord& record, SkCanvas* canvas,
                          SkPicture const* const drawablePicts[], int drawableCount,
                          int start, int stop,
@@ -196,10 +313,11 @@ template <> void Draw::draw(const DrawDrawable& r) {
 class FillBounds : SkNoncopyable {
 public:
     FillBounds(const SkRect& cullRect, const SkRecord& record,
-               SkRect bounds[], SkBBoxHierarchy::Metadata meta[])
+               SkRect bounds[], SkBBoxHierarchy::Metadata meta[], bool opaque[])
         : fCullRect(cullRect)
         , fBounds(bounds)
-        , fMeta(meta) {
+        , fMeta(meta)
+        , fOpaque(opaque) {
         fCTM = SkMatrix::I();
 
         // We push an extra save block to track the bounds of any top-level control operations.
@@ -264,6 +382,8 @@ private:
         Bounds bounds;         // Bounds of everything in the block.
         const SkPaint* paint;  // Unowned.  If set, adjusts the bounds of all ops in this block.
         SkMatrix ctm;
+        bool clipped = false;  // Were we clipped or in a layer when this block started?
+        bool inLayer = false;
     };
 
     // Only Restore, SetMatrix, Concat, and Translate change the CTM.
@@ -278,13 +398,14 @@ private:
 
     // The bounds of these ops must be calculated when we hit the Restore
     // from the bounds of the ops in the same Save block.
-    void trackBounds(const Save&)          { this->pushSaveBlock(nullptr); }
-    void trackBounds(const SaveLayer& op)  { this->pushSaveBlock(op.paint); }
-    void trackBounds(const SaveBehind&)    { this->pushSaveBlock(nullptr); }
+    void trackBounds(const Save&)          { this->pushSaveBlock(nullptr, false); }
+    void trackBounds(const SaveLayer& op)  { this->pushSaveBlock(op.paint, true); }
+    void trackBounds(const SaveBehind&)    { this->pushSaveBlock(nullptr, true); }
     void trackBounds(const Restore&) {
         const bool isSaveLayer = fSaveStack.back().paint != nullptr;
         fBounds[fCurrentOp] = this->popSaveBlock();
         fMeta  [fCurrentOp].isDraw = isSaveLayer;
+        this->setOpaque(fCurrentOp, false);
     }
 
     void trackBounds(const SetMatrix&)         { this->pushControl(); }
@@ -293,22 +414,40 @@ private:
     void trackBounds(const Concat44&)          { this->pushControl(); }
     void trackBounds(const Scale&)             { this->pushControl(); }
     void trackBounds(const Translate&)         { this->pushControl(); }
-    void trackBounds(const ClipRect&)          { this->pushControl(); }
-    void trackBounds(const ClipRRect&)         { this->pushControl(); }
-    void trackBounds(const ClipPath&)          { this->pushControl(); }
-    void trackBounds(const ClipRegion&)        { this->pushControl(); }
-    void trackBounds(const ClipShader&)        { this->pushControl(); }
-    void trackBounds(const ResetClip&)         { this->pushControl(); }
+    void trackBounds(const ClipRect&)          { this->pushControl(); fClipped = true; }
+    void trackBounds(const ClipRRect&)         { this->pushControl(); fClipped = true; }
+    void trackBounds(const ClipPath&)          { this->pushControl(); fClipped = true; }
+    void trackBounds(const ClipRegion&)        { this->pushControl(); fClipped = true; }
+    void trackBounds(const ClipShader&)        { this->pushControl(); fClipped = true; }
+    void trackBounds(const ResetClip&)         { this->pushControl(); fClipped = false; }
 
 
     // For all other ops, we can calculate and store the bounds directly now.
     template <typename T> void trackBounds(const T& op) {
         fBounds[fCurrentOp] = this->bounds(op);
         fMeta  [fCurrentOp].isDraw = true;
+        this->setOpaque(fCurrentOp, this->isOpaque(op));
         this->updateSaveBounds(fBounds[fCurrentOp]);
     }
 
-    void pushSaveBlock(const SkPaint* paint) {
+    // Does this op replace every pixel in its bounds?  We only look for simple unclipped fills
+    // drawn straight to the canvas, whose bounds are exactly what they cover.
+    void setOpaque(int op, bool opaque) {
+        if (fOpaque) {
+            fOpaque[op] = opaque;
+        }
+    }
+    template <typename T> bool isOpaque(const T&) const { return false; }
+    bool isOpaque(const DrawPaint& op) const { return this->isOpaque(op.paint); }
+    bool isOpaque(const DrawRect& op)  const { return this->isOpaque(op.paint); }
+    bool isOpaque(const SkPaint& paint) const {
+        return !fClipped && !fInLayer && fCTM.rectStaysRect() &&
+               paint.getStyle() == SkPaint::kFill_Style &&
+               !paint.getPathEffect() && !paint.getMaskFilter() && !paint.getImageFilter() &&
+               SkPaintPriv::Overwrites(&paint, SkPaintPriv::kNone_ShaderOverrideOpacity);
+    }
+
+    void pushSaveBlock(const SkPaint* paint, bool isLayer) {
         // Starting a new Save block.  Push a new entry to represent that.
         SaveBounds sb;
         sb.controlOps = 0;
@@ -318,6 +457,9 @@ private:
             PaintMayAffectTransparentBlack(paint) ? fCullRect : Bounds::MakeEmpty();
         sb.paint = paint;
         sb.ctm = this->fCTM;
+        sb.clipped = fClipped;
+        sb.inLayer = fInLayer;
+        fInLayer |= isLayer;
 
         fSaveStack.push_back(sb);
         this->pushControl();
@@ -366,6 +508,8 @@ private:
         // We're done the Save block.  Apply the block's bounds to all control ops inside it.
         SaveBounds sb = fSaveStack.back();
         fSaveStack.pop_back();
+        fClipped = sb.clipped;
+        fInLayer = sb.inLayer;
 
         while (sb.controlOps --> 0) {
             this->popControl(sb.bounds);
@@ -388,6 +532,7 @@ private:
     void popControl(const Bounds& bounds) {
         fBounds[fControlIndices.back()] = bounds;
         fMeta  [fControlIndices.back()].isDraw = false;
+        this->setOpaque(fControlIndices.back(), false);
         fControlIndices.pop_back();
     }
 
@@ -566,11 +711,18 @@ private:
     // Parallel array to fBounds, holding metadata for each bounds rect.
     SkBBoxHierarchy::Metadata* fMeta;
 
+    // Optional parallel array to fBounds: does each op replace every pixel in its bounds?
+    bool* fOpaque;
+
     // We walk fCurrentOp through the SkRecord,
     // as we go using updateCTM() to maintain the exact CTM (fCTM).
     int fCurrentOp;
     SkMatrix fCTM;
 
+    // Whether any clip or layer currently applies to the ops we walk through.
+    bool fClipped = false;
+    bool fInLayer = false;
+
     // Used to track the bounds of Save/Restore blocks and the control ops inside them.
     SkTDArray<SaveBounds> fSaveStack;
     SkTDArray<int>   fControlIndices;
@@ -579,9 +731,9 @@ private:
 }  // namespace SkRecords
 
 void SkRecordFillBounds(const SkRect& cullRect, const SkRecord& record,
-                        SkRect bounds[], SkBBoxHierarchy::Metadata meta[]) {
+                        SkRect bounds[], SkBBoxHierarchy::Metadata meta[], bool opaque[]) {
     {
-        SkRecords::FillBounds visitor(cullRect, record, bounds, meta);
+        SkRecords::FillBounds visitor(cullRect, record, bounds, meta, opaque);
         for (int i = 0; i < record.count(); i++) {
             visitor.setCurrentOp(i);
             record.visit(i, visitor);
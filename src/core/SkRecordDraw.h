@@ -18,8 +18,9 @@ class SkDrawable;
 class SkLayerInfo;
 
 // Calculate conservative identity space bounds for each op in the record.
+// If opaque is set, it is filled with whether each op replaces every pixel in its bounds.
 void SkRecordFillBounds(const SkRect& cullRect, const SkRecord&,
-                        SkRect bounds[], SkBBoxHierarchy::Metadata[]);
+                        SkRect bounds[], SkBBoxHierarchy::Metadata[], bool opaque[] = nullptr);
 
 // SkRecordFillBounds(), and gathers information about saveLayers and stores it for later
 // use (e.g., layer hoisting). The gathered information is sufficient to determine
@@ -32,6 +33,13 @@ void SkRecordDraw(const SkRecord&, SkCanvas*, SkPicture const* const drawablePic
                   SkDrawable* const drawables[], int drawableCount,
                   const SkBBoxHierarchy*, SkPicture::AbortCallback*);
 
+// Like SkRecordDraw(), but skips ops whose pixels later opaque draws are sure to replace.
+// bounds and opaque come from SkRecordFillBounds().  Returns the number of ops skipped.
+int SkRecordDrawWithOcclusion(const SkRecord&, SkCanvas*, SkPicture const* const drawablePicts[],
+                              SkDrawable* const drawables[], int drawableCount,
+                              const SkRect bounds[], const bool opaque[],
+                              const SkBBoxHierarchy*, SkPicture::AbortCallback*);
+
 // Draw a portion of an SkRecord into an SkCanvas.
 // When drawing a portion of an SkRecord the CTM on the passed in canvas must be
 // the composition of the replay matrix with the record-time CTM (for the portion
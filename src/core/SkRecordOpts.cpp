@@ -7,8 +7,10 @@
 
 #include "src/core/SkRecordOpts.h"
 
+#include "include/private/base/SkTArray.h"
 #include "include/private/base/SkTDArray.h"
 #include "src/core/SkCanvasPriv.h"
+#include "src/core/SkPaintPriv.h"
 #include "src/core/SkRecordPattern.h"
 #include "src/core/SkRecords.h"
 
@@ -280,6 +282,200 @@ void SkRecordMergeSvgOpacityAndFilterLayers(SkRecord* record) {
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+// A non-AA rect fill with no effects reaching outside its geometry touches exactly the pixels whose
+// centers it contains, whatever the matrix and clip are at playback.  Between two of these drawn
+// with the same matrix and clip, disjoint rects can be drawn in either order, and a later one
+// with an overwriting paint hides any earlier one it contains.
+static bool is_exact_rect_fill(const SkPaint& paint) {
+    return !paint.isAntiAlias()                         &&
+           paint.getStyle() == SkPaint::kFill_Style     &&
+           !paint.getPathEffect()                       &&
+           !paint.getMaskFilter()                       &&
+           !paint.getImageFilter();
+}
+
+// Matches a DrawRect that is_exact_rect_fill(), and stores it.
+struct IsExactRect {
+    DrawRect* fPtr = nullptr;
+
+    DrawRect* get() { return fPtr; }
+
+    bool operator()(DrawRect* draw) {
+        fPtr = is_exact_rect_fill(draw->paint) ? draw : nullptr;
+        return fPtr != nullptr;
+    }
+    template <typename T>
+    bool operator()(T*) {
+        fPtr = nullptr;
+        return false;
+    }
+};
+
+// Matches draws that only affect pixels inside the clip, so are hidden by anything covering it.
+struct IsHideableDraw {
+    template <typename T>
+    std::enable_if_t<SkToBool(T::kTags & kDraw_Tag), bool> operator()(T*) { return true; }
+    template <typename T>
+    std::enable_if_t<!(T::kTags & kDraw_Tag), bool> operator()(T*) { return false; }
+
+    // Drawables may have side effects, and DrawBehind draws under earlier content.
+    bool operator()(DrawDrawable*) { return false; }
+    bool operator()(DrawBehind*)   { return false; }
+};
+
+// Within a run of draws (no matrix, clip, or save changes between them), no-op the draws that a
+// later opaque draw completely hides: anything before an overwriting DrawPaint, and exact rect
+// fills contained in a later overwriting exact rect fill.
+struct OverdrawnDrawNooper {
+    typedef Pattern<IsDraw, Greedy<Or<Is<NoOp>, IsDraw>>> Match;
+
+    // Only look back this far for rects that hide earlier rects.
+    static constexpr int kMaxOccluders = 16;
+
+    bool onMatch(SkRecord* record, Match*, int begin, int end) {
+        bool changed = false;
+        bool clipCovered = false;
+        SkRect occluders[kMaxOccluders];
+        int occluderCount = 0;
+
+        for (int i = end; i --> begin;) {
+            if (clipCovered) {
+                if (record->mutate(i, IsHideableDraw())) {
+                    record->replace<NoOp>(i);
+                    changed = true;
+                }
+                continue;
+            }
+
+            Is<DrawPaint> drawPaint;
+            if (record->mutate(i, drawPaint)) {
+                const SkPaint& paint = drawPaint.get()->paint;
+                clipCovered = !paint.getImageFilter() && !paint.getMaskFilter() &&
+                              SkPaintPriv::Overwrites(&paint,
+                                                      SkPaintPriv::kNone_ShaderOverrideOpacity);
+                continue;
+            }
+
+            IsExactRect exactRect;
+            if (!record->mutate(i, exactRect)) {
+                continue;
+            }
+            const SkRect rect = exactRect.get()->rect.makeSorted();
+            bool hidden = false;
+            for (int j = 0; j < std::min(occluderCount, kMaxOccluders) && !hidden; j++) {
+                hidden = occluders[j].contains(rect);
+            }
+            if (hidden) {
+                record->replace<NoOp>(i);
+                changed = true;
+            } else if (SkPaintPriv::Overwrites(&exactRect.get()->paint,
+                                               SkPaintPriv::kNone_ShaderOverrideOpacity)) {
+                // Once full, replace the oldest (i.e. closest to the end) occluder.
+                occluders[occluderCount++ % kMaxOccluders] = rect;
+            }
+        }
+        return changed;
+    }
+};
+
+// Matches clips that may only partially cover some pixels.
+struct IsSoftClip {
+    bool operator()(ClipRect* op)  { return op->opAA.aa(); }
+    bool operator()(ClipRRect* op) { return op->opAA.aa(); }
+    bool operator()(ClipPath* op)  { return op->opAA.aa(); }
+    bool operator()(ClipShader*)   { return true; }
+    template <typename T>
+    bool operator()(T*) { return false; }
+};
+
+void SkRecordNoopOverdrawnDraws(SkRecord* record) {
+    // Soft clips blend the edge pixels of every draw, so nothing is truly hidden there.
+    for (int i = 0; i < record->count(); i++) {
+        if (record->mutate(i, IsSoftClip())) {
+            return;
+        }
+    }
+
+    OverdrawnDrawNooper pass;
+    apply(&pass, record);
+}
+
+// Within a run of draws, move exact rect fills that share a paint next to each other, so the
+// canvas we play back into sees them back to back and can batch them (e.g. GPU op chaining).
+// A later rect may be pulled forward only past other exact rect fills it does not overlap; any
+// other kind of draw ends the run.
+struct RectBatcher {
+    // We match just the first rect, so that any rects left behind start their own batches.
+    typedef Pattern<IsExactRect> Match;
+
+    // Bound the work spent searching for rects to pull forward.
+    static constexpr int kMaxLookahead = 256;
+
+    bool onMatch(SkRecord* record, Match* match, int begin, int end) {
+        const SkPaint& paint = match->first<DrawRect>()->paint;
+
+        // If the previous draw shares our paint, we were already gathered into its batch.
+        if (begin > 0) {
+            IsExactRect prev;
+            if (record->mutate(begin - 1, prev) && prev.get()->paint == paint) {
+                return false;
+            }
+        }
+
+        SkTArray<DrawRect> batch, skipped;
+        SkTDArray<SkRect> skippedBounds;
+        batch.push_back({paint, match->first<DrawRect>()->rect});
+
+        const int stop = std::min(record->count(), begin + kMaxLookahead);
+        int i = end;
+        for (; i < stop; i++) {
+            if (record->mutate(i, Is<NoOp>())) {
+                continue;
+            }
+            IsExactRect exactRect;
+            if (!record->mutate(i, exactRect)) {
+                break;
+            }
+            const DrawRect& draw = *exactRect.get();
+            const SkRect rect = draw.rect.makeSorted();
+            bool blocked = draw.paint != paint;
+            for (int j = 0; j < skippedBounds.size() && !blocked; j++) {
+                blocked = SkRect::Intersects(rect, skippedBounds[j]);
+            }
+            if (blocked) {
+                skipped.push_back(draw);
+                skippedBounds.push_back(rect);
+            } else {
+                batch.push_back(draw);
+            }
+        }
+
+        if (skipped.empty()) {
+            return false;  // Nothing to move.
+        }
+
+        // Rewrite [begin, i) as the batch, then the rects we skipped over in their original
+        // order, then no-ops.
+        int next = begin;
+        for (SkTArray<DrawRect>* draws : {&batch, &skipped}) {
+            for (DrawRect& draw : *draws) {
+                new (record->replace<DrawRect>(next++)) DrawRect{std::move(draw.paint), draw.rect};
+            }
+        }
+        for (; next < i; next++) {
+            record->replace<NoOp>(next);
+        }
+        return true;
+    }
+};
+
+void SkRecordBatchRects(SkRecord* record) {
+    RectBatcher pass;
+    apply(&pass, record);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
 void SkRecordOptimize(SkRecord* record) {
     // This might be useful  as a first pass in the future if we want to weed
     // out junk for other optimization passes.  Right now, nothing needs it,
@@ -297,6 +493,8 @@ void SkRecordOptimize(SkRecord* record) {
     SkRecordNoopSaveLayerDrawRestores(record);
 #endif
     SkRecordMergeSvgOpacityAndFilterLayers(record);
+    SkRecordNoopOverdrawnDraws(record);
+    SkRecordBatchRects(record);
 
     record->defrag();
 }
@@ -309,6 +507,8 @@ void SkRecordOptimize2(SkRecord* record) {
     SkRecordNoopSaveLayerDrawRestores(record);
 #endif
     SkRecordMergeSvgOpacityAndFilterLayers(record);
+    SkRecordNoopOverdrawnDraws(record);
+    SkRecordBatchRects(record);
 
     record->defrag();
 }
@@ -26,6 +26,15 @@ void SkRecordNoopSaveLayerDrawRestores(SkRecord*);
 // the alpha of the first SaveLayer to the second SaveLayer.
 void SkRecordMergeSvgOpacityAndFilterLayers(SkRecord*);
 
+// Within runs of draws, no-op draws completely hidden by a later opaque DrawPaint, and non-AA
+// rect fills contained in a later opaque non-AA rect fill. Does nothing if the record has any
+// anti-aliased clips or clip shaders, which would blend the hidden draws into edge pixels.
+void SkRecordNoopOverdrawnDraws(SkRecord*);
+
+// Reorders non-AA rect fills so those sharing a paint are drawn back to back, pulling later rects
+// forward past other rect fills they don't overlap.
+void SkRecordBatchRects(SkRecord*);
+
 // Experimental optimizers
 void SkRecordOptimize2(SkRecord*);
 
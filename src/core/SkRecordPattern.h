@@ -156,7 +156,7 @@ private:
         return 0;
     }
 
-    // If first is a Greedy, walk i until it doesn't match.
+    // If first is a Greedy, walk i until it doesn't match or we run out of record.
     template <typename T>
     int matchFirst(Greedy<T>* first, SkRecord* record, int i) {
         while (i < record->count()) {
@@ -165,7 +165,7 @@ private:
             }
             i++;
         }
-        return 0;
+        return i;
     }
 
     First            fFirst;
@@ -39,6 +39,11 @@ static inline bool SkShouldPostMessageToBus(
     #define SK_DEFAULT_IMAGE_CACHE_LIMIT     (32 * 1024 * 1024)
 #endif
 
+// How many independently locked shards the global cache is split into.
+#ifndef SK_RESOURCE_CACHE_SHARD_COUNT
+    #define SK_RESOURCE_CACHE_SHARD_COUNT    1
+#endif
+
 void SkResourceCache::Key::init(void* nameSpace, uint64_t sharedID, size_t dataSize) {
     SkASSERT(SkAlign4(dataSize) == dataSize);
 
@@ -452,93 +457,216 @@ void SkResourceCache::checkMessages() {
 
 ///////////////////////////////////////////////////////////////////////////////
 
-static SkResourceCache* gResourceCache = nullptr;
-static SkMutex& resource_cache_mutex() {
-    static SkMutex& mutex = *(new SkMutex);
-    return mutex;
+// Padded out to a cache line so neighbouring shard locks don't false-share.
+struct alignas(64) SkShardedResourceCache::Shard {
+    SkMutex                          fMutex;
+    std::unique_ptr<SkResourceCache> fCache;
+};
+
+// Shard i's share of a total byte limit.  The shares add back up to the total.
+static size_t shard_byte_limit(size_t total, int i, int shardCount) {
+    return total / shardCount + ((size_t)i < total % shardCount ? 1 : 0);
+}
+
+SkShardedResourceCache::SkShardedResourceCache(int shardCount, DiscardableFactory factory)
+        : fShards(new Shard[SkTPin(shardCount, 1, kMaxShards)])
+        , fShardCount(SkTPin(shardCount, 1, kMaxShards))
+        , fDiscardableFactory(factory) {
+    for (int i = 0; i < fShardCount; ++i) {
+        fShards[i].fCache = std::make_unique<SkResourceCache>(factory);
+    }
+}
+
+SkShardedResourceCache::SkShardedResourceCache(int shardCount, size_t byteLimit)
+        : fShards(new Shard[SkTPin(shardCount, 1, kMaxShards)])
+        , fShardCount(SkTPin(shardCount, 1, kMaxShards))
+        , fDiscardableFactory(nullptr) {
+    for (int i = 0; i < fShardCount; ++i) {
+        fShards[i].fCache = std::make_unique<SkResourceCache>(
+                shard_byte_limit(byteLimit, i, fShardCount));
+    }
+}
+
+SkShardedResourceCache::~SkShardedResourceCache() = default;
+
+SkShardedResourceCache::Shard& SkShardedResourceCache::shardFor(const Key& key) const {
+    return fShards[key.hash() % fShardCount];
+}
+
+bool SkShardedResourceCache::find(const Key& key, FindVisitor visitor, void* context) {
+    Shard& shard = this->shardFor(key);
+    SkAutoMutexExclusive am(shard.fMutex);
+    return shard.fCache->find(key, visitor, context);
+}
+
+void SkShardedResourceCache::add(Rec* rec, void* payload) {
+    Shard& shard = this->shardFor(rec->getKey());
+    SkAutoMutexExclusive am(shard.fMutex);
+    shard.fCache->add(rec, payload);
 }
 
-/** Must hold resource_cache_mutex() when calling. */
-static SkResourceCache* get_cache() {
-    // resource_cache_mutex() is always held when this is called, so we don't need to be fancy in here.
-    resource_cache_mutex().assertHeld();
-    if (nullptr == gResourceCache) {
+void SkShardedResourceCache::visitAll(Visitor visitor, void* context) {
+    for (int i = 0; i < fShardCount; ++i) {
+        SkAutoMutexExclusive am(fShards[i].fMutex);
+        fShards[i].fCache->visitAll(visitor, context);
+    }
+}
+
+size_t SkShardedResourceCache::getTotalBytesUsed() const {
+    size_t used = 0;
+    for (int i = 0; i < fShardCount; ++i) {
+        SkAutoMutexExclusive am(fShards[i].fMutex);
+        used += fShards[i].fCache->getTotalBytesUsed();
+    }
+    return used;
+}
+
+size_t SkShardedResourceCache::getTotalByteLimit() const {
+    size_t limit = 0;
+    for (int i = 0; i < fShardCount; ++i) {
+        SkAutoMutexExclusive am(fShards[i].fMutex);
+        limit += fShards[i].fCache->getTotalByteLimit();
+    }
+    return limit;
+}
+
+size_t SkShardedResourceCache::setTotalByteLimit(size_t newLimit) {
+    SkAutoMutexExclusive limitLock(fLimitMutex);
+    size_t prevLimit = 0;
+    for (int i = 0; i < fShardCount; ++i) {
+        SkAutoMutexExclusive am(fShards[i].fMutex);
+        prevLimit += fShards[i].fCache->setTotalByteLimit(
+                shard_byte_limit(newLimit, i, fShardCount));
+    }
+    return prevLimit;
+}
+
+size_t SkShardedResourceCache::setSingleAllocationByteLimit(size_t newLimit) {
+    SkAutoMutexExclusive limitLock(fLimitMutex);
+    size_t prevLimit = 0;
+    for (int i = 0; i < fShardCount; ++i) {
+        SkAutoMutexExclusive am(fShards[i].fMutex);
+        prevLimit = fShards[i].fCache->setSingleAllocationByteLimit(newLimit);
+    }
+    return prevLimit;
+}
+
+size_t SkShardedResourceCache::getSingleAllocationByteLimit() const {
+    SkAutoMutexExclusive am(fShards[0].fMutex);
+    return fShards[0].fCache->getSingleAllocationByteLimit();
+}
+
+size_t SkShardedResourceCache::getEffectiveSingleAllocationByteLimit() const {
+    // Same as SkResourceCache's, but pinned against the whole budget rather than one shard's.
+    size_t limit = this->getSingleAllocationByteLimit();
+    if (nullptr == fDiscardableFactory) {
+        size_t total = this->getTotalByteLimit();
+        limit = 0 == limit ? total : std::min(limit, total);
+    }
+    return limit;
+}
+
+void SkShardedResourceCache::purgeAll() {
+    for (int i = 0; i < fShardCount; ++i) {
+        SkAutoMutexExclusive am(fShards[i].fMutex);
+        fShards[i].fCache->purgeAll();
+    }
+}
+
+void SkShardedResourceCache::checkMessages() {
+    for (int i = 0; i < fShardCount; ++i) {
+        SkAutoMutexExclusive am(fShards[i].fMutex);
+        fShards[i].fCache->checkMessages();
+    }
+}
+
+SkCachedData* SkShardedResourceCache::newCachedData(size_t bytes) const {
+    // This only allocates, so it needs no lock.  Each shard polls for purge messages on its own
+    // find() and add().
+    if (fDiscardableFactory) {
+        SkDiscardableMemory* dm = fDiscardableFactory(bytes);
+        return dm ? new SkCachedData(bytes, dm) : nullptr;
+    } else {
+        return new SkCachedData(sk_malloc_throw(bytes), bytes);
+    }
+}
+
+void SkShardedResourceCache::dump() const {
+    for (int i = 0; i < fShardCount; ++i) {
+        SkAutoMutexExclusive am(fShards[i].fMutex);
+        fShards[i].fCache->dump();
+    }
+    if (fShardCount > 1) {
+        SkDebugf("SkShardedResourceCache: shards=%d bytes=%zu\n",
+                 fShardCount, this->getTotalBytesUsed());
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static SkShardedResourceCache* get_cache() {
+    static SkShardedResourceCache* gResourceCache =
 #ifdef SK_USE_DISCARDABLE_SCALEDIMAGECACHE
-        gResourceCache = new SkResourceCache(SkDiscardableMemory::Create);
+            new SkShardedResourceCache(SK_RESOURCE_CACHE_SHARD_COUNT, SkDiscardableMemory::Create);
 #else
-        gResourceCache = new SkResourceCache(SK_DEFAULT_IMAGE_CACHE_LIMIT);
+            new SkShardedResourceCache(SK_RESOURCE_CACHE_SHARD_COUNT, SK_DEFAULT_IMAGE_CACHE_LIMIT);
 #endif
-    }
     return gResourceCache;
 }
 
 size_t SkResourceCache::GetTotalBytesUsed() {
-    SkAutoMutexExclusive am(resource_cache_mutex());
     return get_cache()->getTotalBytesUsed();
 }
 
 size_t SkResourceCache::GetTotalByteLimit() {
-    SkAutoMutexExclusive am(resource_cache_mutex());
     return get_cache()->getTotalByteLimit();
 }
 
 size_t SkResourceCache::SetTotalByteLimit(size_t newLimit) {
-    SkAutoMutexExclusive am(resource_cache_mutex());
     return get_cache()->setTotalByteLimit(newLimit);
 }
 
 SkResourceCache::DiscardableFactory SkResourceCache::GetDiscardableFactory() {
-    SkAutoMutexExclusive am(resource_cache_mutex());
     return get_cache()->discardableFactory();
 }
 
 SkCachedData* SkResourceCache::NewCachedData(size_t bytes) {
-    SkAutoMutexExclusive am(resource_cache_mutex());
     return get_cache()->newCachedData(bytes);
 }
 
 void SkResourceCache::Dump() {
-    SkAutoMutexExclusive am(resource_cache_mutex());
     get_cache()->dump();
 }
 
 size_t SkResourceCache::SetSingleAllocationByteLimit(size_t size) {
-    SkAutoMutexExclusive am(resource_cache_mutex());
     return get_cache()->setSingleAllocationByteLimit(size);
 }
 
 size_t SkResourceCache::GetSingleAllocationByteLimit() {
-    SkAutoMutexExclusive am(resource_cache_mutex());
     return get_cache()->getSingleAllocationByteLimit();
 }
 
 size_t SkResourceCache::GetEffectiveSingleAllocationByteLimit() {
-    SkAutoMutexExclusive am(resource_cache_mutex());
     return get_cache()->getEffectiveSingleAllocationByteLimit();
 }
 
 void SkResourceCache::PurgeAll() {
-    SkAutoMutexExclusive am(resource_cache_mutex());
     return get_cache()->purgeAll();
 }
 
 void SkResourceCache::CheckMessages() {
-    SkAutoMutexExclusive am(resource_cache_mutex());
     return get_cache()->checkMessages();
 }
 
 bool SkResourceCache::Find(const Key& key, FindVisitor visitor, void* context) {
-    SkAutoMutexExclusive am(resource_cache_mutex());
     return get_cache()->find(key, visitor, context);
 }
 
 void SkResourceCache::Add(Rec* rec, void* payload) {
-    SkAutoMutexExclusive am(resource_cache_mutex());
     get_cache()->add(rec, payload);
 }
 
 void SkResourceCache::VisitAll(Visitor visitor, void* context) {
-    SkAutoMutexExclusive am(resource_cache_mutex());
     get_cache()->visitAll(visitor, context);
 }
 
@@ -9,9 +9,12 @@
 #define SkResourceCache_DEFINED
 
 #include "include/core/SkBitmap.h"
+#include "include/private/base/SkMutex.h"
 #include "include/private/base/SkTDArray.h"
 #include "src/core/SkMessageBus.h"
 
+#include <memory>
+
 class SkCachedData;
 class SkDiscardableMemory;
 class SkTraceMemoryDump;
@@ -25,6 +28,7 @@ class SkTraceMemoryDump;
  *
  *  As a convenience, a global instance is also defined, which can be safely
  *  access across threads via the static methods (e.g. FindAndLock, etc.).
+ *  That global instance is an SkShardedResourceCache.
  */
 class SkResourceCache {
 public:
@@ -284,10 +288,73 @@ private:
 
     void init();    // called by constructors
 
+    friend class SkShardedResourceCache;
+
 #ifdef SK_DEBUG
     void validate() const;
 #else
     void validate() const {}
 #endif
 };
+
+/**
+ *  A thread-safe cache made of independent SkResourceCache shards. Each Key is routed to a shard
+ *  by its hash, and each shard has its own lock, its own LRU list and an equal share of the byte
+ *  budget, so threads working on different keys rarely contend.
+ *
+ *  The global cache behind SkResourceCache's static methods is one of these, with
+ *  SK_RESOURCE_CACHE_SHARD_COUNT shards (1 unless the build defines it otherwise).
+ *  Note that LRU order is only kept per shard, and in discardable mode each shard applies the
+ *  discardable count limit on its own.
+ */
+class SkShardedResourceCache {
+public:
+    using Key                = SkResourceCache::Key;
+    using Rec                = SkResourceCache::Rec;
+    using FindVisitor        = SkResourceCache::FindVisitor;
+    using Visitor            = SkResourceCache::Visitor;
+    using DiscardableFactory = SkResourceCache::DiscardableFactory;
+
+    static constexpr int kMaxShards = 64;
+
+    SkShardedResourceCache(int shardCount, DiscardableFactory);
+    SkShardedResourceCache(int shardCount, size_t byteLimit);
+    ~SkShardedResourceCache();
+
+    int shardCount() const { return fShardCount; }
+
+    bool find(const Key&, FindVisitor, void* context);
+    void add(Rec*, void* payload = nullptr);
+    // Visits each shard in turn, holding only that shard's lock.
+    void visitAll(Visitor, void* context);
+
+    // These sum over all shards.
+    size_t getTotalBytesUsed() const;
+    size_t getTotalByteLimit() const;
+    // Splits the new limit evenly between the shards, and returns the previous total.
+    size_t setTotalByteLimit(size_t newLimit);
+
+    size_t setSingleAllocationByteLimit(size_t);
+    size_t getSingleAllocationByteLimit() const;
+    size_t getEffectiveSingleAllocationByteLimit() const;
+
+    void purgeAll();
+    void checkMessages();
+
+    DiscardableFactory discardableFactory() const { return fDiscardableFactory; }
+    SkCachedData* newCachedData(size_t bytes) const;
+
+    void dump() const;
+
+private:
+    struct Shard;
+
+    Shard& shardFor(const Key&) const;
+
+    std::unique_ptr<Shard[]> fShards;
+    const int                fShardCount;
+    DiscardableFactory       fDiscardableFactory;
+    SkMutex                  fLimitMutex;  // Serializes the limit setters.
+};
+
 #endif
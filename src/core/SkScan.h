@@ -16,6 +16,7 @@
 class SkRasterClip;
 class SkRegion;
 class SkBlitter;
+class SkExecutor;
 class SkPath;
 
 /** Defines a fixed-point rectangle, identical to the integer SkIRect, but its
@@ -26,6 +27,10 @@ typedef SkIRect SkXRect;
 extern std::atomic<bool> gSkUseAnalyticAA;
 extern std::atomic<bool> gSkForceAnalyticAA;
 
+// If set, anti-aliased fills of huge paths are scan converted in bands on this executor.
+// See SkGraphics::SetPathFillExecutor().
+extern std::atomic<SkExecutor*> gSkAntiFillPathExecutor;
+
 class AdditiveBlitter;
 
 class SkScan {
@@ -56,6 +61,10 @@ public:
     static void AntiFillXRect(const SkXRect&, const SkRasterClip&, SkBlitter*);
     static void FillPath(const SkPath&, const SkRasterClip&, SkBlitter*);
     static void AntiFillPath(const SkPath&, const SkRasterClip&, SkBlitter*);
+    // Like AntiFillPath(), but huge paths are filled in bands on bandExecutor, if not null,
+    // rather than on gSkAntiFillPathExecutor.
+    static void AntiFillPathForTesting(const SkPath&, const SkRasterClip&, SkBlitter*,
+                                       SkExecutor* bandExecutor);
     static void FrameRect(const SkRect&, const SkPoint& strokeSize,
                           const SkRasterClip&, SkBlitter*);
     static void AntiFrameRect(const SkRect&, const SkPoint& strokeSize,
@@ -85,6 +94,10 @@ private:
     static void AntiFillRect(const SkRect&, const SkRegion* clip, SkBlitter*);
     static void AntiFillXRect(const SkXRect&, const SkRegion*, SkBlitter*);
     static void AntiFillPath(const SkPath&, const SkRegion& clip, SkBlitter*, bool forceRLE);
+    static void AntiFillPath(const SkPath&, const SkRegion& clip, SkBlitter*, bool forceRLE,
+                             SkExecutor* bandExecutor);
+    static void AntiFillPath(const SkPath&, const SkRasterClip&, SkBlitter*,
+                             SkExecutor* bandExecutor);
     static void FillTriangle(const SkPoint pts[], const SkRegion*, SkBlitter*);
 
     static void AntiFrameRect(const SkRect&, const SkPoint& strokeSize,
@@ -95,6 +108,9 @@ private:
                             const SkIRect& clipBounds, bool forceRLE);
     static void SAAFillPath(const SkPath& path, SkBlitter* blitter, const SkIRect& pathIR,
                             const SkIRect& clipBounds, bool forceRLE);
+    // Fills a huge, non-inverse path over fillIR in bands, on executor.
+    static void AntiFillPathInBands(const SkPath& path, SkBlitter* blitter, const SkIRect& fillIR,
+                                    bool useAAA, SkExecutor* executor);
 };
 
 /** Assign an SkXRect from a SkIRect, by promoting the src rect's coordinates
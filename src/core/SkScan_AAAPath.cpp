@@ -758,23 +758,20 @@ static void blit_aaa_trapezoid_row(AdditiveBlitter* blitter,
     }
 
     const int kQuickLen = 31;
-    char      quickMemory[(sizeof(SkAlpha) * 2 + sizeof(int16_t)) * (kQuickLen + 1)];
+    SkAlpha   quickMemory[2 * (kQuickLen + 1)];
     SkAlpha*  alphas;
 
     if (len <= kQuickLen) {
-        alphas = (SkAlpha*)quickMemory;
+        alphas = quickMemory;
     } else {
-        alphas = new SkAlpha[(len + 1) * (sizeof(SkAlpha) * 2 + sizeof(int16_t))];
+        alphas = new SkAlpha[2 * (len + 1)];
     }
 
     SkAlpha* tempAlphas = alphas + len + 1;
-    int16_t* runs       = (int16_t*)(alphas + (len + 1) * 2);
 
     for (int i = 0; i < len; ++i) {
-        runs[i]   = 1;
         alphas[i] = fullAlpha;
     }
-    runs[len] = 0;
 
     int uL = SkFixedFloorToInt(ul);
     int lL = SkFixedCeilToInt(ll);
@@ -828,8 +825,9 @@ static void blit_aaa_trapezoid_row(AdditiveBlitter* blitter,
         }
     } else {
         if (fullAlpha == 0xFF && !noRealBlitter) {
-            // Real blitter is faster than RunBasedAdditiveBlitter
-            blitter->getRealBlitter()->blitAntiH(L, y, alphas, runs);
+            // Real blitter is faster than RunBasedAdditiveBlitter, and every pixel has its own
+            // alpha, so hand it the whole row at once.
+            blitter->getRealBlitter()->blitAntiHRow(L, y, alphas, len);
         } else {
             blitter->blitAntiH(L, y, alphas, len);
         }
@@ -7,13 +7,21 @@
 
 #include "src/core/SkScanPriv.h"
 
+#include "include/core/SkExecutor.h"
 #include "include/core/SkMatrix.h"
 #include "include/core/SkPath.h"
+#include "include/core/SkPathBuilder.h"
 #include "include/core/SkRegion.h"
+#include "include/private/base/SkTArray.h"
+#include "include/private/base/SkTemplates.h"
 #include "include/private/base/SkTo.h"
 #include "src/core/SkAntiRun.h"
 #include "src/core/SkBlitter.h"
+#include "src/core/SkMask.h"
 #include "src/core/SkPathPriv.h"
+#include "src/core/SkTaskGroup.h"
+
+#include <cstring>
 
 #define SHIFT   SK_SUPERSAMPLE_SHIFT
 #define SCALE   (1 << SHIFT)
@@ -664,8 +672,226 @@ static int rect_overflows_short_shift(SkIRect rect, int shift) {
            overflows_short_shift(rect.fBottom, shift);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+
+// Huge paths (maps, plots, traced outlines) can be scan converted in horizontal bands, one task
+// per band, when the client has given us an executor (see SkGraphics::SetPathFillExecutor()).
+// Each band gets a path made of just the contours that reach its rows, which the usual AAA or
+// supersampling code clips to the band while building edges. Coverage goes into a per-band A8
+// mask, and only the calling thread ever touches the real blitter, blitting finished bands in
+// order, so blitters need not be thread-safe. The calling thread scan converts bands too and
+// never waits on tasks still queued, so drawing on one of the executor's threads can't deadlock.
+static constexpr int kMinBandedPathPoints = 1 << 16;
+static constexpr int kBandHeight          = 64;
+static constexpr int kBandsPerWave        = 16;   // Bounds the memory used for band masks.
+
+namespace {
+
+// Records coverage into an A8 mask covering one band. Each pixel is written at most once.
+class BandMaskBlitter final : public SkBlitter {
+public:
+    explicit BandMaskBlitter(const SkMask& mask) : fMask(mask), fDirty(SkIRect::MakeEmpty()) {}
+
+    // The part of the mask that holds any coverage.
+    const SkIRect& dirtyBounds() const { return fDirty; }
+
+    void blitH(int x, int y, int width) override {
+        this->fill(x, y, width, 1, 0xFF);
+    }
+
+    void blitAntiH(int x, int y, const SkAlpha antialias[], const int16_t runs[]) override {
+        for (int n = runs[0]; n > 0; n = runs[0]) {
+            if (antialias[0]) {
+                this->fill(x, y, n, 1, antialias[0]);
+            }
+            x += n;
+            runs += n;
+            antialias += n;
+        }
+    }
+
+    void blitV(int x, int y, int height, SkAlpha alpha) override {
+        if (alpha) {
+            this->fill(x, y, 1, height, alpha);
+        }
+    }
+
+    void blitRect(int x, int y, int width, int height) override {
+        this->fill(x, y, width, height, 0xFF);
+    }
+
+    void blitMask(const SkMask& mask, const SkIRect& clip) override {
+        if (mask.fFormat != SkMask::kA8_Format) {
+            this->INHERITED::blitMask(mask, clip);
+            return;
+        }
+        SkASSERT(fMask.fBounds.contains(clip));
+        for (int y = clip.fTop; y < clip.fBottom; ++y) {
+            memcpy(fMask.getAddr8(clip.fLeft, y), mask.getAddr8(clip.fLeft, y), clip.width());
+        }
+        fDirty.join(clip);
+    }
+
+private:
+    void fill(int x, int y, int width, int height, SkAlpha alpha) {
+        SkASSERT(fMask.fBounds.contains(SkIRect::MakeXYWH(x, y, width, height)));
+        for (int i = 0; i < height; ++i) {
+            memset(fMask.getAddr8(x, y + i), alpha, width);
+        }
+        fDirty.join(SkIRect::MakeXYWH(x, y, width, height));
+    }
+
+    const SkMask fMask;
+    SkIRect      fDirty;
+
+    using INHERITED = SkBlitter;
+};
+
+// A contour's verbs, points and weights within its path, and the bands its bounds reach.
+struct BandedContour {
+    const uint8_t*  fVerbs;
+    const uint8_t*  fVerbsEnd;
+    const SkPoint*  fPoints;
+    const SkScalar* fWeights;
+    int             fFirstBand;
+    int             fLastBand;
+};
+
+}  // namespace
+
+static bool should_fill_in_bands(const SkPath& path, const SkIRect& fillIR,
+                                 SkExecutor* executor) {
+    return executor != nullptr &&
+           !path.isInverseFillType() &&
+           path.countPoints() >= kMinBandedPathPoints &&
+           fillIR.height() >= 2 * kBandHeight;
+}
+
+// Returns the contours of path that reach the rows of fillIR, each tagged with its bands. A
+// contour entirely above or below those rows adds no winding to them, so bands can skip it.
+static SkTArray<BandedContour> bin_contours(const SkPath& path, const SkIRect& fillIR,
+                                          int bandCount) {
+    SkTArray<BandedContour> contours;
+
+    const uint8_t*  verbs     = SkPathPriv::VerbData(path);
+    const uint8_t*  verbsStop = verbs + path.countVerbs();
+    const SkPoint*  pts       = SkPathPriv::PointData(path);
+    const SkScalar* weights   = SkPathPriv::ConicWeightData(path);
+
+    while (verbs < verbsStop) {
+        // Every contour starts with a move.
+        SkASSERT(*verbs == SkPath::kMove_Verb);
+        BandedContour contour = {verbs, nullptr, pts, weights, 0, 0};
+        SkScalar top    = pts->fY,
+                 bottom = pts->fY;
+        bool hasEdges = false;
+        do {
+            const unsigned verb = *verbs++;
+            const int count = SkPathPriv::PtsInVerb(verb);
+            for (int i = 0; i < count; ++i) {
+                top    = std::min(top,    pts[i].fY);
+                bottom = std::max(bottom, pts[i].fY);
+            }
+            pts += count;
+            weights += (verb == SkPath::kConic_Verb) ? 1 : 0;
+            hasEdges |= count > 0 && verb != SkPath::kMove_Verb;
+        } while (verbs < verbsStop && *verbs != SkPath::kMove_Verb);
+        contour.fVerbsEnd = verbs;
+
+        // Allow a pixel either side for rounding out.
+        if (!hasEdges || bottom + 1 < fillIR.fTop || top - 1 > fillIR.fBottom) {
+            continue;
+        }
+        contour.fFirstBand = SkTPin(SkScalarFloorToInt((top    - 1 - fillIR.fTop) / kBandHeight),
+                                    0, bandCount - 1);
+        contour.fLastBand  = SkTPin(SkScalarFloorToInt((bottom + 1 - fillIR.fTop) / kBandHeight),
+                                    0, bandCount - 1);
+        contours.push_back(contour);
+    }
+    return contours;
+}
+
+static SkPath band_path(const SkPath& path, const SkTArray<BandedContour>& contours, int band) {
+    SkPathBuilder builder(path.getFillType());
+    for (const BandedContour& contour : contours) {
+        if (band < contour.fFirstBand || band > contour.fLastBand) {
+            continue;
+        }
+        for (auto [verb, pts, w] : SkPathPriv::Iterate(contour.fVerbs, contour.fVerbsEnd,
+                                                       contour.fPoints, contour.fWeights)) {
+            switch (verb) {
+                case SkPathVerb::kMove:  builder.moveTo(pts[0]);                  break;
+                case SkPathVerb::kLine:  builder.lineTo(pts[1]);                  break;
+                case SkPathVerb::kQuad:  builder.quadTo(pts[1], pts[2]);          break;
+                case SkPathVerb::kConic: builder.conicTo(pts[1], pts[2], *w);     break;
+                case SkPathVerb::kCubic: builder.cubicTo(pts[1], pts[2], pts[3]); break;
+                case SkPathVerb::kClose: builder.close();                         break;
+            }
+        }
+    }
+    return builder.detach();
+}
+
+void SkScan::AntiFillPathInBands(const SkPath& path, SkBlitter* blitter, const SkIRect& fillIR,
+                                 bool useAAA, SkExecutor* executor) {
+    SkASSERT(executor);
+
+    const int bandCount = (fillIR.height() + kBandHeight - 1) / kBandHeight;
+    const SkTArray<BandedContour> contours = bin_contours(path, fillIR, bandCount);
+
+    const size_t rowBytes  = fillIR.width();
+    const size_t bandBytes = rowBytes * kBandHeight;
+    skia_private::AutoTMalloc<uint8_t> storage(bandBytes * std::min(bandCount, kBandsPerWave));
+
+    for (int firstBand = 0; firstBand < bandCount; firstBand += kBandsPerWave) {
+        const int waveBands = std::min(kBandsPerWave, bandCount - firstBand);
+        SkMask  masks[kBandsPerWave];
+        SkIRect dirty[kBandsPerWave];
+
+        SkTaskGroup::BatchAndJoin(*executor, waveBands, [&](int i) {
+            const int band = firstBand + i,
+                      top  = fillIR.fTop + band * kBandHeight;
+
+            SkMask& mask = masks[i];
+            mask.fImage    = storage.get() + i * bandBytes;
+            mask.fBounds   = {fillIR.fLeft, top,
+                              fillIR.fRight, std::min(top + kBandHeight, fillIR.fBottom)};
+            mask.fRowBytes = SkToU32(rowBytes);
+            mask.fFormat   = SkMask::kA8_Format;
+            dirty[i].setEmpty();
+
+            SkPath bandPath = band_path(path, contours, band);
+            SkIRect bandIR = safeRoundOut(bandPath.getBounds());
+            if (bandIR.isEmpty() || !SkIRect::Intersects(bandIR, mask.fBounds)) {
+                return;
+            }
+
+            sk_bzero(mask.fImage, rowBytes * mask.fBounds.height());
+            BandMaskBlitter bandBlitter(mask);
+            if (useAAA) {
+                SkScan::AAAFillPath(bandPath, &bandBlitter, bandIR, mask.fBounds, false);
+            } else {
+                SkScan::SAAFillPath(bandPath, &bandBlitter, bandIR, mask.fBounds, false);
+            }
+            dirty[i] = bandBlitter.dirtyBounds();
+        });
+
+        for (int i = 0; i < waveBands; ++i) {
+            if (!dirty[i].isEmpty()) {
+                blitter->blitMask(masks[i], dirty[i]);
+            }
+        }
+    }
+}
+
 void SkScan::AntiFillPath(const SkPath& path, const SkRegion& origClip,
                           SkBlitter* blitter, bool forceRLE) {
+    AntiFillPath(path, origClip, blitter, forceRLE,
+                 gSkAntiFillPathExecutor.load(std::memory_order_relaxed));
+}
+
+void SkScan::AntiFillPath(const SkPath& path, const SkRegion& origClip,
+                          SkBlitter* blitter, bool forceRLE, SkExecutor* bandExecutor) {
     if (origClip.isEmpty()) {
         return;
     }
@@ -731,6 +957,13 @@ void SkScan::AntiFillPath(const SkPath& path, const SkRegion& origClip,
     // now use the (possibly wrapped) blitter
     blitter = clipper.getBlitter();
 
+    SkIRect fillIR;
+    if (fillIR.intersect(ir, clipRgn->getBounds()) &&
+        should_fill_in_bands(path, fillIR, bandExecutor)) {
+        SkScan::AntiFillPathInBands(path, blitter, fillIR, ShouldUseAAA(path), bandExecutor);
+        return;
+    }
+
     if (isInverse) {
         sk_blit_above(blitter, ir, *clipRgn);
     }
@@ -770,18 +1003,29 @@ void SkScan::FillPath(const SkPath& path, const SkRasterClip& clip, SkBlitter* b
 }
 
 void SkScan::AntiFillPath(const SkPath& path, const SkRasterClip& clip, SkBlitter* blitter) {
+    AntiFillPath(path, clip, blitter, gSkAntiFillPathExecutor.load(std::memory_order_relaxed));
+}
+
+void SkScan::AntiFillPathForTesting(const SkPath& path, const SkRasterClip& clip,
+                                    SkBlitter* blitter, SkExecutor* bandExecutor) {
+    AntiFillPath(path, clip, blitter, bandExecutor);
+}
+
+void SkScan::AntiFillPath(const SkPath& path, const SkRasterClip& clip, SkBlitter* blitter,
+                          SkExecutor* bandExecutor) {
     if (clip.isEmpty() || !path.isFinite()) {
         return;
     }
 
     if (clip.isBW()) {
-        AntiFillPath(path, clip.bwRgn(), blitter, false);
+        AntiFillPath(path, clip.bwRgn(), blitter, false, bandExecutor);
     } else {
         SkRegion        tmp;
         SkAAClipBlitter aaBlitter;
 
         tmp.setRect(clip.getBounds());
         aaBlitter.init(blitter, &clip.aaRgn());
-        AntiFillPath(path, tmp, &aaBlitter, true); // SkAAClipBlitter can blitMask, why forceRLE?
+        // SkAAClipBlitter can blitMask, why forceRLE?
+        AntiFillPath(path, tmp, &aaBlitter, true, bandExecutor);
     }
 }
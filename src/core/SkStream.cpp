@@ -197,6 +197,8 @@ SkFILEStream::~SkFILEStream() {
 
 void SkFILEStream::close() {
     fFILE.reset();
+    fMapping.reset();
+    fTriedMapping = false;
     fEnd = 0;
     fStart = 0;
     fCurrent = 0;
@@ -230,7 +232,10 @@ bool SkFILEStream::rewind() {
 }
 
 SkStreamAsset* SkFILEStream::onDuplicate() const {
-    return new SkFILEStream(fFILE, fEnd, fStart, fStart);
+    auto that = new SkFILEStream(fFILE, fEnd, fStart, fStart);
+    that->fMapping = fMapping;
+    that->fTriedMapping = fTriedMapping;
+    return that;
 }
 
 size_t SkFILEStream::getPosition() const {
@@ -264,13 +269,28 @@ bool SkFILEStream::move(long offset) {
 }
 
 SkStreamAsset* SkFILEStream::onFork() const {
-    return new SkFILEStream(fFILE, fEnd, fStart, fCurrent);
+    auto that = new SkFILEStream(fFILE, fEnd, fStart, fCurrent);
+    that->fMapping = fMapping;
+    that->fTriedMapping = fTriedMapping;
+    return that;
 }
 
 size_t SkFILEStream::getLength() const {
     return fEnd - fStart;
 }
 
+const void* SkFILEStream::getMemoryBase() {
+    if (!fTriedMapping && fFILE) {
+        fTriedMapping = true;
+        fMapping = SkData::MakeFromFILE(fFILE.get());
+        // The file may have shrunk since we measured it.
+        if (fMapping && fMapping->size() < fEnd) {
+            fMapping.reset();
+        }
+    }
+    return fMapping ? fMapping->bytes() + fStart : nullptr;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 static sk_sp<SkData> newFromParams(const void* src, size_t size, bool copyData) {
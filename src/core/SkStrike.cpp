@@ -314,7 +314,7 @@ void SkStrike::updateMemoryUsage(size_t increase) {
     if (increase > 0) {
         // fRemoved and the cache's total memory are managed under the cache's lock. This allows
         // them to be accessed under LRU operation.
-        SkAutoMutexExclusive lock{fStrikeCache->fLock};
+        SkAutoSharedMutexExclusive lock{fStrikeCache->fLock};
         fMemoryUsed += increase;
         if (!fRemoved) {
             fStrikeCache->fTotalMemoryUsed += increase;
@@ -19,6 +19,7 @@
 #include "src/core/SkStrikeSpec.h"
 #include "src/core/SkTHash.h"
 
+#include <atomic>
 #include <memory>
 
 class SkScalerContext;
@@ -188,6 +189,10 @@ private:
     std::unique_ptr<SkStrikePinner> fPinner;
     size_t                          fMemoryUsed{sizeof(SkStrike)};
     bool                            fRemoved{false};
+
+    // Set by cache hits that only held the cache's lock shared. The cache moves the strike to the
+    // head of its LRU list when it next purges, rather than purging it.
+    std::atomic<bool>               fRecentlyUsed{false};
 };
 
 #endif  // SkStrike_DEFINED
@@ -36,7 +36,17 @@ SkStrikeCache* SkStrikeCache::GlobalStrikeCache() {
 }
 
 auto SkStrikeCache::findOrCreateStrike(const SkStrikeSpec& strikeSpec) -> sk_sp<SkStrike> {
-    SkAutoMutexExclusive ac(fLock);
+    {
+        SkAutoSharedMutexShared shared(fLock);
+        if (!this->internalOverBudget()) {
+            if (sk_sp<SkStrike> strike = this->internalFindStrikeShared(strikeSpec.descriptor())) {
+                return strike;
+            }
+        }
+    }
+
+    // A miss, or a purge is due.
+    SkAutoSharedMutexExclusive ac(fLock);
     sk_sp<SkStrike> strike = this->internalFindStrikeOrNull(strikeSpec.descriptor());
     if (strike == nullptr) {
         strike = this->internalCreateStrike(strikeSpec);
@@ -89,7 +99,16 @@ void SkStrikeCache::DumpMemoryStatistics(SkTraceMemoryDump* dump) {
 }
 
 sk_sp<SkStrike> SkStrikeCache::findStrike(const SkDescriptor& desc) {
-    SkAutoMutexExclusive ac(fLock);
+    {
+        SkAutoSharedMutexShared shared(fLock);
+        if (!this->internalOverBudget()) {
+            if (sk_sp<SkStrike> strike = this->internalFindStrikeShared(desc)) {
+                return strike;
+            }
+        }
+    }
+
+    SkAutoSharedMutexExclusive ac(fLock);
     sk_sp<SkStrike> result = this->internalFindStrikeOrNull(desc);
     this->internalPurge();
     return result;
@@ -105,6 +124,27 @@ auto SkStrikeCache::internalFindStrikeOrNull(const SkDescriptor& desc) -> sk_sp<
     if (strikeHandle == nullptr) { return nullptr; }
     SkStrike* strikePtr = strikeHandle->get();
     SkASSERT(strikePtr != nullptr);
+    this->internalMoveToHead(strikePtr);
+    return sk_ref_sp(strikePtr);
+}
+
+auto SkStrikeCache::internalFindStrikeShared(const SkDescriptor& desc) const -> sk_sp<SkStrike> {
+    if (fHead != nullptr && fHead->getDescriptor() == desc) { return sk_ref_sp(fHead); }
+
+    sk_sp<SkStrike>* strikeHandle = fStrikeLookup.find(desc);
+    if (strikeHandle == nullptr) { return nullptr; }
+    SkStrike* strikePtr = strikeHandle->get();
+    SkASSERT(strikePtr != nullptr);
+    strikePtr->fRecentlyUsed.store(true, std::memory_order_relaxed);
+    return sk_ref_sp(strikePtr);
+}
+
+bool SkStrikeCache::internalOverBudget() const {
+    return fTotalMemoryUsed > fCacheSizeLimit || fCacheCount > fCacheCountLimit;
+}
+
+void SkStrikeCache::internalMoveToHead(SkStrike* strikePtr) {
+    strikePtr->fRecentlyUsed.store(false, std::memory_order_relaxed);
     if (fHead != strikePtr) {
         // Make most recently used
         strikePtr->fPrev->fNext = strikePtr->fNext;
@@ -118,14 +158,13 @@ auto SkStrikeCache::internalFindStrikeOrNull(const SkDescriptor& desc) -> sk_sp<
         strikePtr->fPrev = nullptr;
         fHead = strikePtr;
     }
-    return sk_ref_sp(strikePtr);
 }
 
 sk_sp<SkStrike> SkStrikeCache::createStrike(
         const SkStrikeSpec& strikeSpec,
         SkFontMetrics* maybeMetrics,
         std::unique_ptr<SkStrikePinner> pinner) {
-    SkAutoMutexExclusive ac(fLock);
+    SkAutoSharedMutexExclusive ac(fLock);
     return this->internalCreateStrike(strikeSpec, maybeMetrics, std::move(pinner));
 }
 
@@ -141,27 +180,27 @@ auto SkStrikeCache::internalCreateStrike(
 }
 
 void SkStrikeCache::purgeAll() {
-    SkAutoMutexExclusive ac(fLock);
+    SkAutoSharedMutexExclusive ac(fLock);
     this->internalPurge(fTotalMemoryUsed);
 }
 
 size_t SkStrikeCache::getTotalMemoryUsed() const {
-    SkAutoMutexExclusive ac(fLock);
+    SkAutoSharedMutexShared ac(fLock);
     return fTotalMemoryUsed;
 }
 
 int SkStrikeCache::getCacheCountUsed() const {
-    SkAutoMutexExclusive ac(fLock);
+    SkAutoSharedMutexShared ac(fLock);
     return fCacheCount;
 }
 
 int SkStrikeCache::getCacheCountLimit() const {
-    SkAutoMutexExclusive ac(fLock);
+    SkAutoSharedMutexShared ac(fLock);
     return fCacheCountLimit;
 }
 
 size_t SkStrikeCache::setCacheSizeLimit(size_t newLimit) {
-    SkAutoMutexExclusive ac(fLock);
+    SkAutoSharedMutexExclusive ac(fLock);
 
     size_t prevLimit = fCacheSizeLimit;
     fCacheSizeLimit = newLimit;
@@ -170,7 +209,7 @@ size_t SkStrikeCache::setCacheSizeLimit(size_t newLimit) {
 }
 
 size_t  SkStrikeCache::getCacheSizeLimit() const {
-    SkAutoMutexExclusive ac(fLock);
+    SkAutoSharedMutexShared ac(fLock);
     return fCacheSizeLimit;
 }
 
@@ -179,7 +218,7 @@ int SkStrikeCache::setCacheCountLimit(int newCount) {
         newCount = 0;
     }
 
-    SkAutoMutexExclusive ac(fLock);
+    SkAutoSharedMutexExclusive ac(fLock);
 
     int prevCount = fCacheCountLimit;
     fCacheCountLimit = newCount;
@@ -188,7 +227,7 @@ int SkStrikeCache::setCacheCountLimit(int newCount) {
 }
 
 void SkStrikeCache::forEachStrike(std::function<void(const SkStrike&)> visitor) const {
-    SkAutoMutexExclusive ac(fLock);
+    SkAutoSharedMutexShared ac(fLock);
 
     this->validate();
 
@@ -229,6 +268,14 @@ size_t SkStrikeCache::internalPurge(size_t minBytesNeeded) {
     while (strike != nullptr && (bytesFreed < bytesNeeded || countFreed < countNeeded)) {
         SkStrike* prev = strike->fPrev;
 
+        // Strikes hit under the shared lock get the LRU promotion they skipped. The walk will
+        // reach them again at the head, so they can still be purged if nothing else is left.
+        if (strike->fRecentlyUsed.load(std::memory_order_relaxed)) {
+            this->internalMoveToHead(strike);
+            strike = prev;
+            continue;
+        }
+
         // Only delete if the strike is not pinned.
         if (strike->fPinner == nullptr || strike->fPinner->canDelete()) {
             bytesFreed += strike->fMemoryUsed;
@@ -13,6 +13,7 @@
 #include "include/private/base/SkLoadUserConfig.h" // IWYU pragma: keep
 #include "include/private/base/SkMutex.h"
 #include "src/core/SkDescriptor.h"
+#include "src/core/SkSharedMutex.h"
 #include "src/core/SkStrikeSpec.h"
 #include "src/text/StrikeForGPU.h"
 
@@ -71,6 +72,14 @@ private:
     friend class SkStrike;  // for SkStrike::updateDelta
     static constexpr char kGlyphCacheDumpName[] = "skia/sk_glyph_cache";
     sk_sp<SkStrike> internalFindStrikeOrNull(const SkDescriptor& desc) SK_REQUIRES(fLock);
+
+    // Lookup for callers holding only the shared lock. A hit isn't moved to the head of the LRU
+    // list here; it is flagged, and internalPurge() moves it instead of purging it.
+    sk_sp<SkStrike> internalFindStrikeShared(const SkDescriptor& desc) const
+            SK_REQUIRES_SHARED(fLock);
+
+    // Would internalPurge() have anything to do?
+    bool internalOverBudget() const SK_REQUIRES_SHARED(fLock);
     sk_sp<SkStrike> internalCreateStrike(
             const SkStrikeSpec& strikeSpec,
             SkFontMetrics* maybeMetrics = nullptr,
@@ -78,6 +87,7 @@ private:
 
     // The following methods can only be called when mutex is already held.
     void internalRemoveStrike(SkStrike* strike) SK_REQUIRES(fLock);
+    void internalMoveToHead(SkStrike* strike) SK_REQUIRES(fLock);
     void internalAttachToHead(sk_sp<SkStrike> strike) SK_REQUIRES(fLock);
 
     // Checkout budgets, modulated by the specified min-bytes-needed-to-purge,
@@ -86,11 +96,13 @@ private:
     size_t internalPurge(size_t minBytesNeeded = 0) SK_REQUIRES(fLock);
 
     // A simple accounting of what each glyph cache reports and the strike cache total.
-    void validate() const SK_REQUIRES(fLock);
+    void validate() const SK_REQUIRES_SHARED(fLock);
 
     void forEachStrike(std::function<void(const SkStrike&)> visitor) const SK_EXCLUDES(fLock);
 
-    mutable SkMutex fLock;
+    // Cache hits only read the lookup table, so they take this shared; anything that changes
+    // the LRU list or the accounting takes it exclusively.
+    mutable SkSharedMutex fLock;
     SkStrike* fHead SK_GUARDED_BY(fLock) {nullptr};
     SkStrike* fTail SK_GUARDED_BY(fLock) {nullptr};
     struct StrikeTraits {
@@ -6,8 +6,11 @@
  */
 
 #include "include/core/SkExecutor.h"
+#include "include/private/base/SkSemaphore.h"
 #include "src/core/SkTaskGroup.h"
 
+#include <memory>
+
 SkTaskGroup::SkTaskGroup(SkExecutor& executor) : fPending(0), fExecutor(executor) {}
 
 void SkTaskGroup::add(std::function<void(void)> fn) {
@@ -43,6 +46,40 @@ void SkTaskGroup::wait() {
     }
 }
 
+void SkTaskGroup::BatchAndJoin(SkExecutor& executor, int N, std::function<void(int)> fn) {
+    if (N <= 0) {
+        return;
+    }
+
+    // Each thread claims calls one at a time, so a call is only ever waited on once some thread
+    // is running it.  Tasks share ownership of this state in case they start after we return.
+    struct State {
+        std::function<void(int)> fn;
+        int N;
+        std::atomic<int> next{0};
+        std::atomic<int> finished{0};
+        SkSemaphore done;
+
+        void drain() {
+            for (int i; (i = next.fetch_add(1, std::memory_order_relaxed)) < N;) {
+                fn(i);
+                if (finished.fetch_add(1, std::memory_order_acq_rel) + 1 == N) {
+                    done.signal();
+                }
+            }
+        }
+    };
+    auto state = std::make_shared<State>();
+    state->fn = std::move(fn);
+    state->N = N;
+
+    for (int i = 1; i < N; i++) {
+        executor.add([state] { state->drain(); });
+    }
+    state->drain();
+    state->done.wait();
+}
+
 SkTaskGroup::Enabler::Enabler(int threads) {
     if (threads) {
         fThreadPool = SkExecutor::MakeLIFOThreadPool(threads);
@@ -33,6 +33,13 @@ public:
     // Block until done().
     void wait();
 
+    // Call fn(0), ..., fn(N-1), spread across the executor and the calling thread, returning once
+    // they've all run.  Unlike batch() and wait(), this never waits on work still queued on the
+    // executor, so it's safe to call from one of the executor's own threads even if its borrow()
+    // does nothing.  Tasks that only start after every call has been claimed return without
+    // calling fn, so fn may refer to the caller's stack.
+    static void BatchAndJoin(SkExecutor&, int N, std::function<void(int)> fn);
+
     // A convenience for testing tools.
     // Creates and owns a thread pool, and passes it to SkExecutor::SetDefault().
     struct Enabler {
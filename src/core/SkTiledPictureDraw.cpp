@@ -0,0 +1,103 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/core/SkTiledPictureDraw.h"
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkMatrix.h"
+#include "include/core/SkPicture.h"
+#include "include/core/SkPixmap.h"
+#include "include/core/SkSurfaceProps.h"
+#include "src/core/SkBigPicture.h"
+#include "src/core/SkPicturePriv.h"
+#include "src/core/SkRecord.h"
+#include "src/core/SkRecords.h"
+#include "src/core/SkTaskGroup.h"
+#include "src/core/SkTraceEvent.h"
+
+namespace {
+
+// Finds ops that may read pixels outside the tile they draw into, which would make tiles race
+// with each other.  Nested pictures are searched too.
+struct ReadsOutsideClip {
+    bool fFound = false;
+
+    template <typename T> void operator()(const T&) {}
+
+    void operator()(const SkRecords::SaveLayer& op) {
+        fFound |= op.backdrop != nullptr;
+    }
+    void operator()(const SkRecords::DrawPicture& op) {
+        fFound |= !can_tile(op.picture.get());
+    }
+    void operator()(const SkRecords::DrawDrawable&) {
+        // We can't see inside drawables, so be conservative.
+        fFound = true;
+    }
+
+    static bool can_tile(const SkPicture* picture) {
+        const SkBigPicture* big = SkPicturePriv::AsSkBigPicture(sk_ref_sp(picture));
+        if (!big) {
+            return true;  // Empty pictures and placeholders draw nothing.
+        }
+        ReadsOutsideClip visitor;
+        for (int i = 0; i < big->record()->count() && !visitor.fFound; i++) {
+            big->record()->visit(i, visitor);
+        }
+        return !visitor.fFound;
+    }
+};
+
+}  // namespace
+
+bool SkTiledPictureDraw(const SkPicture* picture,
+                        const SkPixmap& dst,
+                        const SkMatrix* matrix,
+                        const SkSurfaceProps* props,
+                        SkISize tileSize,
+                        SkExecutor* executor) {
+    TRACE_EVENT0("skia", TRACE_FUNC);
+    SkBitmap bitmap;
+    if (!picture || !bitmap.installPixels(dst)) {
+        return false;
+    }
+    const SkSurfaceProps surfaceProps = props ? *props : SkSurfaceProps();
+
+    auto draw_tile = [&](const SkIRect& tile) {
+        SkCanvas canvas(bitmap, surfaceProps);
+        canvas.clipIRect(tile);
+        if (matrix) {
+            canvas.concat(*matrix);
+        }
+        picture->playback(&canvas);
+    };
+
+    const SkIRect bounds = dst.bounds();
+    if (!executor || tileSize.isEmpty() || bounds.isEmpty() ||
+        !ReadsOutsideClip::can_tile(picture)) {
+        draw_tile(bounds);
+        return true;
+    }
+
+    const int tileW = std::min(tileSize.width(),  bounds.width()),
+              tileH = std::min(tileSize.height(), bounds.height());
+    const int xTiles = (bounds.width()  + tileW - 1) / tileW,
+              yTiles = (bounds.height() + tileH - 1) / tileH;
+
+    SkTaskGroup tg(*executor);
+    tg.batch(xTiles * yTiles, [&](int i) {
+        const SkIRect tile = SkIRect::MakeXYWH((i % xTiles) * tileW,
+                                               (i / xTiles) * tileH,
+                                               tileW, tileH);
+        // The last row and column may hang over the edge; the canvas clips them to dst.
+        draw_tile(tile);
+    });
+    tg.wait();
+    return true;
+}
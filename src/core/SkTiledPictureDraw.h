@@ -0,0 +1,42 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkTiledPictureDraw_DEFINED
+#define SkTiledPictureDraw_DEFINED
+
+#include "include/core/SkSize.h"
+
+class SkExecutor;
+class SkMatrix;
+class SkPicture;
+class SkPixmap;
+class SkSurfaceProps;
+
+// Rasterize an SkPicture into dst, splitting dst into tiles of tileSize and replaying the
+// picture into each tile as an independent task on executor (or serially if executor is null).
+//
+// Each tile draws through its own SkCanvas that wraps all of dst and is clipped to the tile, so
+// device coordinates (and with them dithering, AA and shader sampling) are exactly what a single
+// canvas would see.  SkBigPicture::playback() then uses the picture's SkBBoxHierarchy, if any, to
+// cull each tile's ops.  The result is bit-identical to
+//
+//    SkCanvas canvas(bitmap, props);
+//    canvas.concat(matrix);
+//    picture->playback(&canvas);
+//
+// for pictures whose ops only read back pixels inside their own clip.  Backdrop image filters
+// can read outside the tile they are drawn into, so pictures containing them are drawn serially.
+//
+// Returns false if dst is not a drawable raster destination.
+bool SkTiledPictureDraw(const SkPicture*,
+                        const SkPixmap& dst,
+                        const SkMatrix* matrix,
+                        const SkSurfaceProps* props,
+                        SkISize tileSize,
+                        SkExecutor* executor);
+
+#endif//SkTiledPictureDraw_DEFINED
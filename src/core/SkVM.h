@@ -624,6 +624,9 @@ namespace skvm {
         // Mostly for debugging, tests, etc.
         std::vector<Instruction> program() const { return fProgram; }
         std::vector<OptimizedInstruction> optimize(viz::Visualizer* visualizer = nullptr) const;
+        std::vector<int>        strides()    const { return fStrides;    }
+        std::vector<TraceHook*> traceHooks() const { return fTraceHooks; }
+        Features                features()   const { return fFeatures;   }
 
         // Returns a trace-hook ID which must be passed to the trace opcodes.
         int attachTraceHook(TraceHook*);
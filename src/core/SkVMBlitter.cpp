@@ -5,7 +5,12 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkData.h"
+#include "include/core/SkMilestone.h"
+#include "include/core/SkStream.h"
 #include "include/private/base/SkMacros.h"
+#include "include/private/base/SkMutex.h"
+#include "include/private/base/SkTemplates.h"
 #include "src/base/SkArenaAlloc.h"
 #include "src/core/SkBlendModePriv.h"
 #include "src/core/SkBlenderBase.h"
@@ -21,7 +26,9 @@
 #include "src/core/SkVM.h"
 #include "src/core/SkVMBlitter.h"
 #include "src/shaders/SkColorFilterShader.h"
+#include "src/utils/SkVMVisualizer.h"
 
+#include <atomic>
 #include <cinttypes>
 
 #define SK_BLITTER_TRACE_IS_SKVM
@@ -550,6 +557,11 @@ SkVMBlitter::Key SkVMBlitter::CacheKey(
     };
 }
 
+namespace {
+    // Where blitters made from now on look for and store their programs.
+    std::atomic<SkGraphics::PersistentCache*> gPersistentCache{nullptr};
+}  // namespace
+
 SkVMBlitter::SkVMBlitter(const SkPixmap& device,
                          const SkPaint& paint,
                          const SkPixmap* sprite,
@@ -562,29 +574,170 @@ SkVMBlitter::SkVMBlitter(const SkPixmap& device,
         , fSpriteOffset(spriteOffset)
         , fUniforms(skvm::UPtr{{0}}, kBlitterUniformsCount)
         , fParams(EffectiveParams(device, sprite, paint, ctm, std::move(clip)))
-        , fKey(CacheKey(fParams, &fUniforms, &fAlloc, ok)) {}
-
-SkVMBlitter::~SkVMBlitter() {
-    if (fStoreToCache) {
-        if (SkLRUCache<Key, skvm::Program>* cache = TryAcquireProgramCache()) {
-            auto cache_program = [&](SkTLazy<skvm::Program>& program, Coverage coverage) {
-                if (program.isValid() && !program->hasTraceHooks()) {
-                    cache->insert_or_update(fKey.withCoverage(coverage), std::move(*program));
-                }
-            };
-            for (int c = 0; c < Coverage::kCount; c++) {
-                cache_program(fPrograms[c], static_cast<Coverage>(c));
+        , fKey(CacheKey(fParams, &fUniforms, &fAlloc, ok))
+        , fPersistentCache(gPersistentCache.load(std::memory_order_acquire)) {}
+
+SkVMBlitter::~SkVMBlitter() = default;
+
+bool SkVMBlitter::DrawPaintForTesting(const SkPixmap& dst,
+                                      const SkPaint& paint,
+                                      SkGraphics::PersistentCache* cache) {
+    bool ok = true;
+    SkVMBlitter blitter(dst, paint, /*sprite=*/nullptr, /*spriteOffset=*/{0, 0},
+                        SkMatrix::I(), /*clip=*/nullptr, &ok);
+    if (!ok) {
+        return false;
+    }
+    blitter.fPersistentCache = cache;
+    blitter.fSharePrograms   = false;
+    blitter.blitRect(0, 0, dst.width(), dst.height());
+    return true;
+}
+
+namespace {
+    // Enough for the programs of a few frames of ordinary content, shared by every thread.
+    constexpr int kMaxCachedPrograms = 256;
+
+    SkMutex& program_cache_mutex() {
+        static SkMutex* mutex = new SkMutex;
+        return *mutex;
+    }
+
+    // Programs are persisted as their optimized instructions, and JIT compiled again when loaded.
+    // Bump this whenever that format or skvm::Op changes.
+    constexpr uint32_t kPersistentVersion = 2;
+
+    struct PersistentHeader {
+        uint32_t version;
+        int32_t  instructionCount;
+        uint64_t programHash;   // skvm::Builder::hash() of the program before optimization.
+    };
+
+    struct PersistentInstruction {
+        int32_t op,
+                x, y, z, w,
+                immA, immB, immC,
+                death,
+                canHoist;
+    };
+
+    // Gathers and array32 read wherever the program's own arithmetic points them, so no check of
+    // the stored instructions could show they stay in bounds. Programs using them aren't persisted.
+    bool reads_through_pointers(skvm::Op op) {
+        return (skvm::Op::gather8 <= op && op <= skvm::Op::gather32) || op == skvm::Op::array32;
+    }
+
+    // Returns null if the program can't be persisted.
+    sk_sp<SkData> serialize_program(const std::vector<skvm::OptimizedInstruction>& instructions,
+                                    uint64_t programHash) {
+        SkDynamicMemoryWStream stream;
+        const PersistentHeader header = {kPersistentVersion,
+                                         SkToS32(instructions.size()),
+                                         programHash};
+        stream.write(&header, sizeof(header));
+        for (const skvm::OptimizedInstruction& inst : instructions) {
+            if (reads_through_pointers(inst.op)) {
+                return nullptr;
             }
+            const PersistentInstruction p = {(int32_t)inst.op,
+                                             inst.x, inst.y, inst.z, inst.w,
+                                             inst.immA, inst.immB, inst.immC,
+                                             inst.death,
+                                             inst.can_hoist};
+            stream.write(&p, sizeof(p));
+        }
+        return stream.detachAsData();
+    }
+
+    // Accepts only programs built from the same instructions as the program we'd build now, which
+    // covers changes to the blitter and its effects between builds. Rejects anything
+    // serialize_program() could not have written, and any access outside the program's arguments
+    // or its uniformBytes of uniforms, so that a corrupt cache can't send the interpreter or JIT
+    // out of bounds.
+    bool deserialize_program(const SkData& data,
+                             uint64_t programHash,
+                             const std::vector<int>& strides,
+                             size_t uniformBytes,
+                             std::vector<skvm::OptimizedInstruction>* instructions) {
+        SkMemoryStream stream(data.data(), data.size());
+        PersistentHeader header;
+        if (stream.read(&header, sizeof(header)) != sizeof(header) ||
+            header.version != kPersistentVersion ||
+            header.programHash != programHash ||
+            header.instructionCount <= 0 ||
+            stream.getLength() - sizeof(header) !=
+                    header.instructionCount * sizeof(PersistentInstruction)) {
+            return false;
+        }
 
-            ReleaseProgramCache();
+        const int n = header.instructionCount;
+        const int argCount = SkToInt(strides.size());
+        instructions->resize(n);
+        for (int i = 0; i < n; i++) {
+            PersistentInstruction p;
+            SkAssertResult(stream.read(&p, sizeof(p)) == sizeof(p));
+
+            const auto op = (skvm::Op)p.op;
+            if (p.op < 0 || op > skvm::Op::duplicate || skvm::is_trace(op) ||
+                reads_through_pointers(op)) {
+                return false;
+            }
+            for (int32_t arg : {p.x, p.y, p.z, p.w}) {
+                if (arg != skvm::NA && (arg < 0 || arg >= i)) {
+                    return false;
+                }
+            }
+            if (p.death < i || p.death > n) {
+                return false;
+            }
+            if (skvm::touches_varying_memory(op) || op == skvm::Op::uniform32) {
+                if (p.immA < 0 || p.immA >= argCount) {
+                    return false;
+                }
+            }
+            switch (op) {
+                case skvm::Op::load64:
+                    if (p.immB < 0 || p.immB > 1) { return false; }
+                    break;
+                case skvm::Op::load128:
+                    if (p.immB < 0 || p.immB > 3) { return false; }
+                    break;
+                case skvm::Op::uniform32:
+                    // immB is a byte offset into a uniform (stride 0) argument.
+                    if (strides[p.immA] != 0 || p.immB < 0 || p.immB % 4 != 0 ||
+                        (size_t)p.immB + 4 > uniformBytes) {
+                        return false;
+                    }
+                    break;
+                default:
+                    break;
+            }
+            (*instructions)[i] = {op,
+                                  p.x, p.y, p.z, p.w,
+                                  p.immA, p.immB, p.immC,
+                                  p.death,
+                                  p.canHoist != 0};
         }
+        return true;
+    }
+}  // namespace
+
+void SkVMBlitter::SetPersistentCache(SkGraphics::PersistentCache* cache) {
+    gPersistentCache.store(cache, std::memory_order_release);
+}
+
+void SkVMBlitter::PurgeProgramCache() {
+    if (ProgramCache* cache = TryAcquireProgramCache()) {
+        cache->reset();
+        ReleaseProgramCache();
     }
 }
 
-SkLRUCache<SkVMBlitter::Key, skvm::Program>* SkVMBlitter::TryAcquireProgramCache() {
+SkVMBlitter::ProgramCache* SkVMBlitter::TryAcquireProgramCache() {
 #if defined(SKVM_JIT)
-    thread_local static SkLRUCache<Key, skvm::Program> cache{64};
-    return &cache;
+    static ProgramCache* cache = new ProgramCache{kMaxCachedPrograms};
+    program_cache_mutex().acquire();
+    return cache;
 #else
     // iOS now supports thread_local since iOS 9.
     // On the other hand, we'll never be able to JIT there anyway.
@@ -605,7 +758,11 @@ SkString SkVMBlitter::DebugName(const Key& key) {
                           key.coverage);
 }
 
-void SkVMBlitter::ReleaseProgramCache() {}
+void SkVMBlitter::ReleaseProgramCache() {
+#if defined(SKVM_JIT)
+    program_cache_mutex().release();
+#endif
+}
 
 skvm::Program* SkVMBlitter::buildProgram(Coverage coverage) {
     // eg, blitter re-use...
@@ -613,24 +770,44 @@ skvm::Program* SkVMBlitter::buildProgram(Coverage coverage) {
         return fProgramPtrs[coverage];
     }
 
-    // Next, cache lookup...
+    // Next, find the program shared by every blitter with this key, adding it if needed...
     Key key = fKey.withCoverage(coverage);
-    {
-        skvm::Program* p = nullptr;
-        if (SkLRUCache<Key, skvm::Program>* cache = TryAcquireProgramCache()) {
-            p = cache->find(key);
-            ReleaseProgramCache();
+    sk_sp<CachedProgram> cached;
+    if (ProgramCache* cache = fSharePrograms ? TryAcquireProgramCache() : nullptr) {
+        if (sk_sp<CachedProgram>* found = cache->find(key)) {
+            cached = *found;
+        } else {
+            cached = sk_make_sp<CachedProgram>();
+            cache->insert(key, cached);
+        }
+        ReleaseProgramCache();
+    }
+
+    if (cached) {
+        // ... and compile it, unless another blitter has or is doing so.
+        SkAutoMutexExclusive lock(cached->fBuildMutex);
+        if (!cached->fBuilt) {
+            cached->fBuilt = true;
+            skvm::Program program = this->compileProgram(coverage, key);
+            if (program.hasTraceHooks()) {
+                // Trace hooks belong to this draw, so keep the program to ourselves.
+                fProgramPtrs[coverage] = fPrograms[coverage].set(std::move(program));
+                return fProgramPtrs[coverage];
+            }
+            cached->fProgram = std::move(program);
         }
-        if (p) {
-            SkASSERT(!p->empty());
-            fProgramPtrs[coverage] = p;
-            return p;
+        if (!cached->fProgram.empty()) {
+            fProgramPtrs[coverage] = &cached->fProgram;
+            fCachedPrograms[coverage] = std::move(cached);
+            return fProgramPtrs[coverage];
         }
     }
 
-    // Okay, let's build it...
-    fStoreToCache = true;
+    fProgramPtrs[coverage] = fPrograms[coverage].set(this->compileProgram(coverage, key));
+    return fProgramPtrs[coverage];
+}
 
+skvm::Program SkVMBlitter::compileProgram(Coverage coverage, const Key& key) {
     // We don't really _need_ to rebuild fUniforms here.
     // It's just more natural to have effects unconditionally emit them,
     // and more natural to rebuild fUniforms than to emit them into a temporary buffer.
@@ -642,7 +819,36 @@ skvm::Program* SkVMBlitter::buildProgram(Coverage coverage) {
     SkASSERTF(fUniforms.buf.size() == prev,
               "%zu, prev was %zu", fUniforms.buf.size(), prev);
 
-    skvm::Program program = builder.done(DebugName(key).c_str());
+    // An earlier process that built the same instructions has already optimized them for us.
+    SkGraphics::PersistentCache* persistentCache = nullptr;
+    sk_sp<SkData> persistentKey;
+#if defined(SKVM_JIT)
+    persistentCache = builder.traceHooks().empty() ? fPersistentCache : nullptr;
+    if (persistentCache) {
+        const skvm::Features features = builder.features();
+        const uint32_t header[] = {kPersistentVersion,
+                                   SK_MILESTONE,
+                                   (features.fma  ? 1u : 0u) |
+                                   (features.fp16 ? 2u : 0u)};
+        persistentKey = SkData::MakeUninitialized(sizeof(header) + sizeof(Key));
+        memcpy(persistentKey->writable_data(), header, sizeof(header));
+        memcpy(SkTAddOffset<void>(persistentKey->writable_data(), sizeof(header)),
+               &key, sizeof(Key));
+
+        std::vector<skvm::OptimizedInstruction> instructions;
+        if (sk_sp<SkData> data = persistentCache->load(*persistentKey);
+                data && deserialize_program(*data, builder.hash(), builder.strides(),
+                                            fUniforms.buf.size() * sizeof(int),
+                                            &instructions)) {
+            return skvm::Program(instructions, /*visualizer=*/nullptr, builder.strides(),
+                                 /*traceHooks=*/{}, DebugName(key).c_str(), /*allow_jit=*/true);
+        }
+    }
+#endif
+
+    std::vector<skvm::OptimizedInstruction> instructions = builder.optimize();
+    skvm::Program program(instructions, /*visualizer=*/nullptr, builder.strides(),
+                          builder.traceHooks(), DebugName(key).c_str(), /*allow_jit=*/true);
     if ((false)) {
         static std::atomic<int> missed{0},
                                 total{0};
@@ -658,8 +864,12 @@ skvm::Program* SkVMBlitter::buildProgram(Coverage coverage) {
                                 total.load(), missed.load()); });
         }
     }
-    fProgramPtrs[coverage] = fPrograms[coverage].set(std::move(program));
-    return fProgramPtrs[coverage];
+    if (persistentCache) {
+        if (sk_sp<SkData> data = serialize_program(instructions, builder.hash())) {
+            persistentCache->store(*persistentKey, *data, DebugName(key));
+        }
+    }
+    return program;
 }
 
 void SkVMBlitter::updateUniforms(int right, int y) {
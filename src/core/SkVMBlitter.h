@@ -8,7 +8,10 @@
 #ifndef SkVMBlitter_DEFINED
 #define SkVMBlitter_DEFINED
 
+#include "include/core/SkGraphics.h"
 #include "include/core/SkPixmap.h"
+#include "include/core/SkRefCnt.h"
+#include "include/private/base/SkMutex.h"
 #include "src/base/SkArenaAlloc.h"
 #include "src/base/SkTLazy.h"
 #include "src/core/SkBlitter.h"
@@ -40,6 +43,18 @@ public:
 
     ~SkVMBlitter() override;
 
+    // Where programs are kept between processes, or nullptr. See SkGraphics::SetJITProgramCache().
+    static void SetPersistentCache(SkGraphics::PersistentCache*);
+
+    // Drops every program shared between blitters. Blitters still using one keep it alive.
+    static void PurgeProgramCache();
+
+    // For tests: draws paint over all of dst with a blitter that shares no programs with other
+    // blitters, and looks for and stores them in cache rather than the SetPersistentCache() one.
+    static bool DrawPaintForTesting(const SkPixmap& dst,
+                                    const SkPaint&,
+                                    SkGraphics::PersistentCache* cache);
+
 private:
     enum Coverage { Full, UniformF, MaskA8, MaskLCD16, Mask3D, kCount };
     struct Key {
@@ -82,11 +97,25 @@ private:
                              skvm::Uniforms* uniforms, SkArenaAlloc* alloc);
     static Key CacheKey(const Params& params,
                         skvm::Uniforms* uniforms, SkArenaAlloc* alloc, bool* ok);
-    static SkLRUCache<Key, skvm::Program>* TryAcquireProgramCache();
+
+    // A program shared by every blitter, on any thread, that needs the same Key. The first
+    // blitter to need it compiles it while holding fBuildMutex, so any others wait for that
+    // rather than compiling it again.
+    struct CachedProgram : public SkNVRefCnt<CachedProgram> {
+        SkMutex       fBuildMutex;
+        bool          fBuilt = false;   // Guarded by fBuildMutex.
+        skvm::Program fProgram;         // Left empty if the program can't be shared.
+    };
+    using ProgramCache = SkLRUCache<Key, sk_sp<CachedProgram>>;
+
+    // Locks the process-wide program cache until ReleaseProgramCache(), or returns nullptr,
+    // without locking, if programs are not cached.
+    static ProgramCache* TryAcquireProgramCache();
     static SkString DebugName(const Key& key);
     static void ReleaseProgramCache();
 
     skvm::Program* buildProgram(Coverage coverage);
+    skvm::Program compileProgram(Coverage coverage, const Key& key);
     void updateUniforms(int right, int y);
     const void* isSprite(int x, int y) const;
 
@@ -103,10 +132,13 @@ private:
     SkArenaAlloc    fAlloc{2*sizeof(void*)};  // but a few effects need to ref large content.
     const Params    fParams;
     const Key       fKey;
-    bool            fStoreToCache = false;
+
+    SkGraphics::PersistentCache* fPersistentCache;      // Read once, when the blitter is made.
+    bool                         fSharePrograms = true;  // False only for DrawPaintForTesting().
 
     skvm::Program*         fProgramPtrs[Coverage::kCount] = {nullptr};
-    SkTLazy<skvm::Program> fPrograms[Coverage::kCount];
+    sk_sp<CachedProgram>   fCachedPrograms[Coverage::kCount];  // Shared with other blitters.
+    SkTLazy<skvm::Program> fPrograms[Coverage::kCount];        // Used only by this blitter.
 
     friend class Viewer;
 };
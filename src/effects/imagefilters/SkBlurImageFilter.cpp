@@ -19,13 +19,16 @@
 #include "include/core/SkTileMode.h"
 #include "include/core/SkTypes.h"
 #include "include/effects/SkImageFilters.h"
+#include "include/private/base/SkAlign.h"
 #include "include/private/base/SkFloatingPoint.h"
 #include "src/base/SkVx.h"
 #include "include/private/base/SkMalloc.h"
 #include "src/base/SkArenaAlloc.h"
 #include "src/core/SkImageFilter_Base.h"
+#include "src/core/SkMaskBlurFilter.h"
 #include "src/core/SkReadBuffer.h"
 #include "src/core/SkSpecialImage.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/core/SkWriteBuffer.h"
 
 #include <algorithm>
@@ -138,6 +141,10 @@ int calculate_window(double sigma) {
 // raster paths.
 static constexpr SkScalar kMaxSigma = 532.f;
 
+// Blurs producing at least this many pixels are split into bands of rows and columns.
+static constexpr int64_t kMinParallelBlurPixels = 256 * 256;
+static constexpr int     kMaxBlurBands = 32;
+
 static SkVector map_sigma(const SkSize& localSigma, const SkMatrix& ctm) {
     SkVector sigma = SkVector::Make(localSigma.width(), localSigma.height());
     ctm.mapVectors(&sigma, 1);
@@ -853,8 +860,34 @@ sk_sp<SkSpecialImage> cpu_blur(
         return nullptr;
     }
 
+    // Each row of the horizontal pass, and each column of the vertical pass, is blurred on its
+    // own. If the client has given us an executor (see SkGraphics::SetBlurExecutor()), large
+    // blurs split them into bands, each with its own Pass. The result is the same.
+    SkExecutor* executor = gSkBlurExecutor.load(std::memory_order_relaxed);
+    int bands = 1;
+    if (executor && (int64_t)dstW * dstH >= kMinParallelBlurPixels) {
+        bands = kMaxBlurBands;
+    }
     size_t bufferSizeBytes = std::max(makerX->bufferSizeBytes(), makerY->bufferSizeBytes());
-    auto buffer = alloc.makeBytesAlignedTo(bufferSizeBytes, alignof(skvx::Vec<4, uint32_t>));
+    bufferSizeBytes = SkAlignTo(bufferSizeBytes, alignof(skvx::Vec<4, uint32_t>));
+    auto buffers = static_cast<char*>(
+            alloc.makeBytesAlignedTo(bufferSizeBytes * bands, alignof(skvx::Vec<4, uint32_t>)));
+
+    auto forEachBand = [&](PassMaker* maker, int count, auto&& blurBand) {
+        int n = std::max(1, std::min(bands, count));
+        Pass* passes[kMaxBlurBands];
+        for (int band = 0; band < n; band++) {
+            passes[band] = maker->makePass(buffers + band * bufferSizeBytes, &alloc);
+        }
+        if (n == 1) {
+            blurBand(passes[0], 0, count);
+        } else {
+            // We may be filtering on one of the executor's threads, so we must not wait on it.
+            SkTaskGroup::BatchAndJoin(*executor, n, [&](int band) {
+                blurBand(passes[band], count * band / n, count * (band + 1) / n);
+            });
+        }
+    };
 
     // Basic Plan: The three cases to handle
     // * Horizontal and Vertical - blur horizontally while copying values from the source to
@@ -884,7 +917,6 @@ sk_sp<SkSpecialImage> cpu_blur(
     }
 
     if (makerX->window() > 1) {
-        Pass* pass = makerX->makePass(buffer, &alloc);
         // Make int64 to avoid overflow in multiplication below.
         int64_t shift = srcBounds.top() - dstBounds.top();
 
@@ -897,27 +929,30 @@ sk_sp<SkSpecialImage> cpu_blur(
         intermediateWidth = dstW;
         intermediateDst = static_cast<uint32_t *>(dst.getPixels());
 
-        const uint32_t* srcCursor = static_cast<uint32_t*>(src.getPixels());
-        uint32_t* dstCursor = intermediateSrc;
-        for (auto y = 0; y < srcH; y++) {
-            pass->blur(srcBounds.left(), srcBounds.right(), dstBounds.right(),
-                      srcCursor, 1, dstCursor, 1);
-            srcCursor += src.rowBytesAsPixels();
-            dstCursor += intermediateRowBytesAsPixels;
-        }
+        forEachBand(makerX, srcH, [&](Pass* pass, int y0, int y1) {
+            const uint32_t* srcCursor = src.getAddr32(0, y0);
+            uint32_t* dstCursor = intermediateSrc + (int64_t)y0 * intermediateRowBytesAsPixels;
+            for (auto y = y0; y < y1; y++) {
+                pass->blur(srcBounds.left(), srcBounds.right(), dstBounds.right(),
+                          srcCursor, 1, dstCursor, 1);
+                srcCursor += src.rowBytesAsPixels();
+                dstCursor += intermediateRowBytesAsPixels;
+            }
+        });
     }
 
     if (makerY->window() > 1) {
-        Pass* pass = makerY->makePass(buffer, &alloc);
-        const uint32_t* srcCursor = intermediateSrc;
-        uint32_t* dstCursor = intermediateDst;
-        for (auto x = 0; x < intermediateWidth; x++) {
-            pass->blur(srcBounds.top(), srcBounds.bottom(), dstBounds.bottom(),
-                       srcCursor, intermediateRowBytesAsPixels,
-                       dstCursor, dst.rowBytesAsPixels());
-            srcCursor += 1;
-            dstCursor += 1;
-        }
+        forEachBand(makerY, intermediateWidth, [&](Pass* pass, int x0, int x1) {
+            const uint32_t* srcCursor = intermediateSrc + x0;
+            uint32_t* dstCursor = intermediateDst + x0;
+            for (auto x = x0; x < x1; x++) {
+                pass->blur(srcBounds.top(), srcBounds.bottom(), dstBounds.bottom(),
+                           srcCursor, intermediateRowBytesAsPixels,
+                           dstCursor, dst.rowBytesAsPixels());
+                srcCursor += 1;
+                dstCursor += 1;
+            }
+        });
     }
 
     return SkSpecialImage::MakeFromRaster(SkIRect::MakeWH(dstBounds.width(),
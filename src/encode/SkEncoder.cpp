@@ -7,14 +7,26 @@
 
 #include "include/encode/SkEncoder.h"
 
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkScalar.h"
 #include "include/private/base/SkAssert.h"
 
+#include <algorithm>
+
 bool SkEncoder::encodeRows(int numRows) {
     SkASSERT(numRows > 0 && fCurrRow < fSrc.height());
     if (numRows <= 0 || fCurrRow >= fSrc.height()) {
         return false;
     }
 
+    // An encoder made without pixels can only be fed through encodeRows(const SkPixmap&).
+    if (!fRows.addr() && !fSrc.addr()) {
+        return false;
+    }
+
     if (fCurrRow + numRows > fSrc.height()) {
         numRows = fSrc.height() - fCurrRow;
     }
@@ -27,3 +39,51 @@ bool SkEncoder::encodeRows(int numRows) {
 
     return true;
 }
+
+bool SkEncoder::encodeRows(const SkPixmap& rows) {
+    // Rows fed after the last one are ignored, so don't trip encodeRows(int)'s assert on them.
+    if (fCurrRow >= fSrc.height()) {
+        return false;
+    }
+    if (!rows.addr() || rows.height() <= 0 ||
+        rows.width() != fSrc.width() ||
+        rows.colorType() != fSrc.colorType() ||
+        rows.alphaType() != fSrc.alphaType()) {
+        return false;
+    }
+
+    fRows = rows;
+    bool success = this->encodeRows(rows.height());
+    fRows.reset();
+    return success;
+}
+
+bool SkEncoder::encodeBands(int bandHeight, const std::function<void(SkCanvas*)>& draw) {
+    if (bandHeight <= 0 || fCurrRow >= fSrc.height()) {
+        return false;
+    }
+
+    SkBitmap band;
+    bandHeight = std::min(bandHeight, fSrc.height() - fCurrRow);
+    if (!band.tryAllocPixels(fSrc.info().makeWH(fSrc.width(), bandHeight))) {
+        return false;
+    }
+
+    while (fCurrRow < fSrc.height()) {
+        const int top = fCurrRow;
+        band.eraseColor(SK_ColorTRANSPARENT);
+        {
+            SkCanvas canvas(band);
+            canvas.translate(0, -SkIntToScalar(top));
+            draw(&canvas);
+        }
+
+        SkPixmap rows;
+        const int numRows = std::min(bandHeight, fSrc.height() - top);
+        if (!band.pixmap().extractSubset(&rows, SkIRect::MakeWH(fSrc.width(), numRows)) ||
+            !this->encodeRows(rows)) {
+            return false;
+        }
+    }
+    return true;
+}
@@ -32,6 +32,9 @@ bool SkJpegEncoder::Encode(SkWStream*, const SkPixmap&, const Options&) { return
 std::unique_ptr<SkEncoder> SkJpegEncoder::Make(SkWStream*, const SkPixmap&, const Options&) {
     return nullptr;
 }
+std::unique_ptr<SkEncoder> SkJpegEncoder::Make(SkWStream*, const SkImageInfo&, const Options&) {
+    return nullptr;
+}
 #endif
 
 #if !defined(SK_ENCODE_PNG)
@@ -39,6 +42,9 @@ bool SkPngEncoder::Encode(SkWStream*, const SkPixmap&, const Options&) { return
 std::unique_ptr<SkEncoder> SkPngEncoder::Make(SkWStream*, const SkPixmap&, const Options&) {
     return nullptr;
 }
+std::unique_ptr<SkEncoder> SkPngEncoder::Make(SkWStream*, const SkImageInfo&, const Options&) {
+    return nullptr;
+}
 #endif
 
 #if !defined(SK_ENCODE_WEBP)
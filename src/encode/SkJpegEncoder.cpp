@@ -259,6 +259,16 @@ bool SkJpegEncoderMgr::setParams(const SkYUVAPixmapInfo& srcInfo,
 std::unique_ptr<SkEncoder> SkJpegEncoder::Make(SkWStream* dst,
                                                const SkPixmap& src,
                                                const Options& options) {
+    if (!SkPixmapIsValid(src)) {
+        return nullptr;
+    }
+    return Make(dst, &src, nullptr, nullptr, options);
+}
+
+std::unique_ptr<SkEncoder> SkJpegEncoder::Make(SkWStream* dst,
+                                               const SkImageInfo& info,
+                                               const Options& options) {
+    SkPixmap src(info, nullptr, info.minRowBytes());
     return Make(dst, &src, nullptr, nullptr, options);
 }
 
@@ -282,7 +292,7 @@ std::unique_ptr<SkEncoder> SkJpegEncoder::Make(SkWStream* dst,
         }
     } else {
         SkASSERT(src);
-        if (!src || !SkPixmapIsValid(*src)) {
+        if (!src || !SkImageInfoIsValid(src->info())) {
             return nullptr;
         }
     }
@@ -362,6 +372,11 @@ bool SkJpegEncoder::onEncodeRows(int numRows) {
     }
 
     if (fSrcYUVA) {
+        // The planes are only ever read from |fSrcYUVA|.
+        if (fRows.addr()) {
+            return false;
+        }
+
         // TODO(ccameron): Consider using jpeg_write_raw_data, to avoid having to re-pack the data.
         for (int i = 0; i < numRows; i++) {
             yuva_copy_row(fSrcYUVA, fCurrRow + i, fStorage.get());
@@ -371,8 +386,8 @@ bool SkJpegEncoder::onEncodeRows(int numRows) {
     } else {
         const size_t srcBytes = SkColorTypeBytesPerPixel(fSrc.colorType()) * fSrc.width();
         const size_t jpegSrcBytes = fEncoderMgr->cinfo()->input_components * fSrc.width();
-        const void* srcRow = fSrc.addr(0, fCurrRow);
         for (int i = 0; i < numRows; i++) {
+            const void* srcRow = this->currRowAddr(i);
             JSAMPLE* jpegSrcRow = (JSAMPLE*)srcRow;
             if (fEncoderMgr->proc()) {
                 sk_msan_assert_initialized(srcRow, SkTAddOffset<const void>(srcRow, srcBytes));
@@ -391,7 +406,6 @@ bool SkJpegEncoder::onEncodeRows(int numRows) {
             }
 
             jpeg_write_scanlines(fEncoderMgr->cinfo(), &jpegSrcRow, 1);
-            srcRow = SkTAddOffset<const void>(srcRow, fSrc.rowBytes());
         }
     }
 
@@ -14,6 +14,7 @@
 #include "include/core/SkColorType.h"
 #include "include/core/SkData.h"
 #include "include/core/SkDataTable.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkPixmap.h"
 #include "include/core/SkRefCnt.h"
@@ -27,12 +28,16 @@
 #include "modules/skcms/skcms.h"
 #include "src/base/SkMSAN.h"
 #include "src/codec/SkPngPriv.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/encode/SkImageEncoderFns.h"
 #include "src/encode/SkImageEncoderPriv.h"
 
 #include <algorithm>
+#include <atomic>
 #include <csetjmp>
 #include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <memory>
 #include <string>
 #include <utility>
@@ -40,6 +45,7 @@
 
 #include <png.h>
 #include <pngconf.h>
+#include <zlib.h>
 
 static_assert(PNG_FILTER_NONE  == (int)SkPngEncoder::FilterFlag::kNone,  "Skia libpng filter err.");
 static_assert(PNG_FILTER_SUB   == (int)SkPngEncoder::FilterFlag::kSub,   "Skia libpng filter err.");
@@ -78,6 +84,8 @@ public:
     bool setColorSpace(const SkImageInfo& info, const SkPngEncoder::Options& options);
     bool writeInfo(const SkImageInfo& srcInfo);
     void chooseProc(const SkImageInfo& srcInfo);
+    bool canWriteBandsInParallel(const SkPixmap& src) const;
+    bool writeBandsInParallel(const SkPixmap& src, const SkPngEncoder::Options& options);
 
     png_structp pngPtr() { return fPngPtr; }
     png_infop infoPtr() { return fInfoPtr; }
@@ -99,6 +107,7 @@ private:
     png_infop               fInfoPtr;
     int                     fPngBytesPerPixel;
     transform_scanline_proc fProc;
+    bool                    fHasFiller = false;
 };
 
 std::unique_ptr<SkPngEncoderMgr> SkPngEncoderMgr::Make(SkWStream* stream) {
@@ -414,6 +423,7 @@ bool SkPngEncoderMgr::writeInfo(const SkImageInfo& srcInfo) {
         // For kOpaque, kRGBA_F16, we will keep the row as RGBA and tell libpng
         // to skip the alpha channel.
         png_set_filler(fPngPtr, 0, PNG_FILLER_AFTER);
+        fHasFiller = true;
     }
 
     return true;
@@ -423,12 +433,197 @@ void SkPngEncoderMgr::chooseProc(const SkImageInfo& srcInfo) {
     fProc = choose_proc(srcInfo);
 }
 
+// In parallel mode, each band of rows is filtered and deflated independently.  Every band but
+// the last ends with a sync flush, so the raw deflate streams can simply be concatenated, and each
+// band is primed with the 32K of filtered data before it so compression barely suffers.  We wrap
+// the result in a zlib header and a combined Adler-32, and write it out as IDAT chunks.
+static constexpr size_t kParallelBandBytes = 1 << 20;
+static constexpr size_t kDeflateWindow     = 1 << 15;
+
+// Returns the sum of absolute values of the filtered bytes (as signed), as libpng does when
+// choosing between filters.
+static size_t filter_row(int filter, const uint8_t* row, const uint8_t* prev, size_t len, int bpp,
+                         uint8_t* dst) {
+    auto paeth = [](int a, int b, int c) {
+        int p = a + b - c,
+            pa = std::abs(p - a),
+            pb = std::abs(p - b),
+            pc = std::abs(p - c);
+        return (pa <= pb && pa <= pc) ? a : (pb <= pc) ? b : c;
+    };
+
+    size_t sum = 0;
+    *dst++ = (uint8_t)filter;
+    for (size_t i = 0; i < len; i++) {
+        const int a = i >= (size_t)bpp ? row[i - bpp] : 0,
+                  b = prev[i],
+                  c = i >= (size_t)bpp ? prev[i - bpp] : 0;
+        int predictor = 0;
+        switch (filter) {
+            case 1: predictor = a;               break;
+            case 2: predictor = b;               break;
+            case 3: predictor = (a + b) >> 1;    break;
+            case 4: predictor = paeth(a, b, c);  break;
+        }
+        const uint8_t v = (uint8_t)(row[i] - predictor);
+        dst[i] = v;
+        sum += v < 128 ? v : 256 - v;
+    }
+    return sum;
+}
+
+bool SkPngEncoderMgr::canWriteBandsInParallel(const SkPixmap& src) const {
+    // libpng strips filler bytes as it writes rows, so we leave those images to it.
+    const size_t rowBytes = (size_t)fPngBytesPerPixel * src.width() + 1;
+    return fProc && !fHasFiller && (size_t)src.height() * rowBytes > kParallelBandBytes;
+}
+
+bool SkPngEncoderMgr::writeBandsInParallel(const SkPixmap& src,
+                                           const SkPngEncoder::Options& options) {
+    SkASSERT(options.fExecutor && this->canWriteBandsInParallel(src));
+
+    static constexpr int kFilterBits[] = { PNG_FILTER_NONE, PNG_FILTER_SUB, PNG_FILTER_UP,
+                                           PNG_FILTER_AVG,  PNG_FILTER_PAETH };
+    std::vector<int> filters;
+    for (int i = 0; i < 5; i++) {
+        if ((int)options.fFilterFlags & kFilterBits[i]) {
+            filters.push_back(i);
+        }
+    }
+    if (filters.empty()) {
+        filters.push_back(0);
+    }
+
+    const int    bpp         = fPngBytesPerPixel;
+    const size_t pngRowBytes = (size_t)bpp * src.width();
+    const size_t rowBytes    = pngRowBytes + 1;  // Each filtered row starts with its filter type.
+    const int    rowsPerBand = std::max<int>(1, kParallelBandBytes / rowBytes);
+    const int    bands       = (src.height() + rowsPerBand - 1) / rowsPerBand;
+    const int    zlibLevel   = std::min(std::max(0, options.fZLibLevel), 9);
+    // Like libpng, use Z_FILTERED for anything but unfiltered rows.
+    const int    strategy    = filters.size() == 1 && filters[0] == 0 ? Z_DEFAULT_STRATEGY
+                                                                      : Z_FILTERED;
+
+    std::unique_ptr<uint8_t[]> filtered(new uint8_t[rowBytes * src.height()]);
+    std::vector<std::vector<uint8_t>> deflated(bands);
+    std::vector<uLong> adlers(bands);
+    std::atomic<bool> ok{true};
+
+    SkTaskGroup tg(*options.fExecutor);
+
+    // First filter all the bands, each starting from the row above it (or zeros for the first).
+    tg.batch(bands, [&](int band) {
+        const int y0 = band * rowsPerBand,
+                  y1 = std::min(src.height(), y0 + rowsPerBand);
+        const int srcBpp = SkColorTypeBytesPerPixel(src.colorType());
+
+        std::vector<uint8_t> prev(pngRowBytes, 0), row(pngRowBytes), scratch(rowBytes);
+        if (y0 > 0) {
+            fProc((char*)prev.data(), (const char*)src.addr(0, y0 - 1), src.width(), srcBpp);
+        }
+        for (int y = y0; y < y1; y++) {
+            fProc((char*)row.data(), (const char*)src.addr(0, y), src.width(), srcBpp);
+
+            uint8_t* dst = filtered.get() + rowBytes * y;
+            size_t best = filter_row(filters[0], row.data(), prev.data(), pngRowBytes, bpp, dst);
+            for (size_t f = 1; f < filters.size(); f++) {
+                size_t sum = filter_row(filters[f], row.data(), prev.data(), pngRowBytes, bpp,
+                                        scratch.data());
+                if (sum < best) {
+                    best = sum;
+                    memcpy(dst, scratch.data(), rowBytes);
+                }
+            }
+            std::swap(prev, row);
+        }
+    });
+    tg.wait();
+
+    // Then deflate each band, primed with the window of filtered data that precedes it.
+    tg.batch(bands, [&](int band) {
+        const uint8_t* data = filtered.get() + rowBytes * rowsPerBand * band;
+        const size_t   len  = rowBytes * (std::min(src.height(), (band + 1) * rowsPerBand) -
+                                          band * rowsPerBand);
+        const bool     last = band == bands - 1;
+
+        z_stream z = {};
+        if (Z_OK != deflateInit2(&z, zlibLevel, Z_DEFLATED, -15 /*raw*/, 8, strategy)) {
+            ok = false;
+            return;
+        }
+        if (band > 0) {
+            const size_t dictLen = std::min(kDeflateWindow, (size_t)(data - filtered.get()));
+            deflateSetDictionary(&z, data - dictLen, dictLen);
+        }
+
+        std::vector<uint8_t>& out = deflated[band];
+        out.resize(deflateBound(&z, len) + 16);
+        z.next_in   = const_cast<uint8_t*>(data);
+        z.avail_in  = len;
+        z.next_out  = out.data();
+        z.avail_out = out.size();
+        const int result = deflate(&z, last ? Z_FINISH : Z_SYNC_FLUSH);
+        if (result != (last ? Z_STREAM_END : Z_OK) || z.avail_in != 0 || z.avail_out == 0) {
+            ok = false;
+        }
+        out.resize(out.size() - z.avail_out);
+        deflateEnd(&z);
+
+        adlers[band] = adler32(adler32(0, nullptr, 0), data, len);
+    });
+    tg.wait();
+
+    if (!ok) {
+        return false;
+    }
+
+    // The zlib header is two bytes: 32K deflate window, then a compression level hint and check.
+    const uint8_t cmf = 0x78;
+    uint8_t flg = (zlibLevel < 2 ? 0 : zlibLevel < 6 ? 1 : zlibLevel == 6 ? 2 : 3) << 6;
+    flg += (31 - (cmf * 256 + flg) % 31) % 31;
+    deflated.front().insert(deflated.front().begin(), {cmf, flg});
+
+    uLong adler = adlers[0];
+    for (int band = 1; band < bands; band++) {
+        const size_t len = rowBytes * (std::min(src.height(), (band + 1) * rowsPerBand) -
+                                       band * rowsPerBand);
+        adler = adler32_combine(adler, adlers[band], len);
+    }
+    deflated.back().insert(deflated.back().end(), { (uint8_t)(adler >> 24), (uint8_t)(adler >> 16),
+                                                    (uint8_t)(adler >>  8), (uint8_t)(adler >>  0) });
+
+    if (setjmp(png_jmpbuf(fPngPtr))) {
+        return false;
+    }
+    for (const std::vector<uint8_t>& idat : deflated) {
+        if (!idat.empty()) {
+            png_write_chunk(fPngPtr, (png_const_bytep)"IDAT", idat.data(), idat.size());
+        }
+    }
+    png_write_chunk(fPngPtr, (png_const_bytep)"IEND", nullptr, 0);
+    return true;
+}
+
 std::unique_ptr<SkEncoder> SkPngEncoder::Make(SkWStream* dst, const SkPixmap& src,
                                               const Options& options) {
     if (!SkPixmapIsValid(src)) {
         return nullptr;
     }
 
+    return MakeEncoder(dst, src, options);
+}
+
+std::unique_ptr<SkEncoder> SkPngEncoder::Make(SkWStream* dst, const SkImageInfo& info,
+                                              const Options& options) {
+    if (!SkImageInfoIsValid(info)) {
+        return nullptr;
+    }
+
+    return MakeEncoder(dst, SkPixmap(info, nullptr, info.minRowBytes()), options);
+}
+
+std::unique_ptr<SkEncoder> SkPngEncoder::MakeEncoder(SkWStream* dst, const SkPixmap& src,
+                                                     const Options& options) {
     std::unique_ptr<SkPngEncoderMgr> encoderMgr = SkPngEncoderMgr::Make(dst);
     if (!encoderMgr) {
         return nullptr;
@@ -463,8 +658,8 @@ bool SkPngEncoder::onEncodeRows(int numRows) {
         return false;
     }
 
-    const void* srcRow = fSrc.addr(0, fCurrRow);
     for (int y = 0; y < numRows; y++) {
+        const void* srcRow = this->currRowAddr(y);
         sk_msan_assert_initialized(srcRow,
                                    (const uint8_t*)srcRow + (fSrc.width() << fSrc.shiftPerPixel()));
         fEncoderMgr->proc()((char*)fStorage.get(),
@@ -474,7 +669,6 @@ bool SkPngEncoder::onEncodeRows(int numRows) {
 
         png_bytep rowPtr = (png_bytep) fStorage.get();
         png_write_rows(fEncoderMgr->pngPtr(), &rowPtr, 1);
-        srcRow = SkTAddOffset<const void>(srcRow, fSrc.rowBytes());
     }
 
     fCurrRow += numRows;
@@ -487,7 +681,15 @@ bool SkPngEncoder::onEncodeRows(int numRows) {
 
 bool SkPngEncoder::Encode(SkWStream* dst, const SkPixmap& src, const Options& options) {
     auto encoder = SkPngEncoder::Make(dst, src, options);
-    return encoder.get() && encoder->encodeRows(src.height());
+    if (!encoder) {
+        return false;
+    }
+
+    SkPngEncoderMgr* mgr = static_cast<SkPngEncoder*>(encoder.get())->fEncoderMgr.get();
+    if (options.fExecutor && mgr->canWriteBandsInParallel(src)) {
+        return mgr->writeBandsInParallel(src, options);
+    }
+    return encoder->encodeRows(src.height());
 }
 
 #endif
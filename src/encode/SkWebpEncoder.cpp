@@ -85,8 +85,13 @@ static bool preprocess_webp_picture(WebPPicture* pic,
     } else {
         webp_config->lossless = 1;
         webp_config->method = 0;
+        if (opts.fFastLossless) {
+            webp_config->quality = 0;
+            webp_config->image_hint = WEBP_HINT_GRAPH;
+        }
         pic->use_argb = 1;
     }
+    webp_config->thread_level = opts.fMultithreaded ? 1 : 0;
 
     {
         const SkColorType ct = pixmap.colorType();
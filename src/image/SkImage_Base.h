@@ -83,6 +83,12 @@ public:
         return sk_ref_sp(this->onPeekMips());
     }
 
+    // Builds the mipmaps that the raster cache keeps for this image from base, the pixels
+    // returned by getROPixels().
+    virtual SkMipmap* onMakeRasterMips(const SkBitmap& base, SkDiscardableFactoryProc fact) const {
+        return SkMipmap::Build(base, fact);
+    }
+
     /**
      * Default implementation does a rescale/read and then calls the callback.
      */
@@ -201,6 +201,17 @@ bool SkImage_Lazy::getROPixels(GrDirectContext* ctx, SkBitmap* bitmap,
     return true;
 }
 
+SkMipmap* SkImage_Lazy::onMakeRasterMips(const SkBitmap& base,
+                                         SkDiscardableFactoryProc fact) const {
+    SkPixmap pmap;
+    if (base.peekPixels(&pmap)) {
+        if (SkMipmap* mips = ScopedGenerator(fSharedGenerator)->onMakeMipmaps(pmap, fact)) {
+            return mips;
+        }
+    }
+    return SkImage_Base::onMakeRasterMips(base, fact);
+}
+
 bool SkImage_Lazy::readPixelsProxy(GrDirectContext* ctx, const SkPixmap& pixmap) const {
 #if defined(SK_GANESH)
     if (!ctx) {
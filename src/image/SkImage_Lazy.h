@@ -85,6 +85,7 @@ public:
                                                 RequiredImageProperties) const override;
 #endif
     bool getROPixels(GrDirectContext*, SkBitmap*, CachingHint) const override;
+    SkMipmap* onMakeRasterMips(const SkBitmap&, SkDiscardableFactoryProc) const override;
     bool onIsLazyGenerated() const override { return true; }
     sk_sp<SkImage> onMakeColorTypeAndColorSpace(SkColorType, sk_sp<SkColorSpace>,
                                                 GrDirectContext*) const override;
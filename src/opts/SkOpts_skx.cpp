@@ -10,10 +10,47 @@
 #if !defined(SK_ENABLE_OPTIMIZE_SIZE)
 
 #define SK_OPTS_NS skx
+#include "src/opts/SkRasterPipeline_opts.h"
+#include "src/opts/SkSwizzler_opts.h"
 #include "src/opts/SkVM_opts.h"
 
 namespace SkOpts {
+    void Init_RasterPipeline_skx() {
+        raster_pipeline_lowp_stride  = SK_OPTS_NS::raster_pipeline_lowp_stride();
+        raster_pipeline_highp_stride = SK_OPTS_NS::raster_pipeline_highp_stride();
+
+    #define M(st) ops_highp[(int)SkRasterPipelineOp::st] = (StageFn)SK_OPTS_NS::st;
+        SK_RASTER_PIPELINE_OPS_ALL(M)
+        just_return_highp = (StageFn)SK_OPTS_NS::just_return;
+        start_pipeline_highp = SK_OPTS_NS::start_pipeline;
+    #undef M
+
+    #define M(st) ops_lowp[(int)SkRasterPipelineOp::st] = (StageFn)SK_OPTS_NS::lowp::st;
+        SK_RASTER_PIPELINE_OPS_LOWP(M)
+        just_return_lowp = (StageFn)SK_OPTS_NS::lowp::just_return;
+        start_pipeline_lowp = SK_OPTS_NS::lowp::start_pipeline;
+    #undef M
+    }
+
     void Init_skx() {
+        RGBA_to_BGRA          = SK_OPTS_NS::RGBA_to_BGRA;
+        RGBA_to_rgbA          = SK_OPTS_NS::RGBA_to_rgbA;
+        RGBA_to_bgrA          = SK_OPTS_NS::RGBA_to_bgrA;
+        RGB_to_RGB1           = SK_OPTS_NS::RGB_to_RGB1;
+        RGB_to_BGR1           = SK_OPTS_NS::RGB_to_BGR1;
+        grayA_to_RGBA         = SK_OPTS_NS::grayA_to_RGBA;
+        grayA_to_rgbA         = SK_OPTS_NS::grayA_to_rgbA;
+        RGB16_to_RGB1         = SK_OPTS_NS::RGB16_to_RGB1;
+        RGB16_to_BGR1         = SK_OPTS_NS::RGB16_to_BGR1;
+        RGBA16_to_RGBA        = SK_OPTS_NS::RGBA16_to_RGBA;
+        RGBA16_to_BGRA        = SK_OPTS_NS::RGBA16_to_BGRA;
+        index_to_8888         = SK_OPTS_NS::index_to_8888;
+        small_index_to_8888   = SK_OPTS_NS::small_index_to_8888;
+        inverted_CMYK_to_RGB1 = SK_OPTS_NS::inverted_CMYK_to_RGB1;
+        inverted_CMYK_to_BGR1 = SK_OPTS_NS::inverted_CMYK_to_BGR1;
+
+        Init_RasterPipeline_skx();
+
         interpret_skvm = SK_OPTS_NS::interpret_skvm;
     }
 }  // namespace SkOpts
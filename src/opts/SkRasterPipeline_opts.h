@@ -347,7 +347,7 @@ namespace SK_OPTS_NS {
         }
     }
 
-#elif defined(JUMPER_IS_HSW) || defined(JUMPER_IS_SKX)
+#elif defined(JUMPER_IS_HSW)
     // These are __m256 and __m256i, but friendlier and strongly-typed.
     template <typename T> using V = T __attribute__((ext_vector_type(8)));
     using F   = V<float   >;
@@ -704,6 +704,241 @@ namespace SK_OPTS_NS {
         }
     }
 
+#elif defined(JUMPER_IS_SKX)
+    // These are __m512 and __m512i, but friendlier and strongly-typed.
+    template <typename T> using V = T __attribute__((ext_vector_type(16)));
+    using F   = V<float   >;
+    using I32 = V< int32_t>;
+    using U64 = V<uint64_t>;
+    using U32 = V<uint32_t>;
+    using U16 = V<uint16_t>;
+    using U8  = V<uint8_t >;
+
+    SI F mad(F f, F m, F a)  { return _mm512_fmadd_ps(f,m,a); }
+
+    SI F   min(F a, F b)     { return _mm512_min_ps(a,b);    }
+    SI I32 min(I32 a, I32 b) { return _mm512_min_epi32(a,b); }
+    SI U32 min(U32 a, U32 b) { return _mm512_min_epu32(a,b); }
+    SI F   max(F a, F b)     { return _mm512_max_ps(a,b);    }
+    SI I32 max(I32 a, I32 b) { return _mm512_max_epi32(a,b); }
+    SI U32 max(U32 a, U32 b) { return _mm512_max_epu32(a,b); }
+
+    SI F   abs_  (F v)   { return _mm512_abs_ps(v);      }
+    SI I32 abs_  (I32 v) { return _mm512_abs_epi32(v);   }
+    SI F   floor_(F v)   { return _mm512_roundscale_ps(v, _MM_FROUND_TO_NEG_INF|_MM_FROUND_NO_EXC); }
+    SI F   ceil_(F v)    { return _mm512_roundscale_ps(v, _MM_FROUND_TO_POS_INF|_MM_FROUND_NO_EXC); }
+    SI F   rcp_fast(F v) { return _mm512_rcp14_ps  (v);  }
+    SI F   rsqrt (F v)   { return _mm512_rsqrt14_ps(v);  }
+    SI F   sqrt_ (F v)   { return _mm512_sqrt_ps   (v);  }
+    SI F rcp_precise (F v) {
+        F e = rcp_fast(v);
+        return _mm512_fnmadd_ps(v, e, _mm512_set1_ps(2.0f)) * e;
+    }
+
+    SI U32 round (F v, F scale) { return _mm512_cvtps_epi32(v*scale); }
+    SI U16 pack(U32 v) {
+        // Saturate like _mm_packus_epi32(): negative lanes become 0, large ones 65535.
+        return _mm512_cvtusepi32_epi16(_mm512_max_epi32(v, _mm512_setzero_si512()));
+    }
+    SI U8 pack(U16 v) {
+        return _mm256_cvtusepi16_epi8(_mm256_max_epi16(v, _mm256_setzero_si256()));
+    }
+
+    SI F if_then_else(I32 c, F t, F e) {
+        return _mm512_mask_blend_ps(_mm512_movepi32_mask(c), e, t);
+    }
+    // NOTE: This version of 'all' only works with mask values (true == all bits set)
+    SI bool any(I32 c) { return _mm512_movepi32_mask(c) != 0;      }
+    SI bool all(I32 c) { return _mm512_movepi32_mask(c) == 0xffff; }
+
+    template <typename T>
+    SI V<T> gather(const T* p, U32 ix) {
+        return { p[ix[ 0]], p[ix[ 1]], p[ix[ 2]], p[ix[ 3]],
+                 p[ix[ 4]], p[ix[ 5]], p[ix[ 6]], p[ix[ 7]],
+                 p[ix[ 8]], p[ix[ 9]], p[ix[10]], p[ix[11]],
+                 p[ix[12]], p[ix[13]], p[ix[14]], p[ix[15]], };
+    }
+    SI F   gather(const float*    p, U32 ix) { return _mm512_i32gather_ps   (ix, p, 4); }
+    SI U32 gather(const uint32_t* p, U32 ix) { return _mm512_i32gather_epi32(ix, p, 4); }
+    SI U64 gather(const uint64_t* p, U32 ix) {
+        __m512i parts[] = {
+            _mm512_i32gather_epi64(_mm512_castsi512_si256    (ix   ), p, 8),
+            _mm512_i32gather_epi64(_mm512_extracti64x4_epi64(ix, 1), p, 8),
+        };
+        return sk_bit_cast<U64>(parts);
+    }
+
+    // Tails are handled with mask registers: a masked load or store touches only the memory of
+    // its enabled lanes, never faults on the rest, and costs about the same as an unmasked one.
+    // So there's no separate path for partial spans; a full span just enables every lane.
+
+    // The first n of a vector's 16 lanes, or all of them when n >= 16.
+    SI __mmask16 first_lanes(int n) { return _bzhi_u32(0xffff, n > 0 ? n : 0); }
+
+    // The first n of a vector's 64 bytes, or all of them when n >= 64.
+    SI __mmask64 first_bytes(int n) { return _bzhi_u64(~0ull, n > 0 ? n : 0); }
+
+    // Loads the first n Ts into a V, zeroing the rest, or stores the first n Ts of a V.
+    // These work on any V of 16, 32, or a multiple of 64 bytes, so lowp can use them too.
+    template <typename V, typename T>
+    SI V load_first(const T* ptr, size_t n) {
+        const int bytes = (int)(n * sizeof(T));
+        if constexpr (sizeof(V) == 16) {
+            return sk_bit_cast<V>(_mm_maskz_loadu_epi8(first_bytes(bytes), ptr));
+        } else if constexpr (sizeof(V) == 32) {
+            return sk_bit_cast<V>(_mm256_maskz_loadu_epi8(first_bytes(bytes), ptr));
+        } else {
+            static_assert(sizeof(V) % 64 == 0);
+            __m512i parts[sizeof(V) / 64];
+            for (int i = 0; i < (int)(sizeof(V) / 64); i++) {
+                parts[i] = _mm512_maskz_loadu_epi8(first_bytes(bytes - 64*i),
+                                                   (const char*)ptr + 64*i);
+            }
+            return sk_bit_cast<V>(parts);
+        }
+    }
+    template <typename V, typename T>
+    SI void store_first(T* ptr, size_t n, V v) {
+        const int bytes = (int)(n * sizeof(T));
+        if constexpr (sizeof(V) == 16) {
+            _mm_mask_storeu_epi8(ptr, first_bytes(bytes), sk_bit_cast<__m128i>(v));
+        } else if constexpr (sizeof(V) == 32) {
+            _mm256_mask_storeu_epi8(ptr, first_bytes(bytes), sk_bit_cast<__m256i>(v));
+        } else {
+            static_assert(sizeof(V) % 64 == 0);
+            __m512i parts[sizeof(V) / 64];
+            memcpy(parts, &v, sizeof(V));
+            for (int i = 0; i < (int)(sizeof(V) / 64); i++) {
+                _mm512_mask_storeu_epi8((char*)ptr + 64*i, first_bytes(bytes - 64*i), parts[i]);
+            }
+        }
+    }
+
+    SI void load2(const uint16_t* ptr, size_t tail, U16* r, U16* g) {
+        // Each pixel's r and g share a 32-bit lane.
+        const int n = tail ? (int)tail : 16;
+        __m512i rg = _mm512_maskz_loadu_epi32(first_lanes(n), ptr);
+        *r = _mm512_cvtepi32_epi16(rg);
+        *g = _mm512_cvtepi32_epi16(_mm512_srli_epi32(rg, 16));
+    }
+    SI void store2(uint16_t* ptr, size_t tail, U16 r, U16 g) {
+        const int n = tail ? (int)tail : 16;
+        __m512i rg = _mm512_or_si512(                  _mm512_cvtepu16_epi32(r),
+                                     _mm512_slli_epi32(_mm512_cvtepu16_epi32(g), 16));
+        _mm512_mask_storeu_epi32(ptr, first_lanes(n), rg);
+    }
+
+    SI void load3(const uint16_t* ptr, size_t tail, U16* r, U16* g, U16* b) {
+        // The 48 values span a 32-value and a 16-value vector; pick out every third value.
+        using U16x32 = uint16_t __attribute__((ext_vector_type(32)));
+        const int n = tail ? (int)tail : 16;
+        U16x32 lo = _mm512_maskz_loadu_epi16(_bzhi_u32(~0u, 3*n), ptr),
+               hi = _mm512_zextsi256_si512(
+                       _mm256_maskz_loadu_epi16(first_lanes(3*n - 32), ptr + 32));
+        *r = __builtin_shufflevector(lo, hi,  0, 3, 6, 9,12,15,18,21,24,27,30,33,36,39,42,45);
+        *g = __builtin_shufflevector(lo, hi,  1, 4, 7,10,13,16,19,22,25,28,31,34,37,40,43,46);
+        *b = __builtin_shufflevector(lo, hi,  2, 5, 8,11,14,17,20,23,26,29,32,35,38,41,44,47);
+    }
+    SI void load4(const uint16_t* ptr, size_t tail, U16* r, U16* g, U16* b, U16* a) {
+        // Each pixel is one 64-bit lane, eight to a vector; each channel is 16 bits of that lane.
+        const int n = tail ? (int)tail : 16;
+        __m512i _01234567 = _mm512_maskz_loadu_epi64(first_lanes(n    ), ptr     ),
+                _89abcdef = _mm512_maskz_loadu_epi64(first_lanes(n - 8), ptr + 32);
+        auto channel = [&](int shift) -> U16 {
+            return _mm256_inserti128_si256(
+                _mm256_castsi128_si256(_mm512_cvtepi64_epi16(_mm512_srli_epi64(_01234567, shift))),
+                                       _mm512_cvtepi64_epi16(_mm512_srli_epi64(_89abcdef, shift)),
+                1);
+        };
+        *r = channel( 0);
+        *g = channel(16);
+        *b = channel(32);
+        *a = channel(48);
+    }
+    SI void store4(uint16_t* ptr, size_t tail, U16 r, U16 g, U16 b, U16 a) {
+        const int n = tail ? (int)tail : 16;
+        auto pixels = [&](int half) {
+            auto widen = [&](U16 v, int shift) {
+                __m128i v8 = half ? _mm256_extracti128_si256(v, 1) : _mm256_castsi256_si128(v);
+                return _mm512_slli_epi64(_mm512_cvtepu16_epi64(v8), shift);
+            };
+            return _mm512_or_si512(_mm512_or_si512(widen(r, 0), widen(g, 16)),
+                                   _mm512_or_si512(widen(b,32), widen(a, 48)));
+        };
+        _mm512_mask_storeu_epi64(ptr     , first_lanes(n    ), pixels(0));
+        _mm512_mask_storeu_epi64(ptr + 32, first_lanes(n - 8), pixels(1));
+    }
+
+    SI void load2(const float* ptr, size_t tail, F* r, F* g) {
+        const int n = tail ? (int)tail : 16;
+        F _01234567 = _mm512_maskz_loadu_ps(first_lanes(2*n     ), ptr     ),
+          _89abcdef = _mm512_maskz_loadu_ps(first_lanes(2*n - 16), ptr + 16);
+        *r = __builtin_shufflevector(_01234567, _89abcdef,
+                                     0, 2, 4, 6, 8,10,12,14,16,18,20,22,24,26,28,30);
+        *g = __builtin_shufflevector(_01234567, _89abcdef,
+                                     1, 3, 5, 7, 9,11,13,15,17,19,21,23,25,27,29,31);
+    }
+    SI void store2(float* ptr, size_t tail, F r, F g) {
+        const int n = tail ? (int)tail : 16;
+        F _01234567 = __builtin_shufflevector(r, g, 0,16, 1,17, 2,18, 3,19,
+                                                    4,20, 5,21, 6,22, 7,23),
+          _89abcdef = __builtin_shufflevector(r, g, 8,24, 9,25,10,26,11,27,
+                                                   12,28,13,29,14,30,15,31);
+        _mm512_mask_storeu_ps(ptr     , first_lanes(2*n     ), _01234567);
+        _mm512_mask_storeu_ps(ptr + 16, first_lanes(2*n - 16), _89abcdef);
+    }
+
+    SI void load4(const float* ptr, size_t tail, F* r, F* g, F* b, F* a) {
+        const int n = tail ? (int)tail : 16;
+        F _0123 = _mm512_maskz_loadu_ps(first_lanes(4*n     ), ptr     ),
+          _4567 = _mm512_maskz_loadu_ps(first_lanes(4*n - 16), ptr + 16),
+          _89ab = _mm512_maskz_loadu_ps(first_lanes(4*n - 32), ptr + 32),
+          _cdef = _mm512_maskz_loadu_ps(first_lanes(4*n - 48), ptr + 48);
+
+        F rg01234567 = __builtin_shufflevector(_0123, _4567, 0, 1, 4, 5, 8, 9,12,13,   // r0 g0 r1 g1
+                                                             16,17,20,21,24,25,28,29), // ... r7 g7
+          ba01234567 = __builtin_shufflevector(_0123, _4567, 2, 3, 6, 7,10,11,14,15,
+                                                             18,19,22,23,26,27,30,31),
+          rg89abcdef = __builtin_shufflevector(_89ab, _cdef, 0, 1, 4, 5, 8, 9,12,13,
+                                                             16,17,20,21,24,25,28,29),
+          ba89abcdef = __builtin_shufflevector(_89ab, _cdef, 2, 3, 6, 7,10,11,14,15,
+                                                             18,19,22,23,26,27,30,31);
+
+        *r = __builtin_shufflevector(rg01234567, rg89abcdef,
+                                     0, 2, 4, 6, 8,10,12,14,16,18,20,22,24,26,28,30);
+        *g = __builtin_shufflevector(rg01234567, rg89abcdef,
+                                     1, 3, 5, 7, 9,11,13,15,17,19,21,23,25,27,29,31);
+        *b = __builtin_shufflevector(ba01234567, ba89abcdef,
+                                     0, 2, 4, 6, 8,10,12,14,16,18,20,22,24,26,28,30);
+        *a = __builtin_shufflevector(ba01234567, ba89abcdef,
+                                     1, 3, 5, 7, 9,11,13,15,17,19,21,23,25,27,29,31);
+    }
+    SI void store4(float* ptr, size_t tail, F r, F g, F b, F a) {
+        const int n = tail ? (int)tail : 16;
+        F rg01234567 = __builtin_shufflevector(r, g, 0,16, 1,17, 2,18, 3,19,   // r0 g0 r1 g1
+                                                     4,20, 5,21, 6,22, 7,23),  // ... r7 g7
+          rg89abcdef = __builtin_shufflevector(r, g, 8,24, 9,25,10,26,11,27,
+                                                    12,28,13,29,14,30,15,31),
+          ba01234567 = __builtin_shufflevector(b, a, 0,16, 1,17, 2,18, 3,19,
+                                                     4,20, 5,21, 6,22, 7,23),
+          ba89abcdef = __builtin_shufflevector(b, a, 8,24, 9,25,10,26,11,27,
+                                                    12,28,13,29,14,30,15,31);
+
+        F _0123 = __builtin_shufflevector(rg01234567, ba01234567, 0, 1,16,17, 2, 3,18,19,
+                                                                  4, 5,20,21, 6, 7,22,23),
+          _4567 = __builtin_shufflevector(rg01234567, ba01234567, 8, 9,24,25,10,11,26,27,
+                                                                 12,13,28,29,14,15,30,31),
+          _89ab = __builtin_shufflevector(rg89abcdef, ba89abcdef, 0, 1,16,17, 2, 3,18,19,
+                                                                  4, 5,20,21, 6, 7,22,23),
+          _cdef = __builtin_shufflevector(rg89abcdef, ba89abcdef, 8, 9,24,25,10,11,26,27,
+                                                                 12,13,28,29,14,15,30,31);
+
+        _mm512_mask_storeu_ps(ptr     , first_lanes(4*n     ), _0123);
+        _mm512_mask_storeu_ps(ptr + 16, first_lanes(4*n - 16), _4567);
+        _mm512_mask_storeu_ps(ptr + 32, first_lanes(4*n - 32), _89ab);
+        _mm512_mask_storeu_ps(ptr + 48, first_lanes(4*n - 48), _cdef);
+    }
+
 #elif defined(JUMPER_IS_SSE2) || defined(JUMPER_IS_SSE41) || defined(JUMPER_IS_AVX)
 template <typename T> using V = T __attribute__((ext_vector_type(4)));
     using F   = V<float   >;
@@ -1053,9 +1288,12 @@ SI F from_half(U16 h) {
     && !defined(SK_BUILD_FOR_GOOGLE3)  // Temporary workaround for some Google3 builds.
     return vcvt_f32_f16(h);
 
-#elif defined(JUMPER_IS_HSW) || defined(JUMPER_IS_SKX)
+#elif defined(JUMPER_IS_HSW)
     return _mm256_cvtph_ps(h);
 
+#elif defined(JUMPER_IS_SKX)
+    return _mm512_cvtph_ps(h);
+
 #else
     // Remember, a half is 1-5-10 (sign-exponent-mantissa) with 15 exponent bias.
     U32 sem = expand(h),
@@ -1074,9 +1312,12 @@ SI U16 to_half(F f) {
     && !defined(SK_BUILD_FOR_GOOGLE3)  // Temporary workaround for some Google3 builds.
     return vcvt_f16_f32(f);
 
-#elif defined(JUMPER_IS_HSW) || defined(JUMPER_IS_SKX)
+#elif defined(JUMPER_IS_HSW)
     return _mm256_cvtps_ph(f, _MM_FROUND_CUR_DIRECTION);
 
+#elif defined(JUMPER_IS_SKX)
+    return _mm512_cvtps_ph(f, _MM_FROUND_CUR_DIRECTION);
+
 #else
     // Remember, a float is 1-8-23 (sign-exponent-mantissa) with 127 exponent bias.
     U32 sem = sk_bit_cast<U32>(f),
@@ -1328,7 +1569,12 @@ static void start_pipeline(size_t dx, size_t dy,
 
 template <typename V, typename T>
 SI V load(const T* src, size_t tail) {
-#if !defined(JUMPER_IS_SCALAR)
+#if defined(JUMPER_IS_SKX)
+    __builtin_assume(tail < N);
+    if (__builtin_expect(tail, 0)) {
+        return load_first<V>(src, tail);
+    }
+#elif !defined(JUMPER_IS_SCALAR)
     __builtin_assume(tail < N);
     if (__builtin_expect(tail, 0)) {
         V v{};  // Any inactive lanes are zeroed.
@@ -1349,7 +1595,13 @@ SI V load(const T* src, size_t tail) {
 
 template <typename V, typename T>
 SI void store(T* dst, V v, size_t tail) {
-#if !defined(JUMPER_IS_SCALAR)
+#if defined(JUMPER_IS_SKX)
+    __builtin_assume(tail < N);
+    if (__builtin_expect(tail, 0)) {
+        store_first(dst, tail, v);
+        return;
+    }
+#elif !defined(JUMPER_IS_SCALAR)
     __builtin_assume(tail < N);
     if (__builtin_expect(tail, 0)) {
         switch (tail) {
@@ -1629,7 +1881,7 @@ STAGE(store_device_xy01, F* dst) {
 
 STAGE(dither, const float* rate) {
     // Get [(dx,dy), (dx+1,dy), (dx+2,dy), ...] loaded up in integer vectors.
-    uint32_t iota[] = {0,1,2,3,4,5,6,7};
+    uint32_t iota[] = {0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15};
     U32 X = dx + sk_unaligned_load<U32>(iota),
         Y = dy;
 
@@ -1921,7 +2173,9 @@ STAGE(luminosity, NoCtx) {
     a = a + da - a*da;
 }
 
-STAGE(srcover_rgba_8888, const SkRasterPipeline_MemoryCtx* ctx) {
+SI void srcover_rgba_8888_(const SkRasterPipeline_MemoryCtx* ctx, size_t dx, size_t dy,
+                           size_t tail, F& r, F& g, F& b, F& a,
+                           F& dr, F& dg, F& db, F& da) {
     auto ptr = ptr_at_xy<uint32_t>(ctx, dx,dy);
 
     U32 dst = load<U32>(ptr, tail);
@@ -1946,6 +2200,16 @@ STAGE(srcover_rgba_8888, const SkRasterPipeline_MemoryCtx* ctx) {
     store(ptr, dst, tail);
 }
 
+STAGE(srcover_rgba_8888, const SkRasterPipeline_MemoryCtx* ctx) {
+    srcover_rgba_8888_(ctx, dx,dy,tail, r,g,b,a, dr,dg,db,da);
+}
+
+// Fused runs of stages ending in srcover_rgba_8888 only exist in lowp; highp pipelines are never
+// fused (see SkRasterPipeline::fuse_lowp_tail()), so these entries are never used.
+static void (*uniform_color_srcover_rgba_8888)(void) = nullptr;
+static void (*scale_1_float_srcover_rgba_8888)(void) = nullptr;
+static void (*uniform_color_scale_1_float_srcover_rgba_8888)(void) = nullptr;
+
 SI F clamp_01_(F v) { return min(max(0.0f, v), 1.0f); }
 
 STAGE(clamp_01, NoCtx) {
@@ -2918,7 +3182,7 @@ STAGE(matrix_perspective, const float* m) {
 SI void gradient_lookup(const SkRasterPipeline_GradientCtx* c, U32 idx, F t,
                         F* r, F* g, F* b, F* a) {
     F fr, br, fg, bg, fb, bb, fa, ba;
-#if defined(JUMPER_IS_HSW) || defined(JUMPER_IS_SKX)
+#if defined(JUMPER_IS_HSW)
     if (c->stopCount <=8) {
         fr = _mm256_permutevar8x32_ps(_mm256_loadu_ps(c->fs[0]), idx);
         br = _mm256_permutevar8x32_ps(_mm256_loadu_ps(c->bs[0]), idx);
@@ -2929,6 +3193,17 @@ SI void gradient_lookup(const SkRasterPipeline_GradientCtx* c, U32 idx, F t,
         fa = _mm256_permutevar8x32_ps(_mm256_loadu_ps(c->fs[3]), idx);
         ba = _mm256_permutevar8x32_ps(_mm256_loadu_ps(c->bs[3]), idx);
     } else
+#elif defined(JUMPER_IS_SKX)
+    if (c->stopCount <= 16) {
+        fr = _mm512_permutexvar_ps(idx, _mm512_loadu_ps(c->fs[0]));
+        br = _mm512_permutexvar_ps(idx, _mm512_loadu_ps(c->bs[0]));
+        fg = _mm512_permutexvar_ps(idx, _mm512_loadu_ps(c->fs[1]));
+        bg = _mm512_permutexvar_ps(idx, _mm512_loadu_ps(c->bs[1]));
+        fb = _mm512_permutexvar_ps(idx, _mm512_loadu_ps(c->fs[2]));
+        bb = _mm512_permutexvar_ps(idx, _mm512_loadu_ps(c->bs[2]));
+        fa = _mm512_permutexvar_ps(idx, _mm512_loadu_ps(c->fs[3]));
+        ba = _mm512_permutexvar_ps(idx, _mm512_loadu_ps(c->bs[3]));
+    } else
 #endif
     {
         fr = gather(c->fs[0], idx);
@@ -3233,7 +3508,7 @@ STAGE(callback, SkRasterPipeline_CallbackCtx* c) {
                                                     sk_bit_cast<I32>(db))
 
 STAGE_TAIL(init_lane_masks, NoCtx) {
-    uint32_t iota[] = {0,1,2,3,4,5,6,7};
+    uint32_t iota[] = {0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15};
     I32 mask = tail ? cond_to_mask(sk_unaligned_load<U32>(iota) < tail) : I32(~0);
     dr = dg = db = da = sk_bit_cast<F>(mask);
 }
@@ -3963,7 +4238,16 @@ namespace lowp {
 
 #else  // We are compiling vector code with Clang... let's make some lowp stages!
 
-#if defined(JUMPER_IS_HSW) || defined(JUMPER_IS_SKX)
+#if defined(JUMPER_IS_SKX)
+    using U8  = uint8_t  __attribute__((ext_vector_type(32)));
+    using U16 = uint16_t __attribute__((ext_vector_type(32)));
+    using I16 =  int16_t __attribute__((ext_vector_type(32)));
+    using I32 =  int32_t __attribute__((ext_vector_type(32)));
+    using U32 = uint32_t __attribute__((ext_vector_type(32)));
+    using I64 =  int64_t __attribute__((ext_vector_type(32)));
+    using U64 = uint64_t __attribute__((ext_vector_type(32)));
+    using F   = float    __attribute__((ext_vector_type(32)));
+#elif defined(JUMPER_IS_HSW)
     using U8  = uint8_t  __attribute__((ext_vector_type(16)));
     using U16 = uint16_t __attribute__((ext_vector_type(16)));
     using I16 =  int16_t __attribute__((ext_vector_type(16)));
@@ -4236,7 +4520,11 @@ SI U32 trunc_(F x) { return (U32)cast<I32>(x); }
 
 // Use approximate instructions and one Newton-Raphson step to calculate 1/x.
 SI F rcp_precise(F x) {
-#if defined(JUMPER_IS_HSW) || defined(JUMPER_IS_SKX)
+#if defined(JUMPER_IS_SKX)
+    __m512 lo,hi;
+    split(x, &lo,&hi);
+    return join<F>(SK_OPTS_NS::rcp_precise(lo), SK_OPTS_NS::rcp_precise(hi));
+#elif defined(JUMPER_IS_HSW)
     __m256 lo,hi;
     split(x, &lo,&hi);
     return join<F>(SK_OPTS_NS::rcp_precise(lo), SK_OPTS_NS::rcp_precise(hi));
@@ -4253,7 +4541,11 @@ SI F rcp_precise(F x) {
 #endif
 }
 SI F sqrt_(F x) {
-#if defined(JUMPER_IS_HSW) || defined(JUMPER_IS_SKX)
+#if defined(JUMPER_IS_SKX)
+    __m512 lo,hi;
+    split(x, &lo,&hi);
+    return join<F>(_mm512_sqrt_ps(lo), _mm512_sqrt_ps(hi));
+#elif defined(JUMPER_IS_HSW)
     __m256 lo,hi;
     split(x, &lo,&hi);
     return join<F>(_mm256_sqrt_ps(lo), _mm256_sqrt_ps(hi));
@@ -4288,7 +4580,12 @@ SI F floor_(F x) {
     float32x4_t lo,hi;
     split(x, &lo,&hi);
     return join<F>(vrndmq_f32(lo), vrndmq_f32(hi));
-#elif defined(JUMPER_IS_HSW) || defined(JUMPER_IS_SKX)
+#elif defined(JUMPER_IS_SKX)
+    __m512 lo,hi;
+    split(x, &lo,&hi);
+    return join<F>(_mm512_roundscale_ps(lo, _MM_FROUND_TO_NEG_INF|_MM_FROUND_NO_EXC),
+                   _mm512_roundscale_ps(hi, _MM_FROUND_TO_NEG_INF|_MM_FROUND_NO_EXC));
+#elif defined(JUMPER_IS_HSW)
     __m256 lo,hi;
     split(x, &lo,&hi);
     return join<F>(_mm256_floor_ps(lo), _mm256_floor_ps(hi));
@@ -4308,7 +4605,9 @@ SI F floor_(F x) {
 // The result is a number on [-1, 1).
 // Note: on neon this is a saturating multiply while the others are not.
 SI I16 scaled_mult(I16 a, I16 b) {
-#if defined(JUMPER_IS_HSW) || defined(JUMPER_IS_SKX)
+#if defined(JUMPER_IS_SKX)
+    return _mm512_mulhrs_epi16(a, b);
+#elif defined(JUMPER_IS_HSW)
     return _mm256_mulhrs_epi16(a, b);
 #elif defined(JUMPER_IS_SSE41) || defined(JUMPER_IS_AVX)
     return _mm_mulhrs_epi16(a, b);
@@ -4347,8 +4646,10 @@ SI F abs_(F x) { return sk_bit_cast<F>( sk_bit_cast<I32>(x) & 0x7fffffff ); }
 
 STAGE_GG(seed_shader, NoCtx) {
     static constexpr float iota[] = {
-        0.5f, 1.5f, 2.5f, 3.5f, 4.5f, 5.5f, 6.5f, 7.5f,
-        8.5f, 9.5f,10.5f,11.5f,12.5f,13.5f,14.5f,15.5f,
+         0.5f, 1.5f, 2.5f, 3.5f, 4.5f, 5.5f, 6.5f, 7.5f,
+         8.5f, 9.5f,10.5f,11.5f,12.5f,13.5f,14.5f,15.5f,
+        16.5f,17.5f,18.5f,19.5f,20.5f,21.5f,22.5f,23.5f,
+        24.5f,25.5f,26.5f,27.5f,28.5f,29.5f,30.5f,31.5f,
     };
     x = cast<F>(I32(dx)) + sk_unaligned_load<F>(iota);
     y = cast<F>(I32(dy)) + 0.5f;
@@ -4556,10 +4857,16 @@ SI U32 ix_and_ptr(T** ptr, const SkRasterPipeline_GatherCtx* ctx, I32 x, I32 y)
 
 template <typename V, typename T>
 SI V load(const T* ptr, size_t tail) {
+#if defined(JUMPER_IS_SKX)
+    if (size_t n = tail & (N-1)) {
+        return load_first<V>(ptr, n);
+    }
+    return sk_unaligned_load<V>(ptr);
+#else
     V v = 0;
     switch (tail & (N-1)) {
         case  0: memcpy(&v, ptr, sizeof(v)); break;
-    #if defined(JUMPER_IS_HSW) || defined(JUMPER_IS_SKX)
+    #if defined(JUMPER_IS_HSW)
         case 15: v[14] = ptr[14]; [[fallthrough]];
         case 14: v[13] = ptr[13]; [[fallthrough]];
         case 13: v[12] = ptr[12]; [[fallthrough]];
@@ -4578,12 +4885,20 @@ SI V load(const T* ptr, size_t tail) {
         case  1: v[ 0] = ptr[ 0];
     }
     return v;
+#endif
 }
 template <typename V, typename T>
 SI void store(T* ptr, size_t tail, V v) {
+#if defined(JUMPER_IS_SKX)
+    if (size_t n = tail & (N-1)) {
+        store_first(ptr, n, v);
+        return;
+    }
+    sk_unaligned_store(ptr, v);
+#else
     switch (tail & (N-1)) {
         case  0: memcpy(ptr, &v, sizeof(v)); break;
-    #if defined(JUMPER_IS_HSW) || defined(JUMPER_IS_SKX)
+    #if defined(JUMPER_IS_HSW)
         case 15: ptr[14] = v[14]; [[fallthrough]];
         case 14: ptr[13] = v[13]; [[fallthrough]];
         case 13: ptr[12] = v[12]; [[fallthrough]];
@@ -4601,9 +4916,40 @@ SI void store(T* ptr, size_t tail, V v) {
         case  2: memcpy(ptr, &v,  2*sizeof(T)); break;
         case  1: ptr[ 0] = v[ 0];
     }
+#endif
 }
 
-#if defined(JUMPER_IS_HSW) || defined(JUMPER_IS_SKX)
+#if defined(JUMPER_IS_SKX)
+    template <typename V, typename T>
+    SI V gather(const T* ptr, U32 ix) {
+        return V{ ptr[ix[ 0]], ptr[ix[ 1]], ptr[ix[ 2]], ptr[ix[ 3]],
+                  ptr[ix[ 4]], ptr[ix[ 5]], ptr[ix[ 6]], ptr[ix[ 7]],
+                  ptr[ix[ 8]], ptr[ix[ 9]], ptr[ix[10]], ptr[ix[11]],
+                  ptr[ix[12]], ptr[ix[13]], ptr[ix[14]], ptr[ix[15]],
+                  ptr[ix[16]], ptr[ix[17]], ptr[ix[18]], ptr[ix[19]],
+                  ptr[ix[20]], ptr[ix[21]], ptr[ix[22]], ptr[ix[23]],
+                  ptr[ix[24]], ptr[ix[25]], ptr[ix[26]], ptr[ix[27]],
+                  ptr[ix[28]], ptr[ix[29]], ptr[ix[30]], ptr[ix[31]], };
+    }
+
+    template<>
+    F gather(const float* ptr, U32 ix) {
+        __m512i lo, hi;
+        split(ix, &lo, &hi);
+
+        return join<F>(_mm512_i32gather_ps(lo, ptr, 4),
+                       _mm512_i32gather_ps(hi, ptr, 4));
+    }
+
+    template<>
+    U32 gather(const uint32_t* ptr, U32 ix) {
+        __m512i lo, hi;
+        split(ix, &lo, &hi);
+
+        return join<U32>(_mm512_i32gather_epi32(lo, ptr, 4),
+                         _mm512_i32gather_epi32(hi, ptr, 4));
+    }
+#elif defined(JUMPER_IS_HSW)
     template <typename V, typename T>
     SI V gather(const T* ptr, U32 ix) {
         return V{ ptr[ix[ 0]], ptr[ix[ 1]], ptr[ix[ 2]], ptr[ix[ 3]],
@@ -4641,7 +4987,7 @@ SI void store(T* ptr, size_t tail, V v) {
 // ~~~~~~ 32-bit memory loads and stores ~~~~~~ //
 
 SI void from_8888(U32 rgba, U16* r, U16* g, U16* b, U16* a) {
-#if 1 && defined(JUMPER_IS_HSW) || defined(JUMPER_IS_SKX)
+#if 1 && defined(JUMPER_IS_HSW)
     // Swap the middle 128-bit lanes to make _mm256_packus_epi32() in cast_U16() work out nicely.
     __m256i _01,_23;
     split(rgba, &_01, &_23);
@@ -5122,7 +5468,29 @@ SI void gradient_lookup(const SkRasterPipeline_GradientCtx* c, U32 idx, F t,
                         U16* r, U16* g, U16* b, U16* a) {
 
     F fr, fg, fb, fa, br, bg, bb, ba;
-#if defined(JUMPER_IS_HSW) || defined(JUMPER_IS_SKX)
+#if defined(JUMPER_IS_SKX)
+    if (c->stopCount <= 16) {
+        __m512i lo, hi;
+        split(idx, &lo, &hi);
+
+        fr = join<F>(_mm512_permutexvar_ps(lo, _mm512_loadu_ps(c->fs[0])),
+                     _mm512_permutexvar_ps(hi, _mm512_loadu_ps(c->fs[0])));
+        br = join<F>(_mm512_permutexvar_ps(lo, _mm512_loadu_ps(c->bs[0])),
+                     _mm512_permutexvar_ps(hi, _mm512_loadu_ps(c->bs[0])));
+        fg = join<F>(_mm512_permutexvar_ps(lo, _mm512_loadu_ps(c->fs[1])),
+                     _mm512_permutexvar_ps(hi, _mm512_loadu_ps(c->fs[1])));
+        bg = join<F>(_mm512_permutexvar_ps(lo, _mm512_loadu_ps(c->bs[1])),
+                     _mm512_permutexvar_ps(hi, _mm512_loadu_ps(c->bs[1])));
+        fb = join<F>(_mm512_permutexvar_ps(lo, _mm512_loadu_ps(c->fs[2])),
+                     _mm512_permutexvar_ps(hi, _mm512_loadu_ps(c->fs[2])));
+        bb = join<F>(_mm512_permutexvar_ps(lo, _mm512_loadu_ps(c->bs[2])),
+                     _mm512_permutexvar_ps(hi, _mm512_loadu_ps(c->bs[2])));
+        fa = join<F>(_mm512_permutexvar_ps(lo, _mm512_loadu_ps(c->fs[3])),
+                     _mm512_permutexvar_ps(hi, _mm512_loadu_ps(c->fs[3])));
+        ba = join<F>(_mm512_permutexvar_ps(lo, _mm512_loadu_ps(c->bs[3])),
+                     _mm512_permutexvar_ps(hi, _mm512_loadu_ps(c->bs[3])));
+    } else
+#elif defined(JUMPER_IS_HSW)
     if (c->stopCount <=8) {
         __m256i lo, hi;
         split(idx, &lo, &hi);
@@ -5314,7 +5682,9 @@ STAGE_GG(xy_to_radius, NoCtx) {
 
 // ~~~~~~ Compound stages ~~~~~~ //
 
-STAGE_PP(srcover_rgba_8888, const SkRasterPipeline_MemoryCtx* ctx) {
+SI void srcover_rgba_8888_(const SkRasterPipeline_MemoryCtx* ctx, size_t dx, size_t dy,
+                           size_t tail, U16& r, U16& g, U16& b, U16& a,
+                           U16& dr, U16& dg, U16& db, U16& da) {
     auto ptr = ptr_at_xy<uint32_t>(ctx, dx,dy);
 
     load_8888_(ptr, tail, &dr,&dg,&db,&da);
@@ -5325,6 +5695,37 @@ STAGE_PP(srcover_rgba_8888, const SkRasterPipeline_MemoryCtx* ctx) {
     store_8888_(ptr, tail, r,g,b,a);
 }
 
+STAGE_PP(srcover_rgba_8888, const SkRasterPipeline_MemoryCtx* ctx) {
+    srcover_rgba_8888_(ctx, dx,dy,tail, r,g,b,a, dr,dg,db,da);
+}
+
+// Fused runs of stages ending in srcover_rgba_8888; see SkRasterPipeline::fuse_lowp_tail().
+// Each does exactly the math of the stages it replaces, without dispatching between them.
+STAGE_PP(uniform_color_srcover_rgba_8888, const SkRasterPipeline_SrcoverRGBA8888Ctx* ctx) {
+    r = ctx->color->rgba[0];
+    g = ctx->color->rgba[1];
+    b = ctx->color->rgba[2];
+    a = ctx->color->rgba[3];
+    srcover_rgba_8888_(ctx->dst, dx,dy,tail, r,g,b,a, dr,dg,db,da);
+}
+STAGE_PP(scale_1_float_srcover_rgba_8888, const SkRasterPipeline_SrcoverRGBA8888Ctx* ctx) {
+    U16 c = from_float(*ctx->coverage);
+    r = div255( r * c );
+    g = div255( g * c );
+    b = div255( b * c );
+    a = div255( a * c );
+    srcover_rgba_8888_(ctx->dst, dx,dy,tail, r,g,b,a, dr,dg,db,da);
+}
+STAGE_PP(uniform_color_scale_1_float_srcover_rgba_8888,
+         const SkRasterPipeline_SrcoverRGBA8888Ctx* ctx) {
+    U16 c = from_float(*ctx->coverage);
+    r = div255( ctx->color->rgba[0] * c );
+    g = div255( ctx->color->rgba[1] * c );
+    b = div255( ctx->color->rgba[2] * c );
+    a = div255( ctx->color->rgba[3] * c );
+    srcover_rgba_8888_(ctx->dst, dx,dy,tail, r,g,b,a, dr,dg,db,da);
+}
+
 // ~~~~~~ skgpu::Swizzle stage ~~~~~~ //
 
 STAGE_PP(swizzle, void* ctx) {
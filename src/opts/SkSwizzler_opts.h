@@ -10,6 +10,7 @@
 
 #include "include/private/SkColorData.h"
 #include "src/base/SkVx.h"
+#include <cstring>
 #include <utility>
 
 #if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSSE3
@@ -1250,7 +1251,7 @@ static void gray_to_RGB1_portable(uint32_t dst[], const uint8_t* src, int count)
     }
 #endif
 
-// Again as above, this time not even finding benefit from AVX2 for RGB_to_{RGB,BGR}1.
+// Again as above.
 static void RGB_to_RGB1_portable(uint32_t dst[], const uint8_t* src, int count) {
     for (int i = 0; i < count; i++) {
         uint8_t r = src[0],
@@ -1329,6 +1330,76 @@ static void RGB_to_BGR1_portable(uint32_t dst[], const uint8_t* src, int count)
         proc(dst, src, count);
     }
 
+    /*not static*/ inline void RGB_to_RGB1(uint32_t dst[], const uint8_t* src, int count) {
+        insert_alpha_should_swaprb(false, dst, src, count);
+    }
+    /*not static*/ inline void RGB_to_BGR1(uint32_t dst[], const uint8_t* src, int count) {
+        insert_alpha_should_swaprb(true, dst, src, count);
+    }
+#elif SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SKX
+    static void insert_alpha_should_swaprb(bool kSwapRB,
+                                           uint32_t dst[], const uint8_t* src, int count) {
+        const __m512i alphaMask = _mm512_set1_epi32(0xFF000000);
+        const uint8_t X = 0xFF; // Used a placeholder.  The value of X is irrelevant.
+        const __m512i expand = _mm512_broadcast_i32x4(kSwapRB
+                ? _mm_setr_epi8(2,1,0,X, 5,4,3,X, 8,7,6,X, 11,10,9,X)
+                : _mm_setr_epi8(0,1,2,X, 3,4,5,X, 6,7,8,X, 9,10,11,X));
+
+        // Each 128-bit lane expands four pixels from its own 16-byte load, so the last load
+        // reads four bytes past the sixteenth pixel.
+        while (count >= 18) {
+            __m512i rgb = _mm512_castsi128_si512(_mm_loadu_si128((const __m128i*)(src + 0)));
+            rgb = _mm512_inserti32x4(rgb, _mm_loadu_si128((const __m128i*)(src + 12)), 1);
+            rgb = _mm512_inserti32x4(rgb, _mm_loadu_si128((const __m128i*)(src + 24)), 2);
+            rgb = _mm512_inserti32x4(rgb, _mm_loadu_si128((const __m128i*)(src + 36)), 3);
+
+            __m512i rgba = _mm512_or_si512(_mm512_shuffle_epi8(rgb, expand), alphaMask);
+            _mm512_storeu_si512((__m512i*) dst, rgba);
+
+            src += 16*3;
+            dst += 16;
+            count -= 16;
+        }
+
+        // Call portable code to finish up the tail of [0,18) pixels.
+        auto proc = kSwapRB ? RGB_to_BGR1_portable : RGB_to_RGB1_portable;
+        proc(dst, src, count);
+    }
+
+    /*not static*/ inline void RGB_to_RGB1(uint32_t dst[], const uint8_t* src, int count) {
+        insert_alpha_should_swaprb(false, dst, src, count);
+    }
+    /*not static*/ inline void RGB_to_BGR1(uint32_t dst[], const uint8_t* src, int count) {
+        insert_alpha_should_swaprb(true, dst, src, count);
+    }
+#elif SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX2
+    static void insert_alpha_should_swaprb(bool kSwapRB,
+                                           uint32_t dst[], const uint8_t* src, int count) {
+        const __m256i alphaMask = _mm256_set1_epi32(0xFF000000);
+        const uint8_t X = 0xFF; // Used a placeholder.  The value of X is irrelevant.
+        const __m256i expand = _mm256_broadcastsi128_si256(kSwapRB
+                ? _mm_setr_epi8(2,1,0,X, 5,4,3,X, 8,7,6,X, 11,10,9,X)
+                : _mm_setr_epi8(0,1,2,X, 3,4,5,X, 6,7,8,X, 9,10,11,X));
+
+        // As above, each 128-bit lane expands four pixels from its own 16-byte load.
+        while (count >= 10) {
+            __m256i rgb = _mm256_inserti128_si256(
+                    _mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)(src + 0))),
+                    _mm_loadu_si128((const __m128i*)(src + 12)), 1);
+
+            __m256i rgba = _mm256_or_si256(_mm256_shuffle_epi8(rgb, expand), alphaMask);
+            _mm256_storeu_si256((__m256i*) dst, rgba);
+
+            src += 8*3;
+            dst += 8;
+            count -= 8;
+        }
+
+        // Call portable code to finish up the tail of [0,10) pixels.
+        auto proc = kSwapRB ? RGB_to_BGR1_portable : RGB_to_RGB1_portable;
+        proc(dst, src, count);
+    }
+
     /*not static*/ inline void RGB_to_RGB1(uint32_t dst[], const uint8_t* src, int count) {
         insert_alpha_should_swaprb(false, dst, src, count);
     }
@@ -1384,6 +1455,427 @@ static void RGB_to_BGR1_portable(uint32_t dst[], const uint8_t* src, int count)
     }
 #endif
 
+// 16-bit per channel (PNG) rows are big-endian, so we keep the first byte of each channel.
+static void RGB16_to_RGB1_portable(uint32_t dst[], const uint8_t* src, int count) {
+    for (int i = 0; i < count; i++) {
+        dst[i] = (uint32_t)0xFF   << 24
+               | (uint32_t)src[4] << 16
+               | (uint32_t)src[2] <<  8
+               | (uint32_t)src[0] <<  0;
+        src += 6;
+    }
+}
+static void RGB16_to_BGR1_portable(uint32_t dst[], const uint8_t* src, int count) {
+    for (int i = 0; i < count; i++) {
+        dst[i] = (uint32_t)0xFF   << 24
+               | (uint32_t)src[0] << 16
+               | (uint32_t)src[2] <<  8
+               | (uint32_t)src[4] <<  0;
+        src += 6;
+    }
+}
+static void RGBA16_to_RGBA_portable(uint32_t dst[], const uint8_t* src, int count) {
+    for (int i = 0; i < count; i++) {
+        dst[i] = (uint32_t)src[6] << 24
+               | (uint32_t)src[4] << 16
+               | (uint32_t)src[2] <<  8
+               | (uint32_t)src[0] <<  0;
+        src += 8;
+    }
+}
+static void RGBA16_to_BGRA_portable(uint32_t dst[], const uint8_t* src, int count) {
+    for (int i = 0; i < count; i++) {
+        dst[i] = (uint32_t)src[6] << 24
+               | (uint32_t)src[0] << 16
+               | (uint32_t)src[2] <<  8
+               | (uint32_t)src[4] <<  0;
+        src += 8;
+    }
+}
+#if defined(SK_ARM_HAS_NEON)
+    // Narrowing a little-endian 16-bit load keeps its low byte, i.e. the big-endian high byte.
+    static void rgb16_should_swaprb(bool kSwapRB, uint32_t dst[], const uint8_t* src, int count) {
+        while (count >= 8) {
+            uint16x8x3_t rgb = vld3q_u16((const uint16_t*) src);
+
+            uint8x8x4_t rgba;
+            rgba.val[0] = vmovn_u16(rgb.val[kSwapRB ? 2 : 0]);
+            rgba.val[1] = vmovn_u16(rgb.val[1]);
+            rgba.val[2] = vmovn_u16(rgb.val[kSwapRB ? 0 : 2]);
+            rgba.val[3] = vdup_n_u8(0xFF);
+
+            vst4_u8((uint8_t*) dst, rgba);
+            src += 8*6;
+            dst += 8;
+            count -= 8;
+        }
+
+        auto proc = kSwapRB ? RGB16_to_BGR1_portable : RGB16_to_RGB1_portable;
+        proc(dst, src, count);
+    }
+
+    static void rgba16_should_swaprb(bool kSwapRB, uint32_t dst[], const uint8_t* src, int count) {
+        while (count >= 8) {
+            uint16x8x4_t rgba16 = vld4q_u16((const uint16_t*) src);
+
+            uint8x8x4_t rgba;
+            rgba.val[0] = vmovn_u16(rgba16.val[kSwapRB ? 2 : 0]);
+            rgba.val[1] = vmovn_u16(rgba16.val[1]);
+            rgba.val[2] = vmovn_u16(rgba16.val[kSwapRB ? 0 : 2]);
+            rgba.val[3] = vmovn_u16(rgba16.val[3]);
+
+            vst4_u8((uint8_t*) dst, rgba);
+            src += 8*8;
+            dst += 8;
+            count -= 8;
+        }
+
+        auto proc = kSwapRB ? RGBA16_to_BGRA_portable : RGBA16_to_RGBA_portable;
+        proc(dst, src, count);
+    }
+#elif SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SKX
+    static void rgb16_should_swaprb(bool kSwapRB, uint32_t dst[], const uint8_t* src, int count) {
+        const __m512i alphaMask = _mm512_set1_epi32(0xFF000000);
+        const uint8_t X = 0xFF; // Used a placeholder.  The value of X is irrelevant.
+        const __m512i strip = _mm512_broadcast_i32x4(kSwapRB
+                ? _mm_setr_epi8(4,2,0,X, 10,8,6,X, X,X,X,X, X,X,X,X)
+                : _mm_setr_epi8(0,2,4,X, 6,8,10,X, X,X,X,X, X,X,X,X));
+        const __m512i order = _mm512_setr_epi64(0,2,4,6, 1,3,5,7);
+
+        auto load = [](const uint8_t* src) {
+            __m512i v = _mm512_castsi128_si512(_mm_loadu_si128((const __m128i*)(src + 0)));
+            v = _mm512_inserti32x4(v, _mm_loadu_si128((const __m128i*)(src + 12)), 1);
+            v = _mm512_inserti32x4(v, _mm_loadu_si128((const __m128i*)(src + 24)), 2);
+            v = _mm512_inserti32x4(v, _mm_loadu_si128((const __m128i*)(src + 36)), 3);
+            return v;
+        };
+
+        // Each 128-bit lane converts two pixels from its own 16-byte load, so the last load
+        // reads four bytes past the sixteenth pixel.
+        while (count >= 17) {
+            __m512i lo = _mm512_shuffle_epi8(load(src +  0), strip),
+                    hi = _mm512_shuffle_epi8(load(src + 48), strip);
+
+            // Lane i now holds pixels 2i and 2i+1 of lo, then 8+2i and 8+2i+1 of hi.
+            __m512i rgba = _mm512_permutexvar_epi64(order, _mm512_unpacklo_epi64(lo, hi));
+            _mm512_storeu_si512((__m512i*) dst, _mm512_or_si512(rgba, alphaMask));
+
+            src += 16*6;
+            dst += 16;
+            count -= 16;
+        }
+
+        auto proc = kSwapRB ? RGB16_to_BGR1_portable : RGB16_to_RGB1_portable;
+        proc(dst, src, count);
+    }
+
+    static void rgba16_should_swaprb(bool kSwapRB, uint32_t dst[], const uint8_t* src, int count) {
+        const __m512i lowBytes = _mm512_set1_epi16(0x00FF);
+        const __m512i swapRB = _mm512_broadcast_i32x4(
+                _mm_setr_epi8(2,1,0,3, 6,5,4,7, 10,9,8,11, 14,13,12,15));
+        const __m512i order = _mm512_setr_epi64(0,2,4,6, 1,3,5,7);
+
+        while (count >= 16) {
+            __m512i lo = _mm512_loadu_si512((const __m512i*)(src +  0)),
+                    hi = _mm512_loadu_si512((const __m512i*)(src + 64));
+
+            // Lane i of the packed vector holds pixels 2i and 2i+1, then 8+2i and 8+2i+1.
+            __m512i rgba = _mm512_packus_epi16(_mm512_and_si512(lo, lowBytes),
+                                               _mm512_and_si512(hi, lowBytes));
+            rgba = _mm512_permutexvar_epi64(order, rgba);
+            if (kSwapRB) {
+                rgba = _mm512_shuffle_epi8(rgba, swapRB);
+            }
+            _mm512_storeu_si512((__m512i*) dst, rgba);
+
+            src += 16*8;
+            dst += 16;
+            count -= 16;
+        }
+
+        auto proc = kSwapRB ? RGBA16_to_BGRA_portable : RGBA16_to_RGBA_portable;
+        proc(dst, src, count);
+    }
+#elif SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX2
+    static void rgb16_should_swaprb(bool kSwapRB, uint32_t dst[], const uint8_t* src, int count) {
+        const __m256i alphaMask = _mm256_set1_epi32(0xFF000000);
+        const uint8_t X = 0xFF; // Used a placeholder.  The value of X is irrelevant.
+        const __m256i strip = _mm256_broadcastsi128_si256(kSwapRB
+                ? _mm_setr_epi8(4,2,0,X, 10,8,6,X, X,X,X,X, X,X,X,X)
+                : _mm_setr_epi8(0,2,4,X, 6,8,10,X, X,X,X,X, X,X,X,X));
+
+        auto load = [](const uint8_t* src) {
+            return _mm256_inserti128_si256(
+                    _mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)(src + 0))),
+                    _mm_loadu_si128((const __m128i*)(src + 12)), 1);
+        };
+
+        // As above, each 128-bit lane converts two pixels from its own 16-byte load.
+        while (count >= 9) {
+            __m256i lo = _mm256_shuffle_epi8(load(src +  0), strip),
+                    hi = _mm256_shuffle_epi8(load(src + 24), strip);
+
+            // Pixels are now in the order 0 1 4 5 | 2 3 6 7.
+            __m256i rgba = _mm256_permute4x64_epi64(_mm256_unpacklo_epi64(lo, hi), 0xD8);
+            _mm256_storeu_si256((__m256i*) dst, _mm256_or_si256(rgba, alphaMask));
+
+            src += 8*6;
+            dst += 8;
+            count -= 8;
+        }
+
+        auto proc = kSwapRB ? RGB16_to_BGR1_portable : RGB16_to_RGB1_portable;
+        proc(dst, src, count);
+    }
+
+    static void rgba16_should_swaprb(bool kSwapRB, uint32_t dst[], const uint8_t* src, int count) {
+        const __m256i lowBytes = _mm256_set1_epi16(0x00FF);
+        const __m256i swapRB = _mm256_broadcastsi128_si256(
+                _mm_setr_epi8(2,1,0,3, 6,5,4,7, 10,9,8,11, 14,13,12,15));
+
+        while (count >= 8) {
+            __m256i lo = _mm256_loadu_si256((const __m256i*)(src +  0)),
+                    hi = _mm256_loadu_si256((const __m256i*)(src + 32));
+
+            // packus works within 128-bit lanes, leaving pixels in the order 0 1 4 5 | 2 3 6 7.
+            __m256i rgba = _mm256_packus_epi16(_mm256_and_si256(lo, lowBytes),
+                                               _mm256_and_si256(hi, lowBytes));
+            rgba = _mm256_permute4x64_epi64(rgba, 0xD8);
+            if (kSwapRB) {
+                rgba = _mm256_shuffle_epi8(rgba, swapRB);
+            }
+            _mm256_storeu_si256((__m256i*) dst, rgba);
+
+            src += 8*8;
+            dst += 8;
+            count -= 8;
+        }
+
+        auto proc = kSwapRB ? RGBA16_to_BGRA_portable : RGBA16_to_RGBA_portable;
+        proc(dst, src, count);
+    }
+#else
+    static void rgb16_should_swaprb(bool kSwapRB, uint32_t dst[], const uint8_t* src, int count) {
+        auto proc = kSwapRB ? RGB16_to_BGR1_portable : RGB16_to_RGB1_portable;
+        proc(dst, src, count);
+    }
+    static void rgba16_should_swaprb(bool kSwapRB, uint32_t dst[], const uint8_t* src, int count) {
+        auto proc = kSwapRB ? RGBA16_to_BGRA_portable : RGBA16_to_RGBA_portable;
+        proc(dst, src, count);
+    }
+#endif
+
+/*not static*/ inline void RGB16_to_RGB1(uint32_t dst[], const uint8_t* src, int count) {
+    rgb16_should_swaprb(false, dst, src, count);
+}
+/*not static*/ inline void RGB16_to_BGR1(uint32_t dst[], const uint8_t* src, int count) {
+    rgb16_should_swaprb(true, dst, src, count);
+}
+/*not static*/ inline void RGBA16_to_RGBA(uint32_t dst[], const uint8_t* src, int count) {
+    rgba16_should_swaprb(false, dst, src, count);
+}
+/*not static*/ inline void RGBA16_to_BGRA(uint32_t dst[], const uint8_t* src, int count) {
+    rgba16_should_swaprb(true, dst, src, count);
+}
+
+// Palette expansion.  |ctable| holds finished 8888 pixels, so these never look inside a color.
+static void index_to_8888_portable(uint32_t dst[], const uint8_t* src, int count,
+                                   const uint32_t ctable[]) {
+    for (int i = 0; i < count; i++) {
+        dst[i] = ctable[src[i]];
+    }
+}
+
+// 1, 2 or 4-bit indices are packed most significant bits first, as in PNG and BMP.
+static void small_index_to_8888_portable(uint32_t dst[], const uint8_t* src, int count, int bpp,
+                                         const uint32_t ctable[]) {
+    const int mask = (1 << bpp) - 1;
+    for (int i = 0; i < count; i++) {
+        const int bit = i * bpp;
+        dst[i] = ctable[(src[bit >> 3] >> (8 - bpp - (bit & 7))) & mask];
+    }
+}
+
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSSE3
+    // A table of at most 16 colors fits in four registers, one per byte of the colors, so a
+    // pshufb per byte looks up sixteen indices at once.  The indices are unpacked by copying
+    // the byte that holds each one into its own 16-bit lane, then multiplying by a power of
+    // two so that the index lands in bits [8-kBpp, 8) of the lane.
+    // Byte p of each color, for each of two 128-bit lanes.
+    static void small_index_planes(const uint32_t ctable[], int bpp, uint8_t planes[4][32]) {
+        for (int i = 0; i < 32; i++) {
+            const uint32_t c = (i & 15) < (1 << bpp) ? ctable[i & 15] : 0;
+            for (int p = 0; p < 4; p++) {
+                planes[p][i] = (uint8_t)(c >> (8 * p));
+            }
+        }
+    }
+
+    // Index k of each group of sixteen is in byte (k * bpp) / 8 and needs a left shift of
+    // (k * bpp) % 8, which is the same for index k + 8.  The second 128-bit lane works on the
+    // next group of sixteen, 2 * bpp bytes later.
+    static void small_index_spread(int bpp, uint8_t lo[32], uint8_t hi[32], uint16_t scale[16]) {
+        for (int i = 0; i < 16; i++) {
+            const int k = i % 8,
+                      byteOffset = (i / 8) * 2 * bpp;
+            lo[2*i + 0] = (uint8_t)(byteOffset + (k * bpp) / 8);
+            lo[2*i + 1] = 0x80;
+            hi[2*i + 0] = (uint8_t)(byteOffset + ((k + 8) * bpp) / 8);
+            hi[2*i + 1] = 0x80;
+            scale[i] = (uint16_t)(1 << ((k * bpp) % 8));
+        }
+    }
+#endif
+
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX2
+    template <int kBpp>
+    static void small_index_to_8888_bpp(uint32_t dst[], const uint8_t* src, int count,
+                                        const uint32_t ctable[]) {
+        alignas(32) uint8_t planes[4][32], lo[32], hi[32];
+        alignas(32) uint16_t multipliers[16];
+        small_index_planes(ctable, kBpp, planes);
+        small_index_spread(kBpp, lo, hi, multipliers);
+        const __m256i p0 = _mm256_load_si256((const __m256i*) planes[0]),
+                      p1 = _mm256_load_si256((const __m256i*) planes[1]),
+                      p2 = _mm256_load_si256((const __m256i*) planes[2]),
+                      p3 = _mm256_load_si256((const __m256i*) planes[3]),
+                      spreadLo = _mm256_load_si256((const __m256i*) lo),
+                      spreadHi = _mm256_load_si256((const __m256i*) hi),
+                      scale    = _mm256_load_si256((const __m256i*) multipliers);
+        const __m256i mask = _mm256_set1_epi8((1 << kBpp) - 1);
+
+        // Each 128-bit lane expands sixteen indices, the upper lane from the second half of
+        // the 4 * kBpp bytes we load.
+        while (count >= 32) {
+            __m128i bytes = _mm_setzero_si128();
+            memcpy(&bytes, src, 4 * kBpp);
+            const __m256i packed = _mm256_broadcastsi128_si256(bytes);
+
+            __m256i a = _mm256_mullo_epi16(_mm256_shuffle_epi8(packed, spreadLo), scale),
+                    b = _mm256_mullo_epi16(_mm256_shuffle_epi8(packed, spreadHi), scale);
+            a = _mm256_srli_epi16(a, 8 - kBpp);
+            b = _mm256_srli_epi16(b, 8 - kBpp);
+            const __m256i idx = _mm256_and_si256(_mm256_packus_epi16(a, b), mask);
+
+            const __m256i b0 = _mm256_shuffle_epi8(p0, idx),
+                          b1 = _mm256_shuffle_epi8(p1, idx),
+                          b2 = _mm256_shuffle_epi8(p2, idx),
+                          b3 = _mm256_shuffle_epi8(p3, idx);
+            const __m256i lo01 = _mm256_unpacklo_epi8(b0, b1), hi01 = _mm256_unpackhi_epi8(b0, b1),
+                          lo23 = _mm256_unpacklo_epi8(b2, b3), hi23 = _mm256_unpackhi_epi8(b2, b3);
+
+            // Pixels 0-3 | 16-19, 4-7 | 20-23, 8-11 | 24-27 and 12-15 | 28-31.
+            const __m256i c0 = _mm256_unpacklo_epi16(lo01, lo23),
+                          c1 = _mm256_unpackhi_epi16(lo01, lo23),
+                          c2 = _mm256_unpacklo_epi16(hi01, hi23),
+                          c3 = _mm256_unpackhi_epi16(hi01, hi23);
+            _mm256_storeu_si256((__m256i*)(dst +  0), _mm256_permute2x128_si256(c0, c1, 0x20));
+            _mm256_storeu_si256((__m256i*)(dst +  8), _mm256_permute2x128_si256(c2, c3, 0x20));
+            _mm256_storeu_si256((__m256i*)(dst + 16), _mm256_permute2x128_si256(c0, c1, 0x31));
+            _mm256_storeu_si256((__m256i*)(dst + 24), _mm256_permute2x128_si256(c2, c3, 0x31));
+
+            src += 4 * kBpp;
+            dst += 32;
+            count -= 32;
+        }
+
+        small_index_to_8888_portable(dst, src, count, kBpp, ctable);
+    }
+#elif SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSSE3
+    template <int kBpp>
+    static void small_index_to_8888_bpp(uint32_t dst[], const uint8_t* src, int count,
+                                        const uint32_t ctable[]) {
+        alignas(32) uint8_t planes[4][32], lo[32], hi[32];
+        alignas(32) uint16_t multipliers[16];
+        small_index_planes(ctable, kBpp, planes);
+        small_index_spread(kBpp, lo, hi, multipliers);
+        const __m128i p0 = _mm_load_si128((const __m128i*) planes[0]),
+                      p1 = _mm_load_si128((const __m128i*) planes[1]),
+                      p2 = _mm_load_si128((const __m128i*) planes[2]),
+                      p3 = _mm_load_si128((const __m128i*) planes[3]),
+                      spreadLo = _mm_load_si128((const __m128i*) lo),
+                      spreadHi = _mm_load_si128((const __m128i*) hi),
+                      scale    = _mm_load_si128((const __m128i*) multipliers);
+        const __m128i mask = _mm_set1_epi8((1 << kBpp) - 1);
+
+        while (count >= 16) {
+            __m128i packed = _mm_setzero_si128();
+            memcpy(&packed, src, 2 * kBpp);
+
+            __m128i a = _mm_mullo_epi16(_mm_shuffle_epi8(packed, spreadLo), scale),
+                    b = _mm_mullo_epi16(_mm_shuffle_epi8(packed, spreadHi), scale);
+            a = _mm_srli_epi16(a, 8 - kBpp);
+            b = _mm_srli_epi16(b, 8 - kBpp);
+            const __m128i idx = _mm_and_si128(_mm_packus_epi16(a, b), mask);
+
+            const __m128i b0 = _mm_shuffle_epi8(p0, idx),
+                          b1 = _mm_shuffle_epi8(p1, idx),
+                          b2 = _mm_shuffle_epi8(p2, idx),
+                          b3 = _mm_shuffle_epi8(p3, idx);
+            const __m128i lo01 = _mm_unpacklo_epi8(b0, b1), hi01 = _mm_unpackhi_epi8(b0, b1),
+                          lo23 = _mm_unpacklo_epi8(b2, b3), hi23 = _mm_unpackhi_epi8(b2, b3);
+            _mm_storeu_si128((__m128i*)(dst +  0), _mm_unpacklo_epi16(lo01, lo23));
+            _mm_storeu_si128((__m128i*)(dst +  4), _mm_unpackhi_epi16(lo01, lo23));
+            _mm_storeu_si128((__m128i*)(dst +  8), _mm_unpacklo_epi16(hi01, hi23));
+            _mm_storeu_si128((__m128i*)(dst + 12), _mm_unpackhi_epi16(hi01, hi23));
+
+            src += 2 * kBpp;
+            dst += 16;
+            count -= 16;
+        }
+
+        small_index_to_8888_portable(dst, src, count, kBpp, ctable);
+    }
+#else
+    template <int kBpp>
+    static void small_index_to_8888_bpp(uint32_t dst[], const uint8_t* src, int count,
+                                        const uint32_t ctable[]) {
+        small_index_to_8888_portable(dst, src, count, kBpp, ctable);
+    }
+#endif
+
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SKX
+    /*not static*/ inline void index_to_8888(uint32_t dst[], const uint8_t* src, int count,
+                                             const uint32_t ctable[]) {
+        while (count >= 16) {
+            __m512i idx = _mm512_cvtepu8_epi32(_mm_loadu_si128((const __m128i*) src));
+            _mm512_storeu_si512((__m512i*) dst, _mm512_i32gather_epi32(idx, ctable, 4));
+            src += 16;
+            dst += 16;
+            count -= 16;
+        }
+        index_to_8888_portable(dst, src, count, ctable);
+    }
+#elif SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX2
+    /*not static*/ inline void index_to_8888(uint32_t dst[], const uint8_t* src, int count,
+                                             const uint32_t ctable[]) {
+        while (count >= 8) {
+            __m256i idx = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*) src));
+            _mm256_storeu_si256((__m256i*) dst,
+                                _mm256_i32gather_epi32((const int*) ctable, idx, 4));
+            src += 8;
+            dst += 8;
+            count -= 8;
+        }
+        index_to_8888_portable(dst, src, count, ctable);
+    }
+#else
+    /*not static*/ inline void index_to_8888(uint32_t dst[], const uint8_t* src, int count,
+                                             const uint32_t ctable[]) {
+        index_to_8888_portable(dst, src, count, ctable);
+    }
+#endif
+
+/*not static*/ inline void small_index_to_8888(uint32_t dst[], const uint8_t* src, int count,
+                                               int bpp, const uint32_t ctable[]) {
+    switch (bpp) {
+        case 1: small_index_to_8888_bpp<1>(dst, src, count, ctable); break;
+        case 2: small_index_to_8888_bpp<2>(dst, src, count, ctable); break;
+        case 4: small_index_to_8888_bpp<4>(dst, src, count, ctable); break;
+        default: SkASSERT(false); break;
+    }
+}
+
 }  // namespace SK_OPTS_NS
 
 #endif // SkSwizzler_opts_DEFINED
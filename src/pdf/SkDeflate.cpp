@@ -8,7 +8,9 @@
 #include "src/pdf/SkDeflate.h"
 
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/private/base/SkMalloc.h"
+#include "include/private/base/SkSemaphore.h"
 #include "include/private/base/SkTFitsIn.h"
 #include "include/private/base/SkTo.h"
 #include "src/core/SkTraceEvent.h"
@@ -16,6 +18,9 @@
 #include "zlib.h"
 
 #include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
 
 namespace {
 
@@ -140,3 +145,123 @@ bool SkDeflateWStream::write(const void* void_buffer, size_t len) {
 size_t SkDeflateWStream::bytesWritten() const {
     return fImpl->fZStream.total_in + fImpl->fInBufferIndex;
 }
+
+void SkDeflateParallel(const void* data, size_t len, int compressionLevel,
+                       SkExecutor* executor, SkWStream* out) {
+    TRACE_EVENT0("skia", TRACE_FUNC);
+    SkASSERT(compressionLevel != 0);
+    SkASSERT(compressionLevel <= 9 && compressionLevel >= -1);
+    static constexpr size_t kChunkSize = 1 << 18;
+    static constexpr size_t kWindow    = 1 << 15;
+    const int chunks = SkToInt((len + kChunkSize - 1) / kChunkSize);
+
+    if (!executor || chunks < 2) {
+        SkDeflateWStream deflateWStream(out, compressionLevel);
+        deflateWStream.write(data, len);
+        return;
+    }
+
+    // We're often called from a job already running on this executor, so we must never block
+    // waiting for work that might be queued behind us.  Instead we post helpers that claim chunks
+    // as they run, claim chunks on this thread too, and only wait on chunks that some thread is
+    // actively compressing.  Helpers that start after every chunk is claimed just return; they
+    // share ownership of the state, but only touch data while they hold an unfinished chunk.
+    struct State {
+        const uint8_t* bytes;
+        size_t len;
+        int compressionLevel;
+        int chunks;
+        std::vector<std::vector<uint8_t>> deflated;
+        std::vector<uLong> adlers;
+        std::atomic<int> next{0};
+        std::atomic<int> finished{0};
+        std::atomic<bool> ok{true};
+        SkSemaphore done;
+
+        void compress(int i) {
+            const uint8_t* chunk = bytes + kChunkSize * i;
+            const size_t chunkLen = std::min(kChunkSize, len - kChunkSize * i);
+            const bool last = i == chunks - 1;
+
+            z_stream z = {};
+            z.zalloc = &skia_alloc_func;
+            z.zfree = &skia_free_func;
+            if (Z_OK != deflateInit2(&z, compressionLevel, Z_DEFLATED, -15 /*raw*/,
+                                     8, Z_DEFAULT_STRATEGY)) {
+                ok = false;
+                return;
+            }
+            if (i > 0) {
+                const size_t dictLen = std::min(kWindow, kChunkSize * i);
+                deflateSetDictionary(&z, chunk - dictLen, SkToUInt(dictLen));
+            }
+
+            std::vector<uint8_t>& dst = deflated[i];
+            dst.resize(deflateBound(&z, chunkLen) + 16);  // Room for the sync flush marker too.
+            z.next_in   = const_cast<uint8_t*>(chunk);
+            z.avail_in  = SkToUInt(chunkLen);
+            z.next_out  = dst.data();
+            z.avail_out = SkToUInt(dst.size());
+            const int result = deflate(&z, last ? Z_FINISH : Z_SYNC_FLUSH);
+            if (result != (last ? Z_STREAM_END : Z_OK) || z.avail_in != 0 || z.avail_out == 0) {
+                ok = false;
+            }
+            dst.resize(dst.size() - z.avail_out);
+            (void)deflateEnd(&z);
+
+            adlers[i] = adler32(adler32(0, nullptr, 0), chunk, SkToUInt(chunkLen));
+        }
+
+        void drain() {
+            for (int i; (i = next.fetch_add(1, std::memory_order_relaxed)) < chunks;) {
+                this->compress(i);
+                if (finished.fetch_add(1, std::memory_order_acq_rel) + 1 == chunks) {
+                    done.signal();
+                }
+            }
+        }
+    };
+    auto state = std::make_shared<State>();
+    state->bytes = static_cast<const uint8_t*>(data);
+    state->len = len;
+    state->compressionLevel = compressionLevel;
+    state->chunks = chunks;
+    state->deflated.resize(chunks);
+    state->adlers.resize(chunks);
+
+    for (int i = 1; i < chunks; i++) {
+        executor->add([state] { state->drain(); });
+    }
+    state->drain();
+    state->done.wait();
+
+    const std::vector<std::vector<uint8_t>>& deflated = state->deflated;
+    const std::vector<uLong>& adlers = state->adlers;
+    const bool ok = state->ok;
+
+    if (!ok) {
+        // Unexpected, but we can always fall back to compressing on this thread.
+        SkDeflateWStream deflateWStream(out, compressionLevel);
+        deflateWStream.write(data, len);
+        return;
+    }
+
+    // The zlib header: a 32K deflate window, then a compression level hint and check bits.
+    const int level = compressionLevel == -1 ? 6 : compressionLevel;
+    const uint8_t cmf = 0x78;
+    uint8_t flg = (level < 2 ? 0 : level < 6 ? 1 : level == 6 ? 2 : 3) << 6;
+    flg += (31 - (cmf * 256 + flg) % 31) % 31;
+    const uint8_t header[] = {cmf, flg};
+    out->write(header, sizeof(header));
+
+    uLong adler = adlers[0];
+    for (int i = 0; i < chunks; i++) {
+        out->write(deflated[i].data(), deflated[i].size());
+        if (i > 0) {
+            adler = adler32_combine(adler, adlers[i], std::min(kChunkSize, len - kChunkSize * i));
+        }
+    }
+    const uint8_t trailer[] = {(uint8_t)(adler >> 24), (uint8_t)(adler >> 16),
+                               (uint8_t)(adler >>  8), (uint8_t)(adler >>  0)};
+    out->write(trailer, sizeof(trailer));
+}
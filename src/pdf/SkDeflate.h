@@ -11,6 +11,8 @@
 
 #include "include/core/SkStream.h"
 
+class SkExecutor;
+
 /**
   * Wrap a stream in this class to compress the information written to
   * this stream using the Deflate algorithm.
@@ -50,4 +52,17 @@ private:
     std::unique_ptr<Impl> fImpl;
 };
 
+/**
+  * Compress len bytes of data into a zlib stream, as SkDeflateWStream would, but split the
+  * input into chunks that are deflated in parallel on the executor.  Each chunk is primed with
+  * the 32K of input before it, and all but the last end in a sync flush, so they concatenate
+  * into a single zlib stream with a combined Adler-32.  The calling thread compresses chunks
+  * too and never waits on queued work, so this is safe to call from a job on the same executor.
+  */
+void SkDeflateParallel(const void* data, size_t len, int compressionLevel,
+                       SkExecutor*, SkWStream* out);
+
+/** Inputs at least this large are worth compressing with SkDeflateParallel(). */
+static constexpr size_t kSkDeflateParallelMinSize = 1 << 20;
+
 #endif  // SkFlate_DEFINED
@@ -174,7 +174,13 @@ static void do_deflated_image(const SkPixmap& pm,
     SkDynamicMemoryWStream buffer;
     SkWStream* stream = &buffer;
     std::optional<SkDeflateWStream> deflateWStream;
-    if (format == SkPDFStreamFormat::Flate) {
+    // Large images are gathered uncompressed and then deflated in parallel chunks.
+    SkDynamicMemoryWStream uncompressed;
+    const bool deflateInParallel = format == SkPDFStreamFormat::Flate && doc->executor() &&
+                                   pm.computeByteSize() >= kSkDeflateParallelMinSize;
+    if (deflateInParallel) {
+        stream = &uncompressed;
+    } else if (format == SkPDFStreamFormat::Flate) {
         deflateWStream.emplace(&buffer, SkToInt(compressionLevel));
         stream = &*deflateWStream;
     }
@@ -218,6 +224,11 @@ static void do_deflated_image(const SkPixmap& pm,
     if (deflateWStream) {
         deflateWStream->finalize();
     }
+    if (deflateInParallel) {
+        sk_sp<SkData> pixels = uncompressed.detachAsData();
+        SkDeflateParallel(pixels->data(), pixels->size(), SkToInt(compressionLevel),
+                          doc->executor(), &buffer);
+    }
     #ifdef SK_PDF_BASE85_BINARY
     SkPDFUtils::Base85Encode(buffer.detachAsStream(), &buffer);
     #endif
@@ -8,6 +8,7 @@
 #include "include/docs/SkPDFDocument.h"
 #include "src/pdf/SkPDFDocumentPriv.h"
 
+#include "include/core/SkExecutor.h"
 #include "include/core/SkStream.h"
 #include "include/docs/SkPDFDocument.h"
 #include "include/private/base/SkTo.h"
@@ -598,8 +599,34 @@ void SkPDFDocument::onClose(SkWStream* stream) {
 
     auto docCatalogRef = this->emit(*docCatalog);
 
-    for (const SkPDFFont* f : get_fonts(*this)) {
-        f->emitSubset(this);
+    std::vector<const SkPDFFont*> fonts = get_fonts(*this);
+    if (fExecutor) {
+        // Subsetting and compressing TrueType/CID fonts is the bulk of the work here.  Type1 and
+        // Type3 fonts write to the document's maps, so emit them first, fill in the only cache
+        // the others write to, and then the multi-byte fonts can be emitted on the executor.
+        for (const SkPDFFont* f : fonts) {
+            if (!f->multiByteGlyphs()) {
+                f->emitSubset(this);
+            }
+        }
+        for (const SkPDFFont* f : fonts) {
+            if (f->multiByteGlyphs()) {
+                SkPDFFont::GetUnicodeMap(f->typeface(), this);
+            }
+        }
+        for (const SkPDFFont* f : fonts) {
+            if (f->multiByteGlyphs()) {
+                this->incrementJobCount();
+                fExecutor->add([this, f]() {
+                    f->emitSubset(this);
+                    this->signalJobComplete();
+                });
+            }
+        }
+    } else {
+        for (const SkPDFFont* f : fonts) {
+            f->emitSubset(this);
+        }
     }
 
     this->waitForJobs();
@@ -548,9 +548,23 @@ static void serialize_stream(SkPDFDict* origDict,
         stream->getLength() > kMinimumSavings)
     {
         SkDynamicMemoryWStream compressedData;
-        SkDeflateWStream deflateWStream(&compressedData,SkToInt(doc->metadata().fCompressionLevel));
-        SkStreamCopy(&deflateWStream, stream);
-        deflateWStream.finalize();
+        const int compressionLevel = SkToInt(doc->metadata().fCompressionLevel);
+        if (doc->executor() && stream->getLength() >= kSkDeflateParallelMinSize) {
+            // Big streams (usually images) are split up so the rest of the pool can help.
+            sk_sp<SkData> data;
+            if (const void* base = stream->getMemoryBase()) {
+                data = SkData::MakeWithoutCopy(base, stream->getLength());
+            } else {
+                data = SkCopyStreamToData(stream);
+                SkAssertResult(stream->rewind());
+            }
+            SkDeflateParallel(data->data(), data->size(), compressionLevel,
+                              doc->executor(), &compressedData);
+        } else {
+            SkDeflateWStream deflateWStream(&compressedData, compressionLevel);
+            SkStreamCopy(&deflateWStream, stream);
+            deflateWStream.finalize();
+        }
         #ifdef SK_PDF_BASE85_BINARY
         {
             SkPDFUtils::Base85Encode(compressedData.detachAsStream(), &compressedData);
@@ -319,9 +319,9 @@ void SkGradientShaderBase::AppendGradientFillStages(SkRasterPipeline* p,
         // Note: In order to handle clamps in search, the search assumes a stop conceptully placed
         // at -inf. Therefore, the max number of stops is fColorCount+1.
         for (int i = 0; i < 4; i++) {
-            // Allocate at least at for the AVX2 gather from a YMM register.
-            ctx->fs[i] = alloc->makeArray<float>(std::max(count + 1, 8));
-            ctx->bs[i] = alloc->makeArray<float>(std::max(count + 1, 8));
+            // Allocate at least enough for the AVX-512 permute from a ZMM register.
+            ctx->fs[i] = alloc->makeArray<float>(std::max(count + 1, 16));
+            ctx->bs[i] = alloc->makeArray<float>(std::max(count + 1, 16));
         }
 
         if (positions == nullptr) {
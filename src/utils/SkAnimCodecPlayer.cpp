@@ -13,6 +13,7 @@
 #include "include/core/SkBlendMode.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkMatrix.h"
@@ -21,7 +22,11 @@
 #include "include/core/SkSamplingOptions.h"
 #include "include/core/SkSize.h"
 #include "include/core/SkTypes.h"
+#include "include/private/base/SkMutex.h"
+#include "include/private/base/SkSemaphore.h"
+#include "include/private/base/SkTo.h"
 #include "src/codec/SkCodecImageGenerator.h"
+#include "src/core/SkTaskGroup.h"
 
 #include <algorithm>
 #include <cstddef>
@@ -51,7 +56,40 @@ SkAnimCodecPlayer::SkAnimCodecPlayer(std::unique_ptr<SkCodec> codec) : fCodec(st
     }
 }
 
-SkAnimCodecPlayer::~SkAnimCodecPlayer() {}
+struct SkAnimCodecPlayer::LookAhead {
+    LookAhead(SkExecutor* executor, int framesAhead, size_t frameCount)
+        : fTasks(*executor)
+        , fFramesAhead(framesAhead)
+        , fFailed(frameCount, false) {}
+
+    SkTaskGroup fTasks;
+    const int   fFramesAhead;
+    SkSemaphore fFrameDecoded;
+
+    // Guards fImages and writes to fCurrIndex, as well as the following.
+    SkMutex           fMutex;
+    std::vector<bool> fFailed;
+    bool              fDecoding = false;
+    int               fWaitingFor = -1;
+};
+
+SkAnimCodecPlayer::SkAnimCodecPlayer(std::unique_ptr<SkCodec> codec, SkExecutor* executor,
+                                     int framesAhead)
+        : SkAnimCodecPlayer(std::move(codec)) {
+    if (executor && fTotalDuration > 0) {
+        const int frameCount = SkToInt(fFrameInfos.size());
+        framesAhead = std::min(std::max(framesAhead, 0), frameCount - 1);
+        fLookAhead = std::make_unique<LookAhead>(executor, framesAhead, fFrameInfos.size());
+        this->startLookAhead();
+    }
+}
+
+SkAnimCodecPlayer::~SkAnimCodecPlayer() {
+    if (fLookAhead) {
+        // The decoding task uses fCodec and fImages.
+        fLookAhead->fTasks.wait();
+    }
+}
 
 SkISize SkAnimCodecPlayer::dimensions() const {
     if (!fCodec) {
@@ -67,10 +105,33 @@ SkISize SkAnimCodecPlayer::dimensions() const {
 sk_sp<SkImage> SkAnimCodecPlayer::getFrameAt(int index) {
     SkASSERT((unsigned)index < fFrameInfos.size());
 
+    if (fLookAhead) {
+        {
+            SkAutoMutexExclusive lock(fLookAhead->fMutex);
+            if (fImages[index] || fLookAhead->fFailed[index]) {
+                return fImages[index];
+            }
+            // The current frame is always the first one the decoding task looks for.
+            SkASSERT(index == fCurrIndex);
+            fLookAhead->fWaitingFor = index;
+        }
+        this->startLookAhead();
+        fLookAhead->fFrameDecoded.wait();
+
+        SkAutoMutexExclusive lock(fLookAhead->fMutex);
+        return fImages[index];
+    }
+
     if (fImages[index]) {
         return fImages[index];
     }
 
+    const int requiredFrame = fFrameInfos[index].fRequiredFrame;
+    return fImages[index] = this->decodeFrame(
+            index, requiredFrame != SkCodec::kNoFrame ? fImages[requiredFrame] : nullptr);
+}
+
+sk_sp<SkImage> SkAnimCodecPlayer::decodeFrame(int index, sk_sp<SkImage> requiredImage) {
     size_t rb = fImageInfo.minRowBytes();
     size_t size = fImageInfo.computeByteSize(rb);
     auto data = SkData::MakeUninitialized(size);
@@ -90,9 +151,7 @@ sk_sp<SkImage> SkAnimCodecPlayer::getFrameAt(int index) {
     if (fFrameInfos[index].fAlphaType != kOpaque_SkAlphaType && imageInfo.isOpaque()) {
         imageInfo = imageInfo.makeAlphaType(kPremul_SkAlphaType);
     }
-    const int requiredFrame = fFrameInfos[index].fRequiredFrame;
-    if (requiredFrame != SkCodec::kNoFrame && fImages[requiredFrame]) {
-        auto requiredImage = fImages[requiredFrame];
+    if (requiredImage) {
         auto canvas = SkCanvas::MakeRasterDirect(imageInfo, data->writable_data(), rb);
         if (origin != kDefault_SkEncodedOrigin) {
             // The required frame is stored after applying the origin. Undo that,
@@ -107,7 +166,7 @@ sk_sp<SkImage> SkAnimCodecPlayer::getFrameAt(int index) {
             canvas->concat(inverse);
         }
         canvas->drawImage(requiredImage, 0, 0, SkSamplingOptions(), &paint);
-        opts.fPriorFrame = requiredFrame;
+        opts.fPriorFrame = fFrameInfos[index].fRequiredFrame;
     }
 
     if (SkCodec::kSuccess != fCodec->getPixels(imageInfo, data->writable_data(), rb, &opts)) {
@@ -125,7 +184,74 @@ sk_sp<SkImage> SkAnimCodecPlayer::getFrameAt(int index) {
         canvas->drawImage(image, 0, 0, SkSamplingOptions(), &paint);
         image = SkImage::MakeRasterData(imageInfo, std::move(data), rb);
     }
-    return fImages[index] = image;
+    return image;
+}
+
+int SkAnimCodecPlayer::nextFrameToDecode() const {
+    const int frameCount = SkToInt(fFrameInfos.size());
+    for (int i = 0; i <= fLookAhead->fFramesAhead; ++i) {
+        const int index = (fCurrIndex + i) % frameCount;
+        if (!fImages[index] && !fLookAhead->fFailed[index]) {
+            return index;
+        }
+    }
+    return -1;
+}
+
+void SkAnimCodecPlayer::trimFrames() {
+    // Keep the frames ahead of us, and the one before the current frame, which is usually the
+    // prior frame the current one is drawn on top of.
+    const int frameCount = SkToInt(fFrameInfos.size());
+    for (int index = 0; index < frameCount; ++index) {
+        const int ahead = (index - fCurrIndex + frameCount) % frameCount;
+        if (ahead > fLookAhead->fFramesAhead && ahead != frameCount - 1) {
+            fImages[index] = nullptr;
+        }
+    }
+}
+
+void SkAnimCodecPlayer::startLookAhead() {
+    {
+        SkAutoMutexExclusive lock(fLookAhead->fMutex);
+        if (fLookAhead->fDecoding || this->nextFrameToDecode() < 0) {
+            return;
+        }
+        fLookAhead->fDecoding = true;
+    }
+    // Outside the lock, in case the executor runs the task right away on this thread.
+    fLookAhead->fTasks.add([this] { this->runLookAhead(); });
+}
+
+void SkAnimCodecPlayer::runLookAhead() {
+    // The codec is not thread-safe, so only one of these runs at a time, decoding frames in
+    // playback order until the window ahead of the current frame is full.
+    for (;;) {
+        int index;
+        sk_sp<SkImage> requiredImage;
+        {
+            SkAutoMutexExclusive lock(fLookAhead->fMutex);
+            index = this->nextFrameToDecode();
+            if (index < 0) {
+                fLookAhead->fDecoding = false;
+                return;
+            }
+            const int requiredFrame = fFrameInfos[index].fRequiredFrame;
+            if (requiredFrame != SkCodec::kNoFrame) {
+                requiredImage = fImages[requiredFrame];
+            }
+        }
+
+        sk_sp<SkImage> image = this->decodeFrame(index, std::move(requiredImage));
+
+        SkAutoMutexExclusive lock(fLookAhead->fMutex);
+        fLookAhead->fFailed[index] = !image;
+        fImages[index] = std::move(image);
+        this->trimFrames();
+        if (fLookAhead->fWaitingFor == index) {
+            fLookAhead->fWaitingFor = -1;
+            fLookAhead->fFrameDecoded.signal();
+        }
+    }
 }
 
 sk_sp<SkImage> SkAnimCodecPlayer::getFrame() {
@@ -148,7 +274,18 @@ bool SkAnimCodecPlayer::seek(uint32_t msec) {
                                       return (uint32_t)info.fDuration <= msec;
                                   });
     int prevIndex = fCurrIndex;
-    fCurrIndex = lower - fFrameInfos.begin();
+    int index = lower - fFrameInfos.begin();
+    if (!fLookAhead) {
+        fCurrIndex = index;
+        return fCurrIndex != prevIndex;
+    }
+
+    {
+        SkAutoMutexExclusive lock(fLookAhead->fMutex);
+        fCurrIndex = index;
+        this->trimFrames();
+    }
+    this->startLookAhead();
     return fCurrIndex != prevIndex;
 }
 
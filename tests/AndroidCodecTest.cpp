@@ -7,10 +7,13 @@
 
 #include "include/codec/SkAndroidCodec.h"
 #include "include/codec/SkCodec.h"
+#include "include/core/SkBitmap.h"
 #include "include/core/SkColorSpace.h"
 #include "include/core/SkData.h"
 #include "include/core/SkEncodedImageFormat.h"
 #include "include/core/SkImageInfo.h"
+#include "include/core/SkPixmap.h"
+#include "include/core/SkRect.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkSize.h"
 #include "include/core/SkString.h"
@@ -20,11 +23,15 @@
 #include "tests/Test.h"
 #include "tools/Resources.h"
 
+#include <algorithm>
+#include <cmath>
 #include <cstdint>
+#include <cstdlib>
 #include <cstring>
 #include <initializer_list>
 #include <memory>
 #include <utility>
+#include <vector>
 
 static SkISize times(const SkISize& size, float factor) {
     return { (int) (size.width() * factor), (int) (size.height() * factor) };
@@ -132,6 +139,126 @@ DEF_TEST(AndroidCodec_computeSampleSize, r) {
     }
 }
 
+// Averages the premultiplied 8888 pixels of |src| covered by each pixel of an |dstSize| grid.
+static std::vector<uint8_t> box_filter(const SkPixmap& src, const SkIRect& rect, SkISize dstSize) {
+    std::vector<uint8_t> dst(dstSize.area() * 4);
+    const double sx = (double) rect.width()  / dstSize.width(),
+                 sy = (double) rect.height() / dstSize.height();
+    for (int y = 0; y < dstSize.height(); y++) {
+        for (int x = 0; x < dstSize.width(); x++) {
+            const double x0 = x * sx, x1 = (x + 1) * sx,
+                         y0 = y * sy, y1 = (y + 1) * sy;
+            double sum[4] = {0, 0, 0, 0}, total = 0;
+            for (int j = (int) y0; j < std::min(rect.height(), (int) std::ceil(y1)); j++) {
+                for (int i = (int) x0; i < std::min(rect.width(), (int) std::ceil(x1)); i++) {
+                    const double w = (std::min(y1, j + 1.0) - std::max(y0, (double) j)) *
+                                     (std::min(x1, i + 1.0) - std::max(x0, (double) i));
+                    const uint8_t* p = src.addr8(rect.x() + i, rect.y() + j);
+                    for (int c = 0; c < 4; c++) {
+                        sum[c] += w * p[c];
+                    }
+                    total += w;
+                }
+            }
+            for (int c = 0; c < 4; c++) {
+                dst[(y * dstSize.width() + x) * 4 + c] = (uint8_t) std::lround(sum[c] / total);
+            }
+        }
+    }
+    return dst;
+}
+
+DEF_TEST(AndroidCodec_resample, r) {
+    if (GetResourcePath().isEmpty()) {
+        return;
+    }
+    using ResampleFilter = SkAndroidCodec::ResampleFilter;
+
+    for (const char* file : { "images/mandrill_256.png",
+                              "images/plane_interlaced.png",  // Interlaced scanlines.
+                              "images/color_wheel.png",       // Alpha.
+                              "images/rle.bmp",               // Bottom up, decoded whole.
+                              "images/mandrill_512_q075.jpg", // Scaled natively first.
+                              }) {
+        auto codec = SkAndroidCodec::MakeFromData(GetResourceAsData(file));
+        if (!codec) {
+            ERRORF(r, "Could not create codec for %s", file);
+            continue;
+        }
+        const bool nativeScaling = codec->getEncodedFormat() == SkEncodedImageFormat::kJPEG;
+        const bool supportsSubsets = codec->getEncodedFormat() != SkEncodedImageFormat::kBMP;
+
+        const SkImageInfo fullInfo = codec->getInfo().makeColorType(kN32_SkColorType)
+                                                     .makeAlphaType(kPremul_SkAlphaType)
+                                                     .makeColorSpace(nullptr);
+        SkBitmap full;
+        full.allocPixels(fullInfo);
+        if (SkCodec::kSuccess != codec->getAndroidPixels(fullInfo, full.getPixels(),
+                                                         full.rowBytes())) {
+            ERRORF(r, "Could not decode %s", file);
+            continue;
+        }
+
+        const SkIRect bounds = SkIRect::MakeSize(fullInfo.dimensions());
+        for (const SkIRect& rect : { bounds, bounds.makeInset(13, 7) }) {
+            if (rect != bounds && !supportsSubsets) {
+                continue;
+            }
+            for (SkISize size : { SkISize{rect.width() * 3 / 7, rect.height() * 2 / 5},
+                                  SkISize{rect.width() - 1,     rect.height() / 3},
+                                  SkISize{1, 1} }) {
+                for (ResampleFilter filter : { ResampleFilter::kBox, ResampleFilter::kMitchell }) {
+                    SkIRect subset = rect;
+                    SkAndroidCodec::AndroidOptions options;
+                    options.fResampleFilter = filter;
+                    options.fSubset = rect != bounds ? &subset : nullptr;
+
+                    SkBitmap bm;
+                    bm.allocPixels(fullInfo.makeDimensions(size));
+                    const SkCodec::Result result = codec->getAndroidPixels(
+                            bm.info(), bm.getPixels(), bm.rowBytes(), &options);
+                    if (SkCodec::kSuccess != result) {
+                        ERRORF(r, "%s %dx%d filter %d failed: %s", file, size.width(),
+                               size.height(), (int) filter, SkCodec::ResultToString(result));
+                        continue;
+                    }
+                    if (filter != ResampleFilter::kBox) {
+                        continue;
+                    }
+
+                    // libjpeg's scaled IDCT is not an exact box filter, so only look at how far
+                    // off it is on average.
+                    const std::vector<uint8_t> expected = box_filter(full.pixmap(), rect, size);
+                    const uint8_t* actual = (const uint8_t*) bm.getPixels();
+                    int maxDiff = 0;
+                    double totalDiff = 0;
+                    for (size_t i = 0; i < expected.size(); i++) {
+                        const int diff = std::abs(actual[i] - expected[i]);
+                        maxDiff = std::max(maxDiff, diff);
+                        totalDiff += diff;
+                    }
+                    if (nativeScaling) {
+                        REPORTER_ASSERT(r, totalDiff / expected.size() < 4, "%s %dx%d", file,
+                                        size.width(), size.height());
+                    } else {
+                        REPORTER_ASSERT(r, maxDiff <= 1, "%s %dx%d max diff %d", file,
+                                        size.width(), size.height(), maxDiff);
+                    }
+                }
+            }
+        }
+
+        // Resampling only shrinks.
+        SkAndroidCodec::AndroidOptions options;
+        options.fResampleFilter = ResampleFilter::kMitchell;
+        SkBitmap bm;
+        bm.allocPixels(fullInfo.makeWH(fullInfo.width() + 1, fullInfo.height()));
+        REPORTER_ASSERT(r, SkCodec::kInvalidScale ==
+                           codec->getAndroidPixels(bm.info(), bm.getPixels(), bm.rowBytes(),
+                                                   &options));
+    }
+}
+
 DEF_TEST(AndroidCodec_wide, r) {
     if (GetResourcePath().isEmpty()) {
         return;
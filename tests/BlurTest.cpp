@@ -12,6 +12,7 @@
 #include "include/core/SkColor.h"
 #include "include/core/SkColorPriv.h"
 #include "include/core/SkColorType.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkMaskFilter.h"
 #include "include/core/SkPaint.h"
@@ -32,9 +33,11 @@
 #include "include/private/base/SkFloatBits.h"
 #include "include/private/base/SkTPin.h"
 #include "src/base/SkMathPriv.h"
+#include "src/base/SkRandom.h"
 #include "src/core/SkBlurMask.h"
 #include "src/core/SkGpuBlurUtils.h"
 #include "src/core/SkMask.h"
+#include "src/core/SkMaskBlurFilter.h"
 #include "src/core/SkMaskFilterBase.h"
 #include "src/effects/SkEmbossMaskFilter.h"
 #include "tests/CtsEnforcement.h"
@@ -587,3 +590,48 @@ DEF_TEST(zero_blur, reporter) {
     SkIPoint offset;
     bitmap.extractAlpha(&alpha, &paint, nullptr, &offset);
 }
+
+// Splitting a large blur into bands on an executor must not change a single pixel.
+DEF_TEST(BlurMaskFilter_Executor, reporter) {
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+
+    for (SkMask::Format format : {SkMask::kA8_Format, SkMask::kBW_Format}) {
+        SkMask src;
+        src.fBounds = SkIRect::MakeWH(517, 389);
+        src.fFormat = format;
+        src.fRowBytes = format == SkMask::kBW_Format ? (517 + 7) / 8 : 517;
+        src.fImage = SkMask::AllocImage(src.computeImageSize());
+        SkAutoMaskFreeImage srcStorage(src.fImage);
+        SkRandom rand;
+        for (size_t i = 0; i < src.computeImageSize(); i++) {
+            src.fImage[i] = rand.nextU() & 0xFF;
+        }
+
+        for (double sigma : {3.0, 20.0}) {
+            SkMaskBlurFilter filter(sigma, sigma);
+            SkMask serial, parallel;
+            SkIPoint serialBorder   = filter.blur(src, &serial),
+                     parallelBorder = filter.blur(src, &parallel, executor.get());
+            SkAutoMaskFreeImage serialStorage(serial.fImage),
+                                parallelStorage(parallel.fImage);
+
+            REPORTER_ASSERT(reporter, serialBorder == parallelBorder);
+            REPORTER_ASSERT(reporter, serial.fBounds == parallel.fBounds);
+            REPORTER_ASSERT(reporter, serial.computeImageSize() == parallel.computeImageSize());
+            REPORTER_ASSERT(reporter, 0 == memcmp(serial.fImage, parallel.fImage,
+                                                  serial.computeImageSize()));
+
+            // Blurring on the only thread of an executor that can't lend it back to queued work
+            // must not wait for the bands it queues there.
+            SkMask onThread;
+            {
+                std::unique_ptr<SkExecutor> lonely =
+                        SkExecutor::MakeFIFOThreadPool(1, /*allowBorrowing=*/false);
+                lonely->add([&, pool = lonely.get()] { filter.blur(src, &onThread, pool); });
+            }  // Runs the blur, then joins the thread.
+            SkAutoMaskFreeImage onThreadStorage(onThread.fImage);
+            REPORTER_ASSERT(reporter, 0 == memcmp(serial.fImage, onThread.fImage,
+                                                  serial.computeImageSize()));
+        }
+    }
+}
@@ -13,6 +13,7 @@
 #include "include/core/SkBitmap.h"
 #include "include/core/SkColorType.h"
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkMatrix.h"
@@ -626,3 +627,38 @@ DEF_TEST(AnimCodecPlayer, r) {
                         "Mismatched size for frame at 500 ms of %s", test.fFile);
     }
 }
+
+DEF_TEST(AnimCodecPlayer_LookAhead, r) {
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(2);
+    for (const char* file : { "images/alphabetAnim.gif",
+                              "images/required.gif",
+                              "images/required.webp",
+                              "images/stoplight.webp" }) {
+        auto data = GetResourceAsData(file);
+        if (!data) {
+            continue;
+        }
+        for (int framesAhead : {0, 1, 3, 100}) {
+            SkAnimCodecPlayer expected(SkCodec::MakeFromData(data));
+            SkAnimCodecPlayer player(SkCodec::MakeFromData(data), executor.get(), framesAhead);
+            REPORTER_ASSERT(r, player.duration() == expected.duration());
+
+            // Play through twice, so frames that were dropped behind us get decoded again, then
+            // jump around.
+            std::vector<uint32_t> times;
+            for (uint32_t msec = 0; msec < 2 * player.duration(); msec += 37) {
+                times.push_back(msec);
+            }
+            for (uint32_t msec : {900u, 100u, 1250u, 0u}) {
+                times.push_back(msec);
+            }
+            for (uint32_t msec : times) {
+                REPORTER_ASSERT(r, player.seek(msec) == expected.seek(msec));
+                sk_sp<SkImage> frame = player.getFrame();
+                REPORTER_ASSERT(r, frame && frame == player.getFrame());
+                REPORTER_ASSERT(r, ToolUtils::equal_pixels(frame.get(), expected.getFrame().get()),
+                                "%s, %d frames ahead, at %u ms", file, framesAhead, msec);
+            }
+        }
+    }
+}
@@ -15,6 +15,7 @@
 #include "include/core/SkColorType.h"
 #include "include/core/SkData.h"
 #include "include/core/SkEncodedImageFormat.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkImageEncoder.h"
 #include "include/core/SkImageGenerator.h"
@@ -55,8 +56,10 @@
 #include <setjmp.h>
 
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <cstring>
+#include <functional>
 #include <initializer_list>
 #include <memory>
 #include <utility>
@@ -1068,6 +1071,201 @@ DEF_TEST(Codec_jpeg_rewind, r) {
     REPORTER_ASSERT(r, SkCodec::kIncompleteInput == result);
 }
 
+// Forwards work to another executor, counting how much was added.
+class CountingExecutor final : public SkExecutor {
+public:
+    explicit CountingExecutor(SkExecutor* executor) : fExecutor(executor) {}
+
+    void add(std::function<void(void)> work) override {
+        fAdded++;
+        fExecutor->add(std::move(work));
+    }
+    void borrow() override { fExecutor->borrow(); }
+
+    int added() const { return fAdded.load(); }
+
+private:
+    SkExecutor* fExecutor;
+    std::atomic<int> fAdded{0};
+};
+
+DEF_TEST(Codec_jpeg_parallel_decode, r) {
+    // This image has a restart marker at the start of every MCU row, so it can be split into bands.
+    const char* path = "images/iphone_13_pro.jpeg";
+    sk_sp<SkData> data(GetResourceAsData(path));
+    if (!data) {
+        return;
+    }
+
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    // A truncated image cannot be split, so it should fall back to a serial decode.
+    for (sk_sp<SkData> encoded : {data, SkData::MakeSubset(data.get(), 0, data->size() / 2)}) {
+        const bool complete = encoded == data;
+        for (sk_sp<SkColorSpace> cs : {sk_sp<SkColorSpace>(nullptr), SkColorSpace::MakeSRGB()}) {
+            std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(encoded);
+            if (!codec) {
+                ERRORF(r, "Unable to create codec '%s'.", path);
+                return;
+            }
+            SkImageInfo info = codec->getInfo().makeColorType(kN32_SkColorType);
+            if (cs) {
+                info = info.makeColorSpace(cs);
+            }
+
+            SkBitmap serial, parallel;
+            serial.allocPixels(info);
+            parallel.allocPixels(info);
+            serial.eraseColor(SK_ColorTRANSPARENT);
+            parallel.eraseColor(SK_ColorTRANSPARENT);
+
+            SkCodec::Options options;
+            options.fZeroInitialized = SkCodec::kYes_ZeroInitialized;
+            SkCodec::Result result = codec->getPixels(serial.pixmap(), &options);
+            REPORTER_ASSERT(r, result == (complete ? SkCodec::kSuccess
+                                                   : SkCodec::kIncompleteInput));
+
+            CountingExecutor counting(executor.get());
+            options.fExecutor = &counting;
+            REPORTER_ASSERT(r, result == codec->getPixels(parallel.pixmap(), &options));
+            REPORTER_ASSERT(r, md5(serial) == md5(parallel));
+            // Only the complete image should have been split into bands.
+            REPORTER_ASSERT(r, (counting.added() > 0) == complete, "%d", counting.added());
+        }
+    }
+}
+
+DEF_TEST(Codec_jpeg_parallel_decode_on_executor_thread, r) {
+    const char* path = "images/iphone_13_pro.jpeg";
+    sk_sp<SkData> data(GetResourceAsData(path));
+    if (!data) {
+        return;
+    }
+
+    // Decode from the only thread of an executor that can't lend it back to queued work.  If the
+    // decode waited on its bands there, nothing would ever run them.
+    SkBitmap serial, parallel;
+    bool decoded = false;
+    {
+        std::unique_ptr<SkExecutor> executor =
+                SkExecutor::MakeFIFOThreadPool(1, /*allowBorrowing=*/false);
+        executor->add([&, pool = executor.get()] {
+            std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(data);
+            if (!codec) {
+                return;
+            }
+            SkImageInfo info = codec->getInfo().makeColorType(kN32_SkColorType);
+            serial.allocPixels(info);
+            parallel.allocPixels(info);
+
+            SkCodec::Options options;
+            decoded = SkCodec::kSuccess == codec->getPixels(serial.pixmap(), &options);
+            options.fExecutor = pool;
+            decoded &= SkCodec::kSuccess == codec->getPixels(parallel.pixmap(), &options);
+        });
+    }  // Runs the queued decode, then joins the thread.
+    REPORTER_ASSERT(r, decoded);
+    REPORTER_ASSERT(r, decoded && md5(serial) == md5(parallel));
+}
+
+DEF_TEST(Codec_jpeg_region_seek, r) {
+    // This image has a restart marker at the start of every MCU row, so a subset decode can start
+    // near its top row instead of decoding everything above it.
+    const char* path = "images/iphone_13_pro.jpeg";
+    sk_sp<SkData> data(GetResourceAsData(path));
+    if (!data) {
+        return;
+    }
+
+    // The codec cannot index a stream without a memory base, so this one skips the slow way.
+    std::unique_ptr<SkAndroidCodec> indexed(SkAndroidCodec::MakeFromData(data));
+    std::unique_ptr<SkAndroidCodec> unindexed(SkAndroidCodec::MakeFromStream(
+            std::make_unique<NotAssetMemStream>(data)));
+    if (!indexed || !unindexed) {
+        ERRORF(r, "Unable to create codecs for '%s'.", path);
+        return;
+    }
+
+    const SkIRect subsets[] = {
+        SkIRect::MakeXYWH(   0, 3500, 300, 200),
+        SkIRect::MakeXYWH(1001, 2047, 513, 129),
+        SkIRect::MakeXYWH(2500,   17, 500, 300),  // Too close to the top to jump.
+        SkIRect::MakeXYWH(  64, 1000, 128,  64),  // Revisits rows above the previous subset.
+        SkIRect::MakeXYWH(2000, 3800, 1024, 232),
+    };
+    for (int sampleSize : {1, 2}) {
+        for (const SkIRect& subset : subsets) {
+            SkAndroidCodec::AndroidOptions options;
+            options.fSampleSize = sampleSize;
+            options.fSubset = &subset;
+            const SkISize size = indexed->getSampledSubsetDimensions(sampleSize, subset);
+            const SkImageInfo info = indexed->getInfo().makeDimensions(size)
+                                                       .makeColorType(kN32_SkColorType);
+
+            SkBitmap expected, actual;
+            expected.allocPixels(info);
+            actual.allocPixels(info);
+            REPORTER_ASSERT(r, SkCodec::kSuccess == unindexed->getAndroidPixels(
+                    info, expected.getPixels(), expected.rowBytes(), &options));
+            REPORTER_ASSERT(r, SkCodec::kSuccess == indexed->getAndroidPixels(
+                    info, actual.getPixels(), actual.rowBytes(), &options));
+            REPORTER_ASSERT(r, md5(expected) == md5(actual),
+                            "sampleSize %d subset (%d, %d, %d, %d)", sampleSize, subset.x(),
+                            subset.y(), subset.width(), subset.height());
+        }
+    }
+}
+
+// SkFILEStream maps its file for getMemoryBase(), so codecs read files from memory instead of
+// copying them through read(). That should not change what they decode.
+DEF_TEST(Codec_FILEStreamMemoryBase, r) {
+    if (GetResourcePath().isEmpty()) {
+        return;
+    }
+
+    const char* paths[] = {
+        "images/alphabetAnim.gif",
+        "images/randPixels.gif",
+        "images/stoplight.webp",
+        "images/iphone_13_pro.jpeg",
+#if defined(SK_CODEC_DECODES_RAW) && (!defined(_WIN32))
+        "images/dng_with_preview.dng",
+        "images/sample_1mp.dng",
+#endif
+    };
+    for (const char* path : paths) {
+        sk_sp<SkData> data(GetResourceAsData(path));
+        std::unique_ptr<SkFILEStream> stream = SkFILEStream::Make(GetResourcePath(path).c_str());
+        if (!data || !stream) {
+            ERRORF(r, "Missing resource '%s'.", path);
+            continue;
+        }
+        REPORTER_ASSERT(r, stream->getMemoryBase(), "%s", path);
+
+        std::unique_ptr<SkCodec> mapped(SkCodec::MakeFromStream(std::move(stream)));
+        std::unique_ptr<SkCodec> copied(SkCodec::MakeFromStream(
+                std::make_unique<NotAssetMemStream>(data)));
+        if (!mapped || !copied) {
+            ERRORF(r, "Unable to create codecs for '%s'.", path);
+            continue;
+        }
+        REPORTER_ASSERT(r, mapped->getFrameCount() == copied->getFrameCount(), "%s", path);
+
+        const SkImageInfo info = copied->getInfo().makeColorType(kN32_SkColorType)
+                                                  .makeAlphaType(kPremul_SkAlphaType);
+        for (int i = 0; i < copied->getFrameCount(); i++) {
+            SkCodec::Options options;
+            options.fFrameIndex = i;
+            SkBitmap expected, actual;
+            expected.allocPixels(info);
+            actual.allocPixels(info);
+            const SkCodec::Result expectedResult = copied->getPixels(expected.pixmap(), &options);
+            REPORTER_ASSERT(r, expectedResult == mapped->getPixels(actual.pixmap(), &options),
+                            "%s frame %d", path, i);
+            REPORTER_ASSERT(r, md5(expected) == md5(actual), "%s frame %d", path, i);
+        }
+    }
+}
+
 static void check_color_xform(skiatest::Reporter* r, const char* path) {
     std::unique_ptr<SkAndroidCodec> codec(SkAndroidCodec::MakeFromStream(GetResourceAsStream(path)));
 
@@ -8,6 +8,7 @@
 #include "include/core/SkBitmap.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColor.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkMatrix.h"
 #include "include/core/SkPaint.h"
@@ -22,11 +23,18 @@
 #include "include/core/SkScalar.h"
 #include "include/core/SkStrokeRec.h"
 #include "include/core/SkSurface.h"
+#include "include/core/SkSurfaceProps.h"
 #include "include/core/SkTypes.h"
 #include "include/effects/SkDashPathEffect.h"
+#include "src/base/SkArenaAlloc.h"
+#include "src/core/SkBlitter.h"
+#include "src/core/SkRasterClip.h"
+#include "src/core/SkScan.h"
 #include "tests/Test.h"
 
 #include <cstdint>
+#include <cstdlib>
+#include <memory>
 
 // test that we can draw an aa-rect at coordinates > 32K (bigger than fixedpoint)
 static void test_big_aa_rect(skiatest::Reporter* reporter) {
@@ -424,3 +432,65 @@ DEF_TEST(DrawPath, reporter) {
     test_big_aa_rect(reporter);
     test_halfway();
 }
+
+// Huge paths may be scan converted in bands on other threads. That should draw what filling the
+// whole path at once does, give or take a little rounding where edges are clipped to each band.
+DEF_TEST(DrawPath_BandedFill, reporter) {
+    // A grid of small pentagons, plus a ring that crosses every band, for 80K+ points.
+    SkPath path;
+    for (int y = 0; y < 128; y++)
+    for (int x = 0; x < 128; x++) {
+        const float cx = 2.3f + 2 * x,
+                    cy = 1.7f + 2 * y;
+        path.moveTo(cx + 0.9f, cy);
+        for (int i = 1; i < 5; i++) {
+            const float a = i * 2 * SK_ScalarPI / 5;
+            path.lineTo(cx + 0.9f * SkScalarCos(a), cy + 0.9f * SkScalarSin(a));
+        }
+        path.close();
+    }
+    path.addCircle(130.5f, 129.25f, 110.3f);
+    path.addCircle(130.5f, 129.25f, 90.7f, SkPathDirection::kCCW);
+    REPORTER_ASSERT(reporter, path.countPoints() >= 65536);
+
+    SkPaint paint;
+    paint.setAntiAlias(true);
+
+    auto fill = [&](SkBitmap* bm, SkExecutor* executor) {
+        bm->allocPixels(SkImageInfo::MakeA8(260, 260));
+        bm->eraseColor(SK_ColorTRANSPARENT);
+
+        // Pass the executor in, rather than setting it for every test drawing on other threads.
+        SkSTArenaAlloc<256> alloc;
+        SkBlitter* blitter = SkBlitter::Choose(bm->pixmap(), SkMatrix::I(), paint, &alloc,
+                                               /*drawCoverage=*/false, /*clipShader=*/nullptr,
+                                               SkSurfaceProps());
+        SkScan::AntiFillPathForTesting(path, SkRasterClip(bm->bounds()), blitter, executor);
+    };
+
+    SkBitmap whole, banded, onExecutor;
+    fill(&whole, nullptr);
+    {
+        std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(2);
+        fill(&banded, executor.get());
+    }
+    {
+        // Draw from the only thread of an executor that can't lend it back to queued work.  If
+        // the fill waited on its bands there, nothing would ever run them.
+        std::unique_ptr<SkExecutor> executor =
+                SkExecutor::MakeFIFOThreadPool(1, /*allowBorrowing=*/false);
+        executor->add([&, pool = executor.get()] { fill(&onExecutor, pool); });
+    }  // Runs the queued fill, then joins the thread.
+
+    for (const SkBitmap* bm : {&banded, &onExecutor}) {
+        for (int y = 0; y < whole.height(); y++)
+        for (int x = 0; x < whole.width();  x++) {
+            const int want = *whole.getAddr8(x, y),
+                      got  = *bm->getAddr8(x, y);
+            if (std::abs(want - got) > 3) {
+                ERRORF(reporter, "banded %d, whole %d at (%d,%d)", got, want, x, y);
+                return;
+            }
+        }
+    }
+}
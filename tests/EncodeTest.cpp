@@ -15,10 +15,13 @@
 #include "include/core/SkData.h"
 #include "include/core/SkDataTable.h"
 #include "include/core/SkEncodedImageFormat.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkImageEncoder.h"
 #include "include/core/SkImageInfo.h"
+#include "include/core/SkPaint.h"
 #include "include/core/SkPixmap.h"
+#include "include/core/SkRect.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkStream.h"
 #include "include/core/SkSurface.h"
@@ -29,6 +32,7 @@
 #include "include/encode/SkWebpEncoder.h"
 #include "include/private/base/SkTemplates.h"
 #include "include/private/base/SkMalloc.h"
+#include "src/base/SkRandom.h"
 #include "src/core/SkImageInfoPriv.h"
 #include "tests/Test.h"
 #include "tools/Resources.h"
@@ -114,6 +118,93 @@ DEF_TEST(Encode, r) {
     test_encode(r, SkEncodedImageFormat::kPNG);
 }
 
+static std::unique_ptr<SkEncoder> make(SkEncodedImageFormat format, SkWStream* dst,
+                                       const SkImageInfo& info) {
+    switch (format) {
+        case SkEncodedImageFormat::kJPEG:
+            return SkJpegEncoder::Make(dst, info, SkJpegEncoder::Options());
+        case SkEncodedImageFormat::kPNG:
+            return SkPngEncoder::Make(dst, info, SkPngEncoder::Options());
+        default:
+            return nullptr;
+    }
+}
+
+static void test_encode_bands(skiatest::Reporter* r, SkEncodedImageFormat format) {
+    sk_sp<SkImage> image = GetResourceAsImage("images/mandrill_128.png");
+    if (!image) {
+        return;
+    }
+
+    // Taller than the image and not a multiple of any of the band heights below.
+    const SkImageInfo info = SkImageInfo::MakeN32Premul(150, 301);
+    auto draw = [&](SkCanvas* canvas) {
+        canvas->drawImage(image, 11, 0);
+        canvas->drawImage(image, 0, 150);
+        SkPaint paint;
+        paint.setAntiAlias(true);
+        paint.setColor(SK_ColorBLUE);
+        canvas->drawCircle(75, 150, 60, paint);
+    };
+
+    SkBitmap bitmap;
+    bitmap.allocPixels(info);
+    bitmap.eraseColor(SK_ColorTRANSPARENT);
+    {
+        SkCanvas canvas(bitmap);
+        draw(&canvas);
+    }
+
+    SkDynamicMemoryWStream expected;
+    REPORTER_ASSERT(r, encode(format, &expected, bitmap.pixmap()));
+    sk_sp<SkData> expectedData = expected.detachAsData();
+
+    // Rows handed over a band at a time from the full bitmap.
+    for (int bandHeight : {1, 16, 100, 301, 400}) {
+        SkDynamicMemoryWStream dst;
+        auto encoder = make(format, &dst, info);
+        REPORTER_ASSERT(r, encoder);
+        if (!encoder) {
+            return;
+        }
+        for (int y = 0; y < info.height(); y += bandHeight) {
+            SkPixmap rows;
+            const int numRows = std::min(bandHeight, info.height() - y);
+            bitmap.pixmap().extractSubset(&rows, SkIRect::MakeXYWH(0, y, info.width(), numRows));
+            REPORTER_ASSERT(r, encoder->encodeRows(rows));
+        }
+        // Rows past the end of the image are ignored.
+        REPORTER_ASSERT(r, !encoder->encodeRows(bitmap.pixmap()));
+        sk_sp<SkData> data = dst.detachAsData();
+        REPORTER_ASSERT(r, data->equals(expectedData.get()), "bandHeight %d", bandHeight);
+    }
+
+    // Rows drawn a band at a time.
+    for (int bandHeight : {1, 16, 100, 301, 400}) {
+        SkDynamicMemoryWStream dst;
+        auto encoder = make(format, &dst, info);
+        REPORTER_ASSERT(r, encoder && encoder->encodeBands(bandHeight, draw));
+        sk_sp<SkData> data = dst.detachAsData();
+        REPORTER_ASSERT(r, data->equals(expectedData.get()), "bandHeight %d", bandHeight);
+    }
+
+    // An encoder without pixels cannot read rows from its src, and rows must match the info.
+    SkDynamicMemoryWStream dst;
+    auto encoder = make(format, &dst, info);
+    REPORTER_ASSERT(r, !encoder->encodeRows(1));
+
+    SkPixmap narrow;
+    bitmap.pixmap().extractSubset(&narrow, SkIRect::MakeWH(info.width() - 1, 8));
+    encoder = make(format, &dst, info);
+    REPORTER_ASSERT(r, !encoder->encodeRows(narrow));
+    REPORTER_ASSERT(r, !encoder->encodeRows(SkPixmap()));
+}
+
+DEF_TEST(Encode_Bands, r) {
+    test_encode_bands(r, SkEncodedImageFormat::kJPEG);
+    test_encode_bands(r, SkEncodedImageFormat::kPNG);
+}
+
 static inline bool almost_equals(SkPMColor a, SkPMColor b, int tolerance) {
     if (SkTAbs((int)SkGetPackedR32(a) - (int)SkGetPackedR32(b)) > tolerance) {
         return false;
@@ -344,6 +435,41 @@ DEF_TEST(Encode_PngOptions, r) {
     REPORTER_ASSERT(r, almost_equals(bm0, bm2, 0));
 }
 
+DEF_TEST(Encode_PngParallel, r) {
+    // Half noise, half gradient, and big enough to be split into several bands.
+    SkBitmap bitmap;
+    bitmap.allocPixels(SkImageInfo::MakeN32(1000, 1500, kUnpremul_SkAlphaType));
+    SkRandom rand;
+    for (int y = 0; y < bitmap.height(); y++) {
+        for (int x = 0; x < bitmap.width(); x++) {
+            *bitmap.getAddr32(x, y) = x < bitmap.width() / 2
+                    ? rand.nextU()
+                    : SkPackARGB32NoCheck(y & 0xFF, x & 0xFF, (x + y) & 0xFF, 0x80);
+        }
+    }
+
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    for (auto filters : {SkPngEncoder::FilterFlag::kAll, SkPngEncoder::FilterFlag::kPaeth,
+                         SkPngEncoder::FilterFlag::kNone}) {
+        for (int zlibLevel : {0, 1, 6, 9}) {
+            SkPngEncoder::Options options;
+            options.fFilterFlags = filters;
+            options.fZLibLevel = zlibLevel;
+
+            SkDynamicMemoryWStream serial, parallel;
+            REPORTER_ASSERT(r, SkPngEncoder::Encode(&serial, bitmap.pixmap(), options));
+            options.fExecutor = executor.get();
+            REPORTER_ASSERT(r, SkPngEncoder::Encode(&parallel, bitmap.pixmap(), options));
+
+            SkBitmap bm0, bm1;
+            SkImage::MakeFromEncoded(serial.detachAsData())->asLegacyBitmap(&bm0);
+            SkImage::MakeFromEncoded(parallel.detachAsData())->asLegacyBitmap(&bm1);
+            REPORTER_ASSERT(r, almost_equals(bm0, bm1, 0),
+                            "filters %d, zlib level %d", (int)filters, zlibLevel);
+        }
+    }
+}
+
 #ifndef SK_BUILD_FOR_GOOGLE3
 DEF_TEST(Encode_WebpQuality, r) {
     SkBitmap bm;
@@ -445,6 +571,44 @@ DEF_TEST(Encode_WebpOptions, r) {
     REPORTER_ASSERT(r, almost_equals(bm2, bm3, 50));
 }
 
+DEF_TEST(Encode_WebpThreadsAndFastLossless, r) {
+    SkBitmap bitmap;
+    if (!GetResourceAsBitmap("images/google_chrome.ico", &bitmap)) {
+        return;
+    }
+
+    auto encode = [&](SkWebpEncoder::Compression compression, bool multithreaded, bool fast) {
+        SkWebpEncoder::Options options;
+        options.fCompression = compression;
+        options.fQuality = 90.0f;
+        options.fMultithreaded = multithreaded;
+        options.fFastLossless = fast;
+        SkDynamicMemoryWStream dst;
+        REPORTER_ASSERT(r, SkWebpEncoder::Encode(&dst, bitmap.pixmap(), options));
+        return dst.detachAsData();
+    };
+    auto decode = [&](sk_sp<SkData> data) {
+        SkBitmap bm;
+        sk_sp<SkImage> image = SkImage::MakeFromEncoded(std::move(data));
+        REPORTER_ASSERT(r, image && image->asLegacyBitmap(&bm));
+        return bm;
+    };
+
+    // Threads change how the work is scheduled, not what lossless output decodes to.
+    SkBitmap lossless = decode(encode(SkWebpEncoder::Compression::kLossless, false, false));
+    SkBitmap threaded = decode(encode(SkWebpEncoder::Compression::kLossless, true, false));
+    REPORTER_ASSERT(r, almost_equals(lossless, threaded, 0));
+
+    // The fast mode gives up size, never pixels.
+    SkBitmap fast = decode(encode(SkWebpEncoder::Compression::kLossless, true, true));
+    REPORTER_ASSERT(r, almost_equals(lossless, fast, 0));
+
+    SkBitmap lossy = decode(encode(SkWebpEncoder::Compression::kLossy, false, false));
+    SkBitmap lossyThreaded = decode(encode(SkWebpEncoder::Compression::kLossy, true, false));
+    REPORTER_ASSERT(r, almost_equals(lossless, lossyThreaded, 90));
+    REPORTER_ASSERT(r, almost_equals(lossy, lossyThreaded, 50));
+}
+
 DEF_TEST(Encode_WebpAnimated, r) {
     const int frameCount = 3;
     const int width = 16;
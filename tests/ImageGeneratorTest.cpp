@@ -6,6 +6,7 @@
  */
 
 #include "include/core/SkAlphaType.h"
+#include "include/core/SkBitmap.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColor.h"
 #include "include/core/SkColorSpace.h"
@@ -18,12 +19,18 @@
 #include "include/core/SkPicture.h"
 #include "include/core/SkPictureRecorder.h"
 #include "include/core/SkRefCnt.h"
+#include "include/core/SkSamplingOptions.h"
+#include "include/core/SkString.h"
 #include "include/core/SkYUVAInfo.h"
 #include "include/core/SkYUVAPixmaps.h"
 #include "src/base/SkAutoMalloc.h"
 #include "tests/Test.h"
+#include "tools/Resources.h"
 
+#include <cstring>
+#include <map>
 #include <memory>
+#include <string>
 
 #if defined(SK_BUILD_FOR_MAC) || defined(SK_BUILD_FOR_IOS)
     #include "include/ports/SkImageGeneratorCG.h"
@@ -131,3 +138,96 @@ DEF_TEST(PictureImageGenerator, reporter) {
     }
 }
 
+
+namespace {
+// Keeps entries in memory, standing in for files on disk.
+class MemoryPersistentCache : public SkImageGenerator::PersistentCache {
+public:
+    sk_sp<SkData> load(const SkData& key) override {
+        fLoads++;
+        auto entry = fEntries.find(std::string(key.bytes(), key.bytes() + key.size()));
+        return entry == fEntries.end() ? nullptr : entry->second;
+    }
+
+    void store(const SkData& key, const SkData& data, const SkString&) override {
+        fStores++;
+        fEntries[std::string(key.bytes(), key.bytes() + key.size())] =
+                SkData::MakeWithCopy(data.data(), data.size());
+    }
+
+    std::map<std::string, sk_sp<SkData>> fEntries;
+    int fLoads = 0;
+    int fStores = 0;
+};
+}  // namespace
+
+DEF_TEST(ImageGenerator_PersistentCache, reporter) {
+    sk_sp<SkData> encoded = GetResourceAsData("images/mandrill_128.png");
+    if (!encoded) {
+        return;
+    }
+    MemoryPersistentCache cache;
+
+    // A generator without encoded data has nothing to key the cache with.
+    auto pictureGen = SkImageGenerator::MakeFromPicture({100, 100}, make_picture(), nullptr,
+                                                        nullptr, SkImage::BitDepth::kU8,
+                                                        SkColorSpace::MakeSRGB());
+    SkImageGenerator* pictureGenPtr = pictureGen.get();
+    pictureGen = SkImageGenerator::MakeWithPersistentCache(std::move(pictureGen), &cache);
+    REPORTER_ASSERT(reporter, pictureGen.get() == pictureGenPtr);
+
+    SkBitmap expected;
+    {
+        auto gen = SkImageGenerator::MakeFromEncoded(encoded);
+        REPORTER_ASSERT(reporter, gen);
+        expected.allocPixels(gen->getInfo());
+        REPORTER_ASSERT(reporter, gen->getPixels(expected.pixmap()));
+    }
+
+    auto decode = [&](int expectedStores) {
+        auto gen = SkImageGenerator::MakeWithPersistentCache(
+                SkImageGenerator::MakeFromEncoded(encoded), &cache);
+        REPORTER_ASSERT(reporter, gen->refEncodedData() == encoded);
+        SkBitmap bm;
+        bm.allocPixels(gen->getInfo());
+        REPORTER_ASSERT(reporter, gen->getPixels(bm.pixmap()));
+        REPORTER_ASSERT(reporter, cache.fStores == expectedStores);
+        REPORTER_ASSERT(reporter, 0 == memcmp(bm.getPixels(), expected.getPixels(),
+                                              expected.computeByteSize()));
+    };
+
+    // The first decode misses and stores its pixels, later ones load them, even through a new
+    // generator, as a later process would.
+    decode(1);
+    REPORTER_ASSERT(reporter, cache.fLoads == 1);
+    decode(1);
+    REPORTER_ASSERT(reporter, cache.fLoads == 2);
+
+    // Entries that do not hold the expected pixels are decoded again and replaced.
+    REPORTER_ASSERT(reporter, cache.fEntries.size() == 1);
+    sk_sp<SkData>& entry = cache.fEntries.begin()->second;
+    entry = SkData::MakeSubset(entry.get(), 0, entry->size() / 2);
+    decode(2);
+    decode(2);
+
+    // Mipmaps built to draw the image are cached too.
+    auto draw = [&](SkBitmap* dst) {
+        SkGraphics::PurgeResourceCache();
+        sk_sp<SkImage> image = SkImage::MakeFromGenerator(
+                SkImageGenerator::MakeWithPersistentCache(
+                        SkImageGenerator::MakeFromEncoded(encoded), &cache, true));
+        dst->allocN32Pixels(image->width() / 5, image->height() / 5);
+        SkCanvas canvas(*dst);
+        canvas.scale(0.2f, 0.2f);
+        canvas.drawImage(image, 0, 0, SkSamplingOptions(SkFilterMode::kLinear,
+                                                        SkMipmapMode::kLinear));
+    };
+    SkBitmap first, second;
+    draw(&first);
+    REPORTER_ASSERT(reporter, cache.fStores == 3);
+    REPORTER_ASSERT(reporter, cache.fEntries.size() == 2);
+    draw(&second);
+    REPORTER_ASSERT(reporter, cache.fStores == 3);
+    REPORTER_ASSERT(reporter, 0 == memcmp(first.getPixels(), second.getPixels(),
+                                          first.computeByteSize()));
+}
@@ -10,6 +10,7 @@
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColor.h"
 #include "include/core/SkColorType.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkPixmap.h"
@@ -227,6 +228,44 @@ DEF_TEST(MipMap_F16, reporter) {
     sk_sp<SkMipmap> mipmap(SkMipmap::Build(bmp, nullptr));
 }
 
+DEF_TEST(MipMap_Executor, reporter) {
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    SkRandom rand;
+
+    // Big enough that the first few levels are split into several bands.
+    for (SkColorType ct : {kN32_SkColorType, kRGBA_F16_SkColorType}) {
+        for (SkISize size : {SkISize{1000, 700}, SkISize{1001, 701}, SkISize{1024, 3}}) {
+            SkBitmap bm;
+            bm.allocPixels(SkImageInfo::Make(size, ct, kPremul_SkAlphaType));
+            for (int y = 0; y < bm.height(); y++) {
+                // Random bytes for 8888, random halfs in [0,1) for F16.
+                auto row = static_cast<uint16_t*>(bm.getAddr(0, y));
+                for (size_t x = 0; x < bm.info().minRowBytes() / 2; x++) {
+                    row[x] = ct == kRGBA_F16_SkColorType ? rand.nextULessThan(0x3C00)
+                                                         : rand.nextU();
+                }
+            }
+
+            sk_sp<SkMipmap> serial(SkMipmap::Build(bm, nullptr));
+            sk_sp<SkMipmap> parallel(SkMipmap::Build(bm, nullptr, executor.get()));
+            REPORTER_ASSERT(reporter, serial && parallel);
+            REPORTER_ASSERT(reporter, serial->countLevels() == parallel->countLevels());
+
+            for (int i = 0; i < serial->countLevels(); ++i) {
+                SkMipmap::Level a, b;
+                REPORTER_ASSERT(reporter, serial->getLevel(i, &a));
+                REPORTER_ASSERT(reporter, parallel->getLevel(i, &b));
+                for (int y = 0; y < a.fPixmap.height(); y++) {
+                    REPORTER_ASSERT(reporter, 0 == memcmp(a.fPixmap.addr(0, y),
+                                                          b.fPixmap.addr(0, y),
+                                                          a.fPixmap.info().minRowBytes()),
+                                    "level %d row %d", i, y);
+                }
+            }
+        }
+    }
+}
+
 static void fill_in_mips(SkMipmapBuilder* builder, sk_sp<SkImage> img) {
     int count = builder->countLevels();
     for (int i = 0; i < count; ++i) {
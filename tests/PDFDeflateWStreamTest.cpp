@@ -8,6 +8,8 @@
 #include "include/core/SkTypes.h"
 
 #ifdef SK_SUPPORT_PDF
+#include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkStream.h"
 #include "include/core/SkString.h"
 #include "include/private/base/SkTemplates.h"
@@ -21,6 +23,7 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <memory>
 
 using namespace skia_private;
@@ -177,4 +180,39 @@ DEF_TEST(SkPDF_DeflateWStream, r) {
     REPORTER_ASSERT(r, !emptyDeflateWStream.writeText("FOO"));
 }
 
+DEF_TEST(SkPDF_DeflateParallel, r) {
+    // Repeat short random runs so matches span the chunk boundaries.
+    SkRandom random(654321);
+    const size_t size = 1300000;
+    AutoTMalloc<uint8_t> buffer(size);
+    for (size_t j = 0; j < size;) {
+        uint32_t run = random.nextRangeU(1, 64);
+        if (j >= 1000 && random.nextBool()) {
+            uint32_t back = random.nextRangeU(1, 1000);
+            for (uint32_t k = 0; k < run && j < size; ++k, ++j) {
+                buffer[j] = buffer[j - back];
+            }
+        } else {
+            for (uint32_t k = 0; k < run && j < size; ++k, ++j) {
+                buffer[j] = random.nextU() & 0xff;
+            }
+        }
+    }
+
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    for (int level : {-1, 1, 9}) {
+        SkDynamicMemoryWStream dynamicMemoryWStream;
+        SkDeflateParallel(buffer.get(), size, level, executor.get(), &dynamicMemoryWStream);
+        std::unique_ptr<SkStreamAsset> compressed(dynamicMemoryWStream.detachAsStream());
+        std::unique_ptr<SkStreamAsset> decompressed(stream_inflate(r, compressed.get()));
+        if (!decompressed) {
+            ERRORF(r, "Decompression failed at level %d.", level);
+            continue;
+        }
+        REPORTER_ASSERT(r, decompressed->getLength() == size);
+        sk_sp<SkData> data = SkData::MakeFromStream(decompressed.get(), size);
+        REPORTER_ASSERT(r, data && 0 == memcmp(data->data(), buffer.get(), size));
+    }
+}
+
 #endif
@@ -11,6 +11,7 @@
 #include "include/core/SkClipOp.h"
 #include "include/core/SkColor.h"
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkFont.h"
 #include "include/core/SkFontStyle.h"
 #include "include/core/SkImage.h" // IWYU pragma: keep
@@ -26,13 +27,17 @@
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkSamplingOptions.h"
 #include "include/core/SkScalar.h"
+#include "include/core/SkShader.h"
 #include "include/core/SkStream.h"
 #include "include/core/SkTypeface.h"
 #include "include/core/SkTypes.h"
+#include "include/effects/SkGradientShader.h"
 #include "src/base/SkRandom.h"
 #include "src/core/SkBigPicture.h"
 #include "src/core/SkPicturePriv.h"
 #include "src/core/SkRectPriv.h"
+#include "src/core/SkTiledPictureDraw.h"
+#include "tools/ToolUtils.h"
 #include "tests/Test.h"
 
 #include <cstddef>
@@ -945,3 +950,133 @@ DEF_TEST(Picture_nested_op_count, r) {
     check(make_pic(10, leaf1),  10,  10);
     check(make_pic(10, leaf10), 10, 100);
 }
+
+DEF_TEST(Picture_TiledDraw, r) {
+    // Lots of overlapping, anti-aliased, dithered draws that straddle tile boundaries.
+    SkRTreeFactory factory;
+    SkPictureRecorder recorder;
+    SkCanvas* c = recorder.beginRecording({0,0, 300,200}, &factory);
+    SkRandom rand;
+    for (int i = 0; i < 200; i++) {
+        SkPaint paint;
+        paint.setAntiAlias(true);
+        paint.setColor(rand.nextU() | 0x40000000);
+        if (i % 7 == 0) {
+            const SkPoint pts[] = {{0, 0}, {300, 200}};
+            const SkColor colors[] = {SK_ColorBLUE, SK_ColorYELLOW};
+            paint.setShader(SkGradientShader::MakeLinear(pts, colors, nullptr, 2,
+                                                         SkTileMode::kClamp));
+            paint.setDither(true);
+        }
+        const SkRect rect = SkRect::MakeXYWH(rand.nextRangeScalar(-20, 300),
+                                             rand.nextRangeScalar(-20, 200),
+                                             rand.nextRangeScalar(1, 80),
+                                             rand.nextRangeScalar(1, 80));
+        if (i % 2) {
+            c->drawOval(rect, paint);
+        } else {
+            c->drawRect(rect, paint);
+        }
+    }
+    sk_sp<SkPicture> picture = recorder.finishRecordingAsPicture();
+
+    const SkMatrix matrix = SkMatrix::Scale(1.5f, 1.25f);
+    const SkImageInfo info = SkImageInfo::MakeN32Premul(450, 250);
+
+    SkBitmap serial;
+    serial.allocPixels(info);
+    serial.eraseColor(SK_ColorWHITE);
+    {
+        SkCanvas canvas(serial);
+        canvas.concat(matrix);
+        picture->playback(&canvas);
+    }
+
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    for (SkISize tileSize : {SkISize{37, 53}, SkISize{256, 256}, SkISize{1000, 1}}) {
+        SkBitmap tiled;
+        tiled.allocPixels(info);
+        tiled.eraseColor(SK_ColorWHITE);
+        REPORTER_ASSERT(r, SkTiledPictureDraw(picture.get(), tiled.pixmap(), &matrix, nullptr,
+                                              tileSize, executor.get()));
+        REPORTER_ASSERT(r, ToolUtils::equal_pixels(serial, tiled),
+                        "tile size %dx%d", tileSize.width(), tileSize.height());
+    }
+}
+
+DEF_TEST(Picture_OcclusionPlayback, r) {
+    // Anti-aliased content, covered by an opaque background, then more content on top.
+    SkPictureRecorder recorder;
+    SkCanvas* c = recorder.beginRecording({0,0, 200,200});
+    SkRandom rand;
+    auto drawOvals = [&](int count) {
+        for (int i = 0; i < count; i++) {
+            SkPaint paint;
+            paint.setAntiAlias(true);
+            paint.setColor(rand.nextU() | 0x40000000);
+            c->drawOval(SkRect::MakeXYWH(rand.nextRangeScalar(10, 150),
+                                         rand.nextRangeScalar(10, 150),
+                                         rand.nextRangeScalar(1, 40),
+                                         rand.nextRangeScalar(1, 40)), paint);
+        }
+    };
+    // The save/restore keeps SkRecordOptimize from noop'ing these at record time.
+    c->save();
+        c->translate(1, 1);
+        drawOvals(20);
+    c->restore();
+    SkPaint background;
+    background.setColor(SK_ColorGREEN);
+    c->drawRect({5.5f, 5.5f, 195.5f, 195.5f}, background);
+    drawOvals(20);
+    c->save();
+        c->clipRect({0, 0, 100, 100});
+        drawOvals(5);
+        c->drawRect({0, 0, 200, 200}, background);  // Clipped, so doesn't hide anything.
+    c->restore();
+    sk_sp<SkPicture> picture = recorder.finishRecordingAsPicture();
+    const SkBigPicture* big = SkPicturePriv::AsSkBigPicture(picture);
+    REPORTER_ASSERT(r, big);
+    if (!big) {
+        return;
+    }
+
+    auto draw = [&](bool occlusion, const SkMatrix& matrix, bool aaClip, bool clipShader,
+                    int* skipped) {
+        SkBitmap bitmap;
+        bitmap.allocN32Pixels(200, 200);
+        bitmap.eraseColor(SK_ColorWHITE);
+        SkCanvas canvas(bitmap);
+        canvas.clipRect({0.5f, 0.5f, 180.25f, 190}, aaClip);
+        if (clipShader) {
+            canvas.clipShader(SkShaders::Color(0x80000000));
+        }
+        canvas.concat(matrix);
+        if (occlusion) {
+            *skipped = big->playbackWithOcclusion(&canvas);
+        } else {
+            picture->playback(&canvas);
+        }
+        return bitmap;
+    };
+
+    struct {
+        SkMatrix matrix;
+        bool aaClip;
+        bool clipShader;
+        int expectedSkips;
+    } cases[] = {
+        {SkMatrix::I(), false, false, 20},
+        {SkMatrix::Scale(0.9f, 0.7f), false, false, 20},
+        {SkMatrix::I(), true, false, 0},           // Soft clip edges would show the hidden ovals.
+        {SkMatrix::I(), false, true, 0},           // So would a translucent clip shader.
+        {SkMatrix::RotateDeg(5), false, false, 0}, // The background doesn't stay a rect.
+    };
+    for (const auto& c : cases) {
+        int skipped = -1;
+        SkBitmap expected = draw(false, c.matrix, c.aaClip, c.clipShader, nullptr),
+                 actual   = draw(true,  c.matrix, c.aaClip, c.clipShader, &skipped);
+        REPORTER_ASSERT(r, skipped == c.expectedSkips, "%d != %d", skipped, c.expectedSkips);
+        REPORTER_ASSERT(r, ToolUtils::equal_pixels(expected, actual));
+    }
+}
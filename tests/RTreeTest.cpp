@@ -98,3 +98,41 @@ DEF_TEST(RTree, reporter) {
                                   expectedDepthMax >= rtree.getDepth());
     }
 }
+
+DEF_TEST(RTree_Large, reporter) {
+    constexpr int N = 20000;
+    SkRandom rand;
+    std::vector<SkRect> rects(N);
+    for (int i = 0; i < N; i++) {
+        rects[i] = SkRect::MakeXYWH(rand.nextRangeF(0, 1000), rand.nextRangeF(0, 1000),
+                                    rand.nextRangeF(0, 20),   rand.nextRangeF(0, 20));
+        if (i % 7 == 0) {
+            rects[i].setEmpty();  // Never found.
+        }
+    }
+    SkRTree rtree;
+    rtree.insert(rects.data(), N);
+
+    for (int q = 0; q < 100; q++) {
+        SkRect query = random_rect(rand);
+        if (q % 10 == 0) {
+            query.fRight = query.fLeft;  // Empty queries find nothing.
+        }
+        std::vector<int> hits, expected;
+        rtree.search(query, &hits);
+        for (int i = 0; i < N; i++) {
+            if (SkRect::Intersects(query, rects[i])) {
+                expected.push_back(i);
+            }
+        }
+        REPORTER_ASSERT(reporter, hits == expected);  // Including order.
+    }
+
+    // Rects that only share an edge with the query don't intersect it.
+    SkRTree edges;
+    SkRect edgeRects[] = {{0,0,10,10}, {10,0,20,10}, {20,0,30,10}};
+    edges.insert(edgeRects, std::size(edgeRects));
+    std::vector<int> hits;
+    edges.search({10,0,20,10}, &hits);
+    REPORTER_ASSERT(reporter, hits == std::vector<int>{1});
+}
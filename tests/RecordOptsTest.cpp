@@ -5,6 +5,7 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkBitmap.h"
 #include "include/core/SkBlendMode.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColor.h"
@@ -20,11 +21,13 @@
 #include "include/core/SkSurface.h"
 #include "include/effects/SkImageFilters.h"
 #include "src/core/SkRecord.h"
+#include "src/core/SkRecordDraw.h"
 #include "src/core/SkRecordOpts.h"
 #include "src/core/SkRecorder.h"
 #include "src/core/SkRecords.h"
 #include "tests/RecordTestUtils.h"
 #include "tests/Test.h"
+#include "tools/ToolUtils.h"
 
 #include <array>
 #include <cstddef>
@@ -359,6 +362,122 @@ DEF_TEST(RecordOpts_MergeSvgOpacityAndFilterLayers, r) {
     index += 4;
 }
 
+// Plays back record under a rotation and scale, so rect edges don't fall on pixel boundaries.
+static SkBitmap draw_record(const SkRecord& record) {
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(100, 100);
+    bitmap.eraseColor(SK_ColorWHITE);
+    SkCanvas canvas(bitmap);
+    canvas.rotate(10);
+    canvas.scale(0.73f, 0.81f);
+    SkRecordDraw(record, &canvas, nullptr, nullptr, 0, nullptr, nullptr);
+    return bitmap;
+}
+
+static void record_overdraw(SkCanvas* canvas) {
+    SkPaint red, aa, green, translucent, clear;
+    red.setColor(SK_ColorRED);
+    aa.setAntiAlias(true);
+    green.setColor(SK_ColorGREEN);
+    translucent.setColor(0x80000000);
+    clear.setBlendMode(SkBlendMode::kSrc);
+    clear.setColor(SK_ColorTRANSPARENT);
+
+    canvas->drawRect(SkRect::MakeLTRB(15, 15, 50, 50), red);        // Hidden by green.
+    canvas->drawRect(SkRect::MakeLTRB(20, 20, 30, 30), aa);         // AA, so not hidden.
+    canvas->drawRect(SkRect::MakeLTRB(10, 10, 90, 90), green);
+    canvas->drawRect(SkRect::MakeLTRB(30, 30, 40, 40), translucent);
+    canvas->drawRect(SkRect::MakeLTRB(35, 35, 38, 38), red);        // Translucent can't hide.
+    canvas->save();
+        canvas->clipRect(SkRect::MakeLTRB(0, 0, 60, 60));
+        canvas->drawRect(SkRect::MakeLTRB(5, 5, 15, 15), aa);       // Hidden by the clear.
+        canvas->drawPaint(clear);
+        canvas->drawRect(SkRect::MakeLTRB(5, 5, 15, 15), red);
+    canvas->restore();
+}
+
+DEF_TEST(RecordOpts_NoopOverdrawnDraws, r) {
+    SkRecord record, reference;
+    SkRecorder recorder(&record, W, H), referenceRecorder(&reference, W, H);
+    record_overdraw(&recorder);
+    record_overdraw(&referenceRecorder);
+
+    SkRecordNoopOverdrawnDraws(&record);
+
+    assert_type<SkRecords::NoOp>(r, record, 0);
+    assert_type<SkRecords::DrawRect>(r, record, 1);
+    assert_type<SkRecords::DrawRect>(r, record, 2);
+    assert_type<SkRecords::DrawRect>(r, record, 3);
+    assert_type<SkRecords::DrawRect>(r, record, 4);
+    assert_type<SkRecords::Save>(r, record, 5);
+    assert_type<SkRecords::ClipRect>(r, record, 6);
+    assert_type<SkRecords::NoOp>(r, record, 7);
+    assert_type<SkRecords::DrawPaint>(r, record, 8);
+    assert_type<SkRecords::DrawRect>(r, record, 9);
+
+    SkBitmap expected = draw_record(reference),
+             actual   = draw_record(record);
+    REPORTER_ASSERT(r, ToolUtils::equal_pixels(expected, actual));
+
+    // Nothing is hidden when an anti-aliased clip might blend the edges.
+    SkRecord aaClipRecord;
+    SkRecorder aaClipRecorder(&aaClipRecord, W, H);
+    aaClipRecorder.clipRect(SkRect::MakeWH(50, 50), /*doAntiAlias=*/true);
+    record_overdraw(&aaClipRecorder);
+    SkRecordNoopOverdrawnDraws(&aaClipRecord);
+    REPORTER_ASSERT(r, 0 == count_instances_of_type<SkRecords::NoOp>(aaClipRecord));
+}
+
+static void record_rects(SkCanvas* canvas) {
+    SkPaint blue, red, aa;
+    blue.setColor(SK_ColorBLUE);
+    red.setColor(SK_ColorRED);
+    aa.setAntiAlias(true);
+
+    canvas->drawRect(SkRect::MakeLTRB( 0, 0, 10, 10), blue);
+    canvas->drawRect(SkRect::MakeLTRB(20, 0, 30, 10), red);
+    canvas->drawRect(SkRect::MakeLTRB(40, 0, 50, 10), blue);
+    canvas->drawRect(SkRect::MakeLTRB( 5, 5, 15, 15), blue);  // Only overlaps other blues.
+    canvas->drawRect(SkRect::MakeLTRB(25, 5, 35, 15), blue);  // Overlaps red, so stays put.
+    canvas->drawRect(SkRect::MakeLTRB(60, 0, 70, 10), red);
+    canvas->drawRect(SkRect::MakeLTRB(60, 20, 70, 30), aa);   // Not exact, so ends the run.
+    canvas->drawRect(SkRect::MakeLTRB(80, 0, 90, 10), red);
+}
+
+DEF_TEST(RecordOpts_BatchRects, r) {
+    SkRecord record, reference;
+    SkRecorder recorder(&record, W, H), referenceRecorder(&reference, W, H);
+    record_rects(&recorder);
+    record_rects(&referenceRecorder);
+
+    SkRecordBatchRects(&record);
+
+    // Blues gather first, then reds; the blue that overlaps a red stays behind it.
+    struct {
+        SkColor color;
+        SkRect rect;
+    } expectedRects[] = {
+        {SK_ColorBLUE,  SkRect::MakeLTRB( 0, 0, 10, 10)},
+        {SK_ColorBLUE,  SkRect::MakeLTRB(40, 0, 50, 10)},
+        {SK_ColorBLUE,  SkRect::MakeLTRB( 5, 5, 15, 15)},
+        {SK_ColorRED,   SkRect::MakeLTRB(20, 0, 30, 10)},
+        {SK_ColorRED,   SkRect::MakeLTRB(60, 0, 70, 10)},
+        {SK_ColorBLUE,  SkRect::MakeLTRB(25, 5, 35, 15)},
+        {SK_ColorBLACK, SkRect::MakeLTRB(60, 20, 70, 30)},
+        {SK_ColorRED,   SkRect::MakeLTRB(80, 0, 90, 10)},
+    };
+    REPORTER_ASSERT(r, record.count() == (int)std::size(expectedRects));
+    for (int i = 0; i < (int)std::size(expectedRects); i++) {
+        const SkRecords::DrawRect* draw = assert_type<SkRecords::DrawRect>(r, record, i);
+        REPORTER_ASSERT(r, draw && draw->paint.getColor() == expectedRects[i].color, "%d", i);
+        REPORTER_ASSERT(r, draw && draw->rect == expectedRects[i].rect, "%d", i);
+    }
+
+    SkBitmap expected = draw_record(reference),
+             actual   = draw_record(record);
+    REPORTER_ASSERT(r, ToolUtils::equal_pixels(expected, actual));
+}
+
 static void do_draw(SkCanvas* canvas, SkColor color, bool doLayer) {
     canvas->drawColor(SK_ColorWHITE);
 
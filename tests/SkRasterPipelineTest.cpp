@@ -5,16 +5,27 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkBitmap.h"
+#include "include/core/SkBlendMode.h"
+#include "include/core/SkMatrix.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkSurfaceProps.h"
 #include "include/private/base/SkTo.h"
+#include "src/base/SkArenaAlloc.h"
 #include "src/base/SkHalf.h"
 #include "src/base/SkUtils.h"
+#include "src/core/SkBlitter.h"
+#include "src/core/SkCoreBlitters.h"
 #include "src/core/SkOpts.h"
 #include "src/core/SkRasterPipeline.h"
 #include "src/gpu/Swizzle.h"
 #include "tests/Test.h"
 
 #include <cmath>
+#include <iterator>
 #include <numeric>
+#include <utility>
+#include <vector>
 
 DEF_TEST(SkRasterPipeline, r) {
     // Build and run a simple pipeline to exercise SkRasterPipeline,
@@ -42,7 +53,8 @@ DEF_TEST(SkRasterPipeline, r) {
 }
 
 DEF_TEST(SkRasterPipeline_LoadStoreConditionMask, r) {
-    alignas(64) int32_t mask[]  = {~0, 0, ~0,  0, ~0, ~0, ~0,  0};
+    alignas(64) int32_t mask[]  = {~0, 0, ~0,  0, ~0, ~0, ~0,  0,
+                                   ~0, ~0, 0, ~0,  0, ~0,  0, ~0};
     alignas(64) int32_t maskCopy[SkRasterPipeline_kMaxStride_highp] = {};
     alignas(64) int32_t dst[4 * SkRasterPipeline_kMaxStride_highp] = {};
 
@@ -85,7 +97,8 @@ DEF_TEST(SkRasterPipeline_LoadStoreConditionMask, r) {
 }
 
 DEF_TEST(SkRasterPipeline_LoadStoreLoopMask, r) {
-    alignas(64) int32_t mask[]  = {~0, 0, ~0,  0, ~0, ~0, ~0,  0};
+    alignas(64) int32_t mask[]  = {~0, 0, ~0,  0, ~0, ~0, ~0,  0,
+                                   ~0, ~0, 0, ~0,  0, ~0,  0, ~0};
     alignas(64) int32_t maskCopy[SkRasterPipeline_kMaxStride_highp] = {};
     alignas(64) int32_t dst[4 * SkRasterPipeline_kMaxStride_highp] = {};
 
@@ -128,7 +141,8 @@ DEF_TEST(SkRasterPipeline_LoadStoreLoopMask, r) {
 }
 
 DEF_TEST(SkRasterPipeline_LoadStoreReturnMask, r) {
-    alignas(64) int32_t mask[]  = {~0, 0, ~0,  0, ~0, ~0, ~0,  0};
+    alignas(64) int32_t mask[]  = {~0, 0, ~0,  0, ~0, ~0, ~0,  0,
+                                   ~0, ~0, 0, ~0,  0, ~0,  0, ~0};
     alignas(64) int32_t maskCopy[SkRasterPipeline_kMaxStride_highp] = {};
     alignas(64) int32_t dst[4 * SkRasterPipeline_kMaxStride_highp] = {};
 
@@ -172,7 +186,9 @@ DEF_TEST(SkRasterPipeline_LoadStoreReturnMask, r) {
 
 DEF_TEST(SkRasterPipeline_MergeConditionMask, r) {
     alignas(64) int32_t mask[]  = { 0,  0, ~0, ~0, 0, ~0, 0, ~0,
-                                   ~0, ~0, ~0, ~0, 0,  0, 0,  0};
+                                   ~0,  0, ~0,  0, ~0, 0, 0, ~0,
+                                   ~0, ~0, ~0, ~0, 0,  0, 0,  0,
+                                   ~0, ~0,  0,  0, 0, ~0, 0, ~0};
     alignas(64) int32_t dst[4 * SkRasterPipeline_kMaxStride_highp] = {};
     static_assert(std::size(mask) == (2 * SkRasterPipeline_kMaxStride_highp));
 
@@ -199,10 +215,15 @@ DEF_TEST(SkRasterPipeline_MergeConditionMask, r) {
 
 DEF_TEST(SkRasterPipeline_MergeLoopMask, r) {
     alignas(64) int32_t initial[]  = {~0, ~0, ~0, ~0, ~0,  0, ~0, ~0,  // dr (condition)
+                                      ~0, ~0, ~0, ~0, ~0,  0, ~0, ~0,
                                       ~0,  0, ~0,  0, ~0, ~0, ~0, ~0,  // dg (loop)
+                                      ~0,  0, ~0,  0, ~0, ~0, ~0, ~0,
                                       ~0, ~0, ~0, ~0, ~0, ~0,  0, ~0,  // db (return)
-                                      ~0, ~0, ~0, ~0, ~0, ~0, ~0, ~0}; // da (combined)
-    alignas(64) int32_t mask[]     = { 0, ~0, ~0,  0, ~0, ~0, ~0, ~0};
+                                      ~0, ~0, ~0, ~0, ~0, ~0,  0, ~0,
+                                      ~0, ~0, ~0, ~0, ~0, ~0, ~0, ~0,  // da (combined)
+                                      ~0, ~0, ~0, ~0, ~0, ~0, ~0, ~0};
+    alignas(64) int32_t mask[]     = { 0, ~0, ~0,  0, ~0, ~0, ~0, ~0,
+                                      ~0, ~0,  0, ~0,  0, ~0, ~0,  0};
     alignas(64) int32_t dst[4 * SkRasterPipeline_kMaxStride_highp] = {};
     static_assert(std::size(initial) == (4 * SkRasterPipeline_kMaxStride_highp));
 
@@ -231,10 +252,15 @@ DEF_TEST(SkRasterPipeline_MergeLoopMask, r) {
 
 DEF_TEST(SkRasterPipeline_ReenableLoopMask, r) {
     alignas(64) int32_t initial[]  = {~0, ~0, ~0, ~0, ~0,  0, ~0, ~0,  // dr (condition)
+                                      ~0, ~0, ~0, ~0, ~0,  0, ~0, ~0,
                                       ~0,  0, ~0,  0, ~0, ~0,  0, ~0,  // dg (loop)
+                                      ~0,  0, ~0,  0, ~0, ~0,  0, ~0,
                                        0, ~0, ~0, ~0,  0,  0,  0, ~0,  // db (return)
-                                       0,  0, ~0,  0,  0,  0,  0, ~0}; // da (combined)
-    alignas(64) int32_t mask[]     = { 0, ~0,  0,  0,  0,  0, ~0,  0};
+                                       0, ~0, ~0, ~0,  0,  0,  0, ~0,
+                                       0,  0, ~0,  0,  0,  0,  0, ~0,  // da (combined)
+                                       0,  0, ~0,  0,  0,  0,  0, ~0};
+    alignas(64) int32_t mask[]     = { 0, ~0,  0,  0,  0,  0, ~0,  0,
+                                      ~0,  0,  0,  0, ~0,  0,  0,  0};
     alignas(64) int32_t dst[4 * SkRasterPipeline_kMaxStride_highp] = {};
     static_assert(std::size(initial) == (4 * SkRasterPipeline_kMaxStride_highp));
 
@@ -263,13 +289,18 @@ DEF_TEST(SkRasterPipeline_ReenableLoopMask, r) {
 
 DEF_TEST(SkRasterPipeline_CaseOp, r) {
     alignas(64) int32_t initial[]        = {~0, ~0, ~0, ~0, ~0,  0, ~0, ~0,  // dr (condition)
+                                            ~0, ~0, ~0, ~0, ~0,  0, ~0, ~0,
                                              0, ~0, ~0,  0, ~0, ~0,  0, ~0,  // dg (loop)
+                                             0, ~0, ~0,  0, ~0, ~0,  0, ~0,
                                             ~0,  0, ~0, ~0,  0,  0,  0, ~0,  // db (return)
-                                             0,  0, ~0,  0,  0,  0,  0, ~0}; // da (combined)
+                                            ~0,  0, ~0, ~0,  0,  0,  0, ~0,
+                                             0,  0, ~0,  0,  0,  0,  0, ~0,  // da (combined)
+                                             0,  0, ~0,  0,  0,  0,  0, ~0};
     alignas(64) int32_t dst[4 * SkRasterPipeline_kMaxStride_highp] = {};
     static_assert(std::size(initial) == (4 * SkRasterPipeline_kMaxStride_highp));
 
-    constexpr int32_t actualValues[] = { 2,  1,  2,  4,  5,  2,  2,  8};
+    constexpr int32_t actualValues[] = { 2,  1,  2,  4,  5,  2,  2,  8,
+                                         2,  3,  9,  2,  2,  7,  2,  6};
     static_assert(std::size(actualValues) == SkRasterPipeline_kMaxStride_highp);
 
     alignas(64) int32_t caseOpData[2 * SkRasterPipeline_kMaxStride_highp];
@@ -318,9 +349,13 @@ DEF_TEST(SkRasterPipeline_CaseOp, r) {
 
 DEF_TEST(SkRasterPipeline_MaskOffLoopMask, r) {
     alignas(64) int32_t initial[]  = {~0, ~0, ~0, ~0, ~0,  0, ~0, ~0,  // dr (condition)
+                                      ~0, ~0, ~0, ~0, ~0,  0, ~0, ~0,
                                       ~0,  0, ~0, ~0,  0,  0,  0, ~0,  // dg (loop)
+                                      ~0,  0, ~0, ~0,  0,  0,  0, ~0,
                                       ~0, ~0,  0, ~0,  0,  0, ~0, ~0,  // db (return)
-                                      ~0,  0,  0, ~0,  0,  0,  0, ~0}; // da (combined)
+                                      ~0, ~0,  0, ~0,  0,  0, ~0, ~0,
+                                      ~0,  0,  0, ~0,  0,  0,  0, ~0,  // da (combined)
+                                      ~0,  0,  0, ~0,  0,  0,  0, ~0};
     alignas(64) int32_t dst[4 * SkRasterPipeline_kMaxStride_highp] = {};
     static_assert(std::size(initial) == (4 * SkRasterPipeline_kMaxStride_highp));
 
@@ -347,9 +382,13 @@ DEF_TEST(SkRasterPipeline_MaskOffLoopMask, r) {
 
 DEF_TEST(SkRasterPipeline_MaskOffReturnMask, r) {
     alignas(64) int32_t initial[]  = {~0, ~0, ~0, ~0, ~0,  0, ~0, ~0,  // dr (condition)
+                                      ~0, ~0, ~0, ~0, ~0,  0, ~0, ~0,
                                       ~0,  0, ~0, ~0,  0,  0,  0, ~0,  // dg (loop)
+                                      ~0,  0, ~0, ~0,  0,  0,  0, ~0,
                                       ~0, ~0,  0, ~0,  0,  0, ~0, ~0,  // db (return)
-                                      ~0,  0,  0, ~0,  0,  0,  0, ~0}; // da (combined)
+                                      ~0, ~0,  0, ~0,  0,  0, ~0, ~0,
+                                      ~0,  0,  0, ~0,  0,  0,  0, ~0,  // da (combined)
+                                      ~0,  0,  0, ~0,  0,  0,  0, ~0};
     alignas(64) int32_t dst[4 * SkRasterPipeline_kMaxStride_highp] = {};
     static_assert(std::size(initial) == (4 * SkRasterPipeline_kMaxStride_highp));
 
@@ -426,16 +465,21 @@ DEF_TEST(SkRasterPipeline_CopyFromIndirectMasked, r) {
     alignas(64) float dst[5 * SkRasterPipeline_kMaxStride_highp];
 
     // Test with various mixes of indirect offsets.
-    static_assert(SkRasterPipeline_kMaxStride_highp == 8);
-    alignas(64) const uint32_t kOffsets1[8] = {0, 0, 0, 0, 0, 0, 0, 0};
-    alignas(64) const uint32_t kOffsets2[8] = {2, 2, 2, 2, 2, 2, 2, 2};
-    alignas(64) const uint32_t kOffsets3[8] = {0, 2, 0, 2, 0, 2, 0, 2};
-    alignas(64) const uint32_t kOffsets4[8] = {99, 99, 0, 0, 99, 99, 0, 0};
-
-    alignas(64) const int32_t kMask1[8] = {~0, ~0, ~0, ~0, ~0, ~0, ~0, ~0};
-    alignas(64) const int32_t kMask2[8] = { 0,  0,  0,  0,  0,  0,  0,  0};
-    alignas(64) const int32_t kMask3[8] = {~0,  0, ~0, ~0, ~0, ~0,  0, ~0};
-    alignas(64) const int32_t kMask4[8] = { 0, ~0,  0,  0,  0, ~0, ~0,  0};
+    static_assert(SkRasterPipeline_kMaxStride_highp == 16);
+    alignas(64) const uint32_t kOffsets1[16] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+    alignas(64) const uint32_t kOffsets2[16] = {2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2};
+    alignas(64) const uint32_t kOffsets3[16] = {0, 2, 0, 2, 0, 2, 0, 2, 0, 2, 0, 2, 0, 2, 0, 2};
+    alignas(64) const uint32_t kOffsets4[16] = {99, 99, 0, 0, 99, 99, 0, 0,
+                                                99, 99, 0, 0, 99, 99, 0, 0};
+
+    alignas(64) const int32_t kMask1[16] = {~0, ~0, ~0, ~0, ~0, ~0, ~0, ~0,
+                                            ~0, ~0, ~0, ~0, ~0, ~0, ~0, ~0};
+    alignas(64) const int32_t kMask2[16] = { 0,  0,  0,  0,  0,  0,  0,  0,
+                                             0,  0,  0,  0,  0,  0,  0,  0};
+    alignas(64) const int32_t kMask3[16] = {~0,  0, ~0, ~0, ~0, ~0,  0, ~0,
+                                             0, ~0, ~0,  0, ~0,  0, ~0, ~0};
+    alignas(64) const int32_t kMask4[16] = { 0, ~0,  0,  0,  0, ~0, ~0,  0,
+                                            ~0,  0,  0, ~0,  0, ~0,  0,  0};
 
     const int N = SkOpts::raster_pipeline_highp_stride;
 
@@ -518,11 +562,15 @@ DEF_TEST(SkRasterPipeline_CopySlotsMasked, r) {
         {SkRasterPipelineOp::copy_4_slots_masked, 4},
     };
 
-    static_assert(SkRasterPipeline_kMaxStride_highp == 8);
-    alignas(64) const int32_t kMask1[8] = {~0, ~0, ~0, ~0, ~0, ~0, ~0, ~0};
-    alignas(64) const int32_t kMask2[8] = { 0,  0,  0,  0,  0,  0,  0,  0};
-    alignas(64) const int32_t kMask3[8] = {~0,  0, ~0, ~0, ~0, ~0,  0, ~0};
-    alignas(64) const int32_t kMask4[8] = { 0, ~0,  0,  0,  0, ~0, ~0,  0};
+    static_assert(SkRasterPipeline_kMaxStride_highp == 16);
+    alignas(64) const int32_t kMask1[16] = {~0, ~0, ~0, ~0, ~0, ~0, ~0, ~0,
+                                            ~0, ~0, ~0, ~0, ~0, ~0, ~0, ~0};
+    alignas(64) const int32_t kMask2[16] = { 0,  0,  0,  0,  0,  0,  0,  0,
+                                             0,  0,  0,  0,  0,  0,  0,  0};
+    alignas(64) const int32_t kMask3[16] = {~0,  0, ~0, ~0, ~0, ~0,  0, ~0,
+                                             0, ~0, ~0,  0, ~0,  0, ~0, ~0};
+    alignas(64) const int32_t kMask4[16] = { 0, ~0,  0,  0,  0, ~0, ~0,  0,
+                                            ~0,  0,  0, ~0,  0, ~0,  0,  0};
 
     const int N = SkOpts::raster_pipeline_highp_stride;
 
@@ -2336,6 +2384,65 @@ DEF_TEST(SkRasterPipeline_lowp_clamp01, r) {
     p.run(0,0,1,1);
 }
 
+extern bool gDisableRasterPipelineStageFusion;
+
+DEF_TEST(SkRasterPipeline_fused_srcover_8888, r) {
+    // Each of these runs of stages can be fused into a single stage. Fused or not, they must
+    // draw exactly the same thing.
+    const float color[] = {0.25f, 0.5f, 0.0f, 0.75f};
+    float coverage = 0.6f;
+
+    for (bool uniformColor : {false, true})
+    for (bool clamp        : {false, true})
+    for (bool scale        : {false, true})
+    for (bool fusedSrcover : {false, true}) {
+        uint32_t src[67], dst[2][67];
+        for (int i = 0; i < 67; i++) {
+            src[i] = 0x80000000 | (i*3) << 16 | (i*2) << 8 | i;
+            dst[0][i] = dst[1][i] = (255-i) << 24 | (i*3) << 16 | (255-i) << 8 | (i*2);
+        }
+
+        for (bool fuse : {false, true}) {
+            SkRasterPipeline_MemoryCtx srcPtr = {src, 0},
+                                       dstPtr = {dst[fuse], 0};
+            SkSTArenaAlloc<256> alloc;
+            SkRasterPipeline p(&alloc);
+            if (uniformColor) {
+                p.append_constant_color(&alloc, color);
+            } else {
+                p.append(SkRasterPipelineOp::load_8888, &srcPtr);
+            }
+            if (clamp) {
+                p.append(SkRasterPipelineOp::clamp_01);
+            }
+            if (scale) {
+                p.append(SkRasterPipelineOp::scale_1_float, &coverage);
+            }
+            if (fusedSrcover) {
+                p.append(SkRasterPipelineOp::srcover_rgba_8888, &dstPtr);
+            } else {
+                p.append(SkRasterPipelineOp::load_8888_dst, &dstPtr);
+                p.append(SkRasterPipelineOp::srcover);
+                p.append(SkRasterPipelineOp::store_8888, &dstPtr);
+            }
+
+            gDisableRasterPipelineStageFusion = !fuse;
+            p.compile()(0,0, 64,1);
+            p.run(64,0, 3,1);
+            gDisableRasterPipelineStageFusion = false;
+        }
+
+        for (int i = 0; i < 67; i++) {
+            if (dst[0][i] != dst[1][i]) {
+                ERRORF(r, "uniform color %d, clamp %d, scale %d, srcover_rgba_8888 %d: "
+                          "fused %08x, unfused %08x at %d\n",
+                       uniformColor, clamp, scale, fusedSrcover, dst[1][i], dst[0][i], i);
+                break;
+            }
+        }
+    }
+}
+
 // Helper struct that can be used to scrape stack addresses at different points in a pipeline
 class StackCheckerCtx : SkRasterPipeline_CallbackCtx {
 public:
@@ -2442,3 +2549,67 @@ DEF_TEST(SkRasterPipeline_stack_rewind, r) {
         stack.validate(r);
     }
 }
+
+// SkRasterPipelineBlitter::blitAntiH() gathers short runs of coverage into a single blit. That must
+// draw exactly what blitting each run on its own, with its own blitAntiH() call, does.
+DEF_TEST(SkRasterPipelineBlitter_CoverageBatching, r) {
+    constexpr int kWidth = 140;
+    // Run lengths and coverage for a few scanlines: short runs only, short runs between long
+    // ones, and zero runs at either end and in the middle.
+    const std::vector<std::pair<int, SkAlpha>> rows[] = {
+        {{3, 0x40}, {1, 0xff}, {5, 0x00}, {2, 0x80}, {7, 0xff}, {1, 0x01}, {121, 0x00}},
+        {{20, 0x00}, {2, 0x30}, {40, 0xff}, {3, 0xc0}, {3, 0x00}, {1, 0x7f}, {71, 0x00}},
+        {{1, 0x10}, {17, 0x90}, {4, 0x00}, {4, 0xee}, {16, 0x00}, {2, 0xff}, {96, 0x22}},
+        {{kWidth, 0x00}},
+    };
+
+    for (SkBlendMode mode : {SkBlendMode::kSrcOver, SkBlendMode::kSrc}) {
+        SkPaint paint;
+        paint.setColor(0xc0336699);
+        paint.setBlendMode(mode);
+
+        SkBitmap bitmaps[2];
+        for (bool batch : {false, true}) {
+            SkBitmap& bm = bitmaps[batch];
+            bm.allocN32Pixels(kWidth, std::size(rows));
+            bm.eraseColor(0xff80c040);
+
+            SkSTArenaAlloc<2048> alloc;
+            SkBlitter* blitter = SkCreateRasterPipelineBlitter(bm.pixmap(), paint, SkMatrix::I(),
+                                                               &alloc, nullptr, SkSurfaceProps());
+            REPORTER_ASSERT(r, blitter);
+
+            for (int y = 0; y < SkToInt(std::size(rows)); y++) {
+                int16_t runs[kWidth + 1] = {};
+                SkAlpha aa[kWidth] = {};
+                int x = 0;
+                for (auto [len, alpha] : rows[y]) {
+                    if (batch) {
+                        runs[x] = len;
+                        aa[x]   = alpha;
+                    } else {
+                        int16_t oneRun[kWidth + 1] = {SkToS16(len)};
+                        SkAlpha oneAA[kWidth] = {alpha};
+                        blitter->blitAntiH(x, y, oneAA, oneRun);
+                    }
+                    x += len;
+                }
+                SkASSERT(x == kWidth);
+                if (batch) {
+                    blitter->blitAntiH(0, y, aa, runs);
+                }
+            }
+        }
+
+        for (int y = 0; y < bitmaps[0].height(); y++)
+        for (int x = 0; x < bitmaps[0].width();  x++) {
+            const uint32_t want = *bitmaps[0].getAddr32(x, y),
+                           got  = *bitmaps[1].getAddr32(x, y);
+            if (want != got) {
+                ERRORF(r, "%s: batched %08x, unbatched %08x at (%d,%d)",
+                       SkBlendMode_Name(mode), got, want, x, y);
+                return;
+            }
+        }
+    }
+}
@@ -302,3 +302,35 @@ DEF_TEST(ResourceCache_purge, reporter) {
         }
     }
 }
+
+static bool test_rec_visitor(const SkResourceCache::Rec&, void*) { return true; }
+
+DEF_TEST(ResourceCache_sharded, reporter) {
+    SkShardedResourceCache cache(4, 100 * 1024 + 3);
+    REPORTER_ASSERT(reporter, cache.shardCount() == 4);
+    REPORTER_ASSERT(reporter, cache.getTotalByteLimit() == 100 * 1024 + 3);
+    REPORTER_ASSERT(reporter, cache.getEffectiveSingleAllocationByteLimit() == 100 * 1024 + 3);
+
+    int flags = 0;
+    for (int i = 0; i < 32; ++i) {
+        auto rec = std::make_unique<TestRec>(1, i, &flags);
+        rec->fCanBePurged = true;
+        cache.add(rec.release());
+    }
+    REPORTER_ASSERT(reporter, cache.getTotalBytesUsed() == 32 * 1024);
+    for (int i = 0; i < 32; ++i) {
+        REPORTER_ASSERT(reporter, cache.find(TestKey(1, i), test_rec_visitor, nullptr));
+    }
+    REPORTER_ASSERT(reporter, !cache.find(TestKey(1, 32), test_rec_visitor, nullptr));
+
+    int visited = 0;
+    cache.visitAll([](const SkResourceCache::Rec&, void* ctx) { ++*(int*)ctx; }, &visited);
+    REPORTER_ASSERT(reporter, visited == 32);
+
+    // Each shard purges against its own share of the budget.
+    REPORTER_ASSERT(reporter, cache.setTotalByteLimit(8 * 1024) == 100 * 1024 + 3);
+    REPORTER_ASSERT(reporter, cache.getTotalBytesUsed() <= 8 * 1024);
+
+    cache.purgeAll();
+    REPORTER_ASSERT(reporter, cache.getTotalBytesUsed() == 0);
+}
@@ -60,3 +60,35 @@ DEF_TEST(SkStrikeCache_CachePurge, Reporter) {
 
 
 }
+
+DEF_TEST(SkStrikeCache_SharedHitsKeepLRU, Reporter) {
+    SkStrikeCache cache;
+
+    SkFont font;
+    font.setTypeface(ToolUtils::create_portable_typeface("serif", SkFontStyle()));
+    SkPaint defaultPaint;
+    auto specForSize = [&](SkScalar size) {
+        font.setSize(size);
+        return SkStrikeSpec::MakeMask(
+                font, defaultPaint, SkSurfaceProps(0, kUnknown_SkPixelGeometry),
+                SkScalerContextFlags::kNone, SkMatrix::I());
+    };
+    SkStrikeSpec a = specForSize(10),
+                 b = specForSize(20),
+                 c = specForSize(30);
+
+    // Created in order, so a is least recently used.
+    a.findOrCreateStrike(&cache);
+    b.findOrCreateStrike(&cache);
+    c.findOrCreateStrike(&cache);
+    REPORTER_ASSERT(Reporter, cache.getCacheCountUsed() == 3);
+
+    // This hit only takes the shared lock, but must still protect a from the next purge.
+    REPORTER_ASSERT(Reporter, a.findOrCreateStrike(&cache) != nullptr);
+
+    cache.setCacheCountLimit(2);
+    REPORTER_ASSERT(Reporter, cache.getCacheCountUsed() == 2);
+    REPORTER_ASSERT(Reporter, cache.findStrike(a.descriptor()) != nullptr);
+    REPORTER_ASSERT(Reporter, cache.findStrike(b.descriptor()) == nullptr);
+    REPORTER_ASSERT(Reporter, cache.findStrike(c.descriptor()) != nullptr);
+}
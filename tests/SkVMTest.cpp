@@ -5,8 +5,14 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkBitmap.h"
+#include "include/core/SkBlendMode.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkColorFilter.h"
 #include "include/core/SkColorType.h"
 #include "include/core/SkData.h"
+#include "include/core/SkGraphics.h"
+#include "include/core/SkPaint.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkScalar.h"
 #include "include/core/SkSpan.h"
@@ -17,6 +23,7 @@
 #include "include/private/base/SkFloatingPoint.h"
 #include "src/base/SkMSAN.h"
 #include "src/core/SkVM.h"
+#include "src/core/SkVMBlitter.h"
 #include "src/sksl/SkSLCompiler.h"
 #include "src/sksl/SkSLProgramSettings.h"
 #include "src/sksl/SkSLUtil.h"
@@ -26,12 +33,14 @@
 #include "src/sksl/tracing/SkVMDebugTrace.h"
 #include "src/utils/SkVMVisualizer.h"
 #include "tests/Test.h"
+#include "tools/ToolUtils.h"
 
 #include <algorithm>
 #include <cmath>
 #include <cstdint>
 #include <cstring>
 #include <initializer_list>
+#include <map>
 #include <memory>
 #include <string>
 #include <utility>
@@ -2903,3 +2912,68 @@ DEF_TEST(SkVM_Visualizer, r) {
                        "<tr class='source'><td class='mask'>&#8617;v9</td>"
                        "<td colspan=2>int main(int x, int y)</td></tr>"));
 }
+
+DEF_TEST(SkVMBlitter_PersistentProgramCache, r) {
+#if defined(SKVM_JIT)
+    struct MemoryPersistentCache : public SkGraphics::PersistentCache {
+        sk_sp<SkData> load(const SkData& key) override {
+            auto found = fEntries.find(as_string(key));
+            if (found == fEntries.end()) {
+                return nullptr;
+            }
+            fHits++;
+            return found->second;
+        }
+        void store(const SkData& key, const SkData& data, const SkString&) override {
+            fEntries[as_string(key)] = SkData::MakeWithCopy(data.data(), data.size());
+            fStores++;
+        }
+        static std::string as_string(const SkData& data) {
+            return std::string(static_cast<const char*>(data.data()), data.size());
+        }
+
+        std::map<std::string, sk_sp<SkData>> fEntries;
+        int                                   fHits   = 0,
+                                              fStores = 0;
+    };
+
+    // Each draw makes its own blitter, using only this cache, so other tests can't interfere.
+    MemoryPersistentCache cache;
+    auto draw = [&] {
+        SkPaint paint;
+        paint.setColor4f({0.25f, 0.5f, 0.75f, 0.5f});
+        paint.setColorFilter(SkColorFilters::Blend(SK_ColorMAGENTA, SkBlendMode::kModulate));
+        SkBitmap bm;
+        bm.allocN32Pixels(16, 16);
+        bm.eraseColor(SK_ColorWHITE);
+        REPORTER_ASSERT(r, SkVMBlitter::DrawPaintForTesting(bm.pixmap(), paint, &cache));
+        return bm;
+    };
+
+    // The first draw compiles its program and stores it...
+    SkBitmap expected = draw();
+    REPORTER_ASSERT(r, cache.fStores == 1);
+    REPORTER_ASSERT(r, cache.fEntries.size() == 1);
+
+    // ... the next loads it back rather than building it again...
+    SkBitmap actual = draw();
+    REPORTER_ASSERT(r, cache.fHits == 1);
+    REPORTER_ASSERT(r, cache.fStores == 1);
+    REPORTER_ASSERT(r, ToolUtils::equal_pixels(expected, actual));
+
+    // ... and entries built from other instructions, or cut short, are rebuilt.
+    sk_sp<SkData>& entry = cache.fEntries.begin()->second;
+    const sk_sp<SkData> good = entry;
+    const size_t kProgramHashOffset = 8;
+    sk_sp<SkData> stale = SkData::MakeWithCopy(good->data(), good->size());
+    static_cast<uint8_t*>(stale->writable_data())[kProgramHashOffset] ^= 0x5a;
+    for (const sk_sp<SkData>& bad : {stale,
+                                     SkData::MakeWithCopy(good->data(), good->size() - 1)}) {
+        entry = bad;
+        const int stores = cache.fStores;
+        actual = draw();
+        REPORTER_ASSERT(r, cache.fStores == stores + 1);
+        REPORTER_ASSERT(r, ToolUtils::equal_pixels(expected, actual));
+    }
+#endif
+}
@@ -618,6 +618,16 @@ DEF_TEST(FILEStreamWithOffset, r) {
         REPORTER_ASSERT(r, !memcmp(expected.get(), actual.get(), remaining));
     };
 
+    auto test_memory_base = [&r, &expected, remaining](SkStream* stream) {
+        // The file is mapped starting at the original offset, too.
+        const void* base = stream->getMemoryBase();
+        REPORTER_ASSERT(r, base);
+        if (base) {
+            REPORTER_ASSERT(r, !memcmp(expected.get(), base, remaining));
+            REPORTER_ASSERT(r, stream->getMemoryBase() == base);
+        }
+    };
+
     auto test_seek_end = [&r, remaining](SkStream* stream) {
         // Cannot seek past the end.
         REPORTER_ASSERT(r, stream->isAtEnd());
@@ -652,6 +662,7 @@ DEF_TEST(FILEStreamWithOffset, r) {
         test_seek(stream);
         test_seek_beginning(stream);
         test_seek_end(stream);
+        test_memory_base(stream);
 
         if (recurse) {
             // Duplicate shares the original offset.
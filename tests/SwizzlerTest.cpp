@@ -9,14 +9,20 @@
 #include "include/core/SkAlphaType.h"
 #include "include/core/SkColorType.h"
 #include "include/core/SkImageInfo.h"
+#include "include/core/SkRect.h"
 #include "include/core/SkSwizzle.h"
+#include "include/private/SkEncodedInfo.h"
+#include "src/base/SkRandom.h"
+#include "src/codec/SkCodecPriv.h"
 #include "src/codec/SkSampler.h"
+#include "src/codec/SkSwizzler.h"
 #include "src/core/SkOpts.h"
 #include "tests/Test.h"
 
 #include <cstdint>
 #include <cstring>
 #include <memory>
+#include <vector>
 
 static void check_fill(skiatest::Reporter* r,
                        const SkImageInfo& imageInfo,
@@ -151,6 +157,170 @@ DEF_TEST(SwizzleOpts, r) {
     REPORTER_ASSERT(r, dst == 0xFA04ADCA);
 }
 
+DEF_TEST(SwizzleOpts_16bit, r) {
+    // Enough pixels to run through the widest SIMD loops and their tails.
+    static constexpr int kMaxCount = 70;
+    uint8_t src[kMaxCount * 8];
+    SkRandom random;
+    for (uint8_t& byte : src) {
+        byte = random.nextU() & 0xFF;
+    }
+
+    // 16-bit channels are big-endian, so each channel keeps its first byte.
+    uint32_t dst[kMaxCount];
+    for (int count = 0; count <= kMaxCount; count++) {
+        SkOpts::RGB16_to_RGB1(dst, src, count);
+        for (int i = 0; i < count; i++) {
+            const uint8_t* p = src + 6*i;
+            REPORTER_ASSERT(r, dst[i] == (0xFF000000 | p[4] << 16 | p[2] << 8 | p[0]));
+        }
+        SkOpts::RGB16_to_BGR1(dst, src, count);
+        for (int i = 0; i < count; i++) {
+            const uint8_t* p = src + 6*i;
+            REPORTER_ASSERT(r, dst[i] == (0xFF000000 | p[0] << 16 | p[2] << 8 | p[4]));
+        }
+        SkOpts::RGBA16_to_RGBA(dst, src, count);
+        for (int i = 0; i < count; i++) {
+            const uint8_t* p = src + 8*i;
+            REPORTER_ASSERT(r, dst[i] == ((uint32_t)p[6] << 24 | p[4] << 16 | p[2] << 8 | p[0]));
+        }
+        SkOpts::RGBA16_to_BGRA(dst, src, count);
+        for (int i = 0; i < count; i++) {
+            const uint8_t* p = src + 8*i;
+            REPORTER_ASSERT(r, dst[i] == ((uint32_t)p[6] << 24 | p[0] << 16 | p[2] << 8 | p[4]));
+        }
+    }
+}
+
+// Sampled swizzles run the optimized procs over gathered pixels. Every pixel converts
+// independently, so they must match the corresponding columns of an unsampled swizzle.
+DEF_TEST(Swizzler_Sampled, r) {
+    static constexpr int kWidth = 101;
+    const struct {
+        SkEncodedInfo::Color color;
+        SkEncodedInfo::Alpha alpha;
+        int                  bitsPerComponent;
+    } srcs[] = {
+        { SkEncodedInfo::kGray_Color,      SkEncodedInfo::kOpaque_Alpha,    8 },
+        { SkEncodedInfo::kGrayAlpha_Color, SkEncodedInfo::kUnpremul_Alpha,  8 },
+        { SkEncodedInfo::kRGB_Color,       SkEncodedInfo::kOpaque_Alpha,    8 },
+        { SkEncodedInfo::kRGBA_Color,      SkEncodedInfo::kUnpremul_Alpha,  8 },
+        { SkEncodedInfo::kRGB_Color,       SkEncodedInfo::kOpaque_Alpha,   16 },
+        { SkEncodedInfo::kRGBA_Color,      SkEncodedInfo::kUnpremul_Alpha, 16 },
+    };
+
+    SkRandom random;
+    std::vector<uint8_t> row(kWidth * 8);
+    for (uint8_t& byte : row) {
+        byte = random.nextU() & 0xFF;
+    }
+
+    for (const auto& src : srcs) {
+        const SkEncodedInfo encodedInfo = SkEncodedInfo::Make(kWidth, 1, src.color, src.alpha,
+                                                              src.bitsPerComponent);
+        for (SkColorType ct : {kRGBA_8888_SkColorType, kBGRA_8888_SkColorType}) {
+            for (SkAlphaType at : {kPremul_SkAlphaType, kUnpremul_SkAlphaType}) {
+                const SkImageInfo info = SkImageInfo::Make(kWidth, 1, ct, at);
+                auto full = SkSwizzler::Make(encodedInfo, nullptr, info, SkCodec::Options());
+                if (!full) {
+                    ERRORF(r, "Could not make a swizzler for color %d", src.color);
+                    continue;
+                }
+                std::vector<uint32_t> expected(kWidth);
+                full->swizzle(expected.data(), row.data());
+
+                for (int sampleX : {2, 3, 4, 7}) {
+                    auto sampled = SkSwizzler::Make(encodedInfo, nullptr, info,
+                                                    SkCodec::Options());
+                    const int width = sampled->setSampleX(sampleX);
+                    std::vector<uint32_t> actual(width);
+                    sampled->swizzle(actual.data(), row.data());
+                    for (int x = 0; x < width; x++) {
+                        REPORTER_ASSERT(r, actual[x] ==
+                                           expected[get_start_coord(sampleX) + x * sampleX],
+                                        "color %d bits %d sampleX %d x %d", src.color,
+                                        src.bitsPerComponent, sampleX, x);
+                    }
+                }
+            }
+        }
+    }
+}
+
+DEF_TEST(Swizzler_Palette, r) {
+    static constexpr int kWidth = 101;
+
+    SkRandom random;
+    std::vector<uint8_t> row(kWidth);
+    for (uint8_t& byte : row) {
+        byte = random.nextU() & 0xFF;
+    }
+    uint32_t ctable[256];
+    for (uint32_t& color : ctable) {
+        color = random.nextU();
+    }
+
+    // Palette indices are packed most significant bit first.
+    auto index = [&](int bits, int x) {
+        const int bit = x * bits;
+        return (row[bit / 8] >> (8 - bits - bit % 8)) & ((1 << bits) - 1);
+    };
+
+    for (int bits : {1, 2, 4, 8}) {
+        const int width = kWidth * 8 / bits;
+        const SkEncodedInfo encodedInfo = SkEncodedInfo::Make(width, 1,
+                SkEncodedInfo::kPalette_Color, SkEncodedInfo::kOpaque_Alpha, bits);
+
+        // Left edges that do and do not fall on a byte boundary.
+        for (int left : {0, 1, 3, 8, 13}) {
+            const SkIRect subset = SkIRect::MakeLTRB(left, 0, width, 1);
+            SkCodec::Options options;
+            options.fSubset = &subset;
+            const SkImageInfo info = SkImageInfo::MakeN32Premul(subset.width(), 1);
+
+            auto swizzler = SkSwizzler::Make(encodedInfo, ctable, info, options);
+            if (!swizzler) {
+                ERRORF(r, "Could not make a swizzler for %d-bit indices", bits);
+                continue;
+            }
+            std::vector<uint32_t> actual(subset.width());
+            swizzler->swizzle(actual.data(), row.data());
+            for (int x = 0; x < subset.width(); x++) {
+                REPORTER_ASSERT(r, actual[x] == ctable[index(bits, left + x)],
+                                "bits %d left %d x %d", bits, left, x);
+            }
+
+            for (int sampleX : {2, 3, 4, 7}) {
+                auto sampled = SkSwizzler::Make(encodedInfo, ctable, info, options);
+                const int sampledWidth = sampled->setSampleX(sampleX);
+                std::vector<uint32_t> samples(sampledWidth);
+                sampled->swizzle(samples.data(), row.data());
+                for (int x = 0; x < sampledWidth; x++) {
+                    const int srcX = left + get_start_coord(sampleX) + x * sampleX;
+                    REPORTER_ASSERT(r, samples[x] == ctable[index(bits, srcX)],
+                                    "bits %d left %d sampleX %d x %d", bits, left, sampleX, x);
+                }
+            }
+        }
+    }
+
+    // Hit every tail length of the SkOpts routines directly.
+    for (int count = 0; count <= 80; count++) {
+        std::vector<uint32_t> dst(count);
+        SkOpts::index_to_8888(dst.data(), row.data(), count, ctable);
+        for (int x = 0; x < count; x++) {
+            REPORTER_ASSERT(r, dst[x] == ctable[row[x]], "count %d x %d", count, x);
+        }
+        for (int bits : {1, 2, 4}) {
+            SkOpts::small_index_to_8888(dst.data(), row.data(), count, bits, ctable);
+            for (int x = 0; x < count; x++) {
+                REPORTER_ASSERT(r, dst[x] == ctable[index(bits, x)],
+                                "bits %d count %d x %d", bits, count, x);
+            }
+        }
+    }
+}
+
 DEF_TEST(PublicSwizzleOpts, r) {
     uint32_t dst, src;
 
@@ -0,0 +1,152 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkPicture.h"
+#include "include/core/SkPoint.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkShader.h"
+#include "include/core/SkStream.h"
+#include "include/core/SkString.h"
+#include "include/core/SkTime.h"
+#include "include/effects/SkGradientShader.h"
+#include "include/encode/SkEncoder.h"
+#include "include/encode/SkJpegEncoder.h"
+#include "include/encode/SkPngEncoder.h"
+#include "src/base/SkRandom.h"
+#include "tools/ProcStats.h"
+#include "tools/flags/CommandLineFlags.h"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+
+// Renders a large image and encodes it either in one piece (--bandHeight 0) or band by band with
+// SkEncoder::encodeBands(), then reports the time taken and the peak resident set size.  Peak
+// RSS is a property of the whole process, so compare the two modes with separate runs, e.g.
+//
+//   out/Release/encode_bands --width 30000 --height 30000 --bandHeight 0
+//   out/Release/encode_bands --width 30000 --height 30000 --bandHeight 256
+
+static DEFINE_string2(skp, s, "", "Optional .skp to render, scaled to the image size.");
+static DEFINE_string2(output, o, "", "Where to write the encoded image.  Discarded if empty.");
+static DEFINE_string(format, "png", "Encoded format: png or jpg.");
+static DEFINE_int(width, 8192, "Width of the image to encode.");
+static DEFINE_int(height, 8192, "Height of the image to encode.");
+static DEFINE_int(bandHeight, 256, "Rows per band; 0 renders and encodes the whole image at once.");
+static DEFINE_int(quality, 90, "Quality of jpg output.");
+
+static std::function<void(SkCanvas*)> make_draw(sk_sp<SkPicture> picture, int w, int h) {
+    if (picture) {
+        return [picture, w, h](SkCanvas* canvas) {
+            const SkRect cull = picture->cullRect();
+            canvas->scale(w / cull.width(), h / cull.height());
+            canvas->translate(-cull.left(), -cull.top());
+            canvas->drawPicture(picture);
+        };
+    }
+
+    return [w, h](SkCanvas* canvas) {
+        const SkPoint pts[] = {{0, 0}, {SkIntToScalar(w), SkIntToScalar(h)}};
+        const SkColor colors[] = {SK_ColorWHITE, SK_ColorCYAN, SK_ColorMAGENTA};
+        SkPaint paint;
+        paint.setShader(SkGradientShader::MakeLinear(pts, colors, nullptr, std::size(colors),
+                                                     SkTileMode::kClamp));
+        canvas->drawPaint(paint);
+
+        // Enough detail that the encoders have real work to do, without the draw dominating.
+        SkRandom rand;
+        paint.setShader(nullptr);
+        paint.setAntiAlias(true);
+        for (int i = 0; i < 1000; i++) {
+            paint.setColor(rand.nextU() | 0xff000000);
+            canvas->drawCircle(rand.nextRangeF(0, w), rand.nextRangeF(0, h),
+                               rand.nextRangeF(1, SkIntToScalar(std::min(w, h)) / 16), paint);
+        }
+    };
+}
+
+int main(int argc, char** argv) {
+    CommandLineFlags::SetUsage("Renders and encodes a large image, reporting peak RSS.");
+    CommandLineFlags::Parse(argc, argv);
+
+    const bool jpeg = 0 == strcmp(FLAGS_format[0], "jpg") || 0 == strcmp(FLAGS_format[0], "jpeg");
+    if (!jpeg && 0 != strcmp(FLAGS_format[0], "png")) {
+        SkDebugf("Unsupported format %s\n", FLAGS_format[0]);
+        return 1;
+    }
+
+    sk_sp<SkPicture> picture;
+    if (!FLAGS_skp.isEmpty()) {
+        std::unique_ptr<SkStream> stream = SkStream::MakeFromFile(FLAGS_skp[0]);
+        picture = stream ? SkPicture::MakeFromStream(stream.get()) : nullptr;
+        if (!picture) {
+            SkDebugf("Could not read %s\n", FLAGS_skp[0]);
+            return 1;
+        }
+    }
+
+    std::unique_ptr<SkWStream> dst;
+    if (!FLAGS_output.isEmpty()) {
+        auto file = std::make_unique<SkFILEWStream>(FLAGS_output[0]);
+        if (!file->isValid()) {
+            SkDebugf("Could not open %s\n", FLAGS_output[0]);
+            return 1;
+        }
+        dst = std::move(file);
+    } else {
+        dst = std::make_unique<SkNullWStream>();
+    }
+
+    // Jpegs are opaque, so let the jpeg encoder skip the alpha channel entirely.
+    const SkImageInfo info = SkImageInfo::MakeN32(FLAGS_width, FLAGS_height,
+                                                  jpeg ? kOpaque_SkAlphaType : kPremul_SkAlphaType);
+    auto draw = make_draw(picture, info.width(), info.height());
+    SkJpegEncoder::Options jpegOptions;
+    jpegOptions.fQuality = FLAGS_quality;
+
+    const double start = SkTime::GetMSecs();
+    bool success;
+    if (FLAGS_bandHeight <= 0) {
+        SkBitmap bitmap;
+        if (!bitmap.tryAllocPixels(info)) {
+            SkDebugf("Could not allocate %dx%d\n", info.width(), info.height());
+            return 1;
+        }
+        bitmap.eraseColor(SK_ColorTRANSPARENT);
+        SkCanvas canvas(bitmap);
+        draw(&canvas);
+        success = jpeg ? SkJpegEncoder::Encode(dst.get(), bitmap.pixmap(), jpegOptions)
+                       : SkPngEncoder::Encode(dst.get(), bitmap.pixmap(), {});
+    } else {
+        std::unique_ptr<SkEncoder> encoder =
+                jpeg ? SkJpegEncoder::Make(dst.get(), info, jpegOptions)
+                     : SkPngEncoder::Make(dst.get(), info, {});
+        success = encoder && encoder->encodeBands(FLAGS_bandHeight, draw);
+    }
+    dst->flush();
+    const double elapsed = SkTime::GetMSecs() - start;
+
+    if (!success) {
+        SkDebugf("Encoding failed\n");
+        return 1;
+    }
+
+    SkDebugf("%dx%d %s, %s: %.1f ms, %zu bytes, peak RSS %d MB\n",
+             info.width(), info.height(), jpeg ? "jpg" : "png",
+             FLAGS_bandHeight > 0 ? SkStringPrintf("%d-row bands", FLAGS_bandHeight).c_str()
+                                  : "whole image",
+             elapsed, dst->bytesWritten(), sk_tools::getMaxResidentSetSizeMB());
+    return 0;
+}
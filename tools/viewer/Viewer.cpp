@@ -2702,9 +2702,9 @@ void Viewer::drawImGui() {
                 // First, go through the cache and restore the original program if we were hovering
                 if (!fHoveredProgram.empty()) {
                     auto restoreHoveredProgram = [this](const SkVMBlitter::Key* key,
-                                                        skvm::Program* program) {
+                                                        sk_sp<SkVMBlitter::CachedProgram>* cached) {
                         if (*key == fHoveredKey) {
-                            *program = std::move(fHoveredProgram);
+                            (*cached)->fProgram = std::move(fHoveredProgram);
                             fHoveredProgram = {};
                         }
                     };
@@ -2713,7 +2713,13 @@ void Viewer::drawImGui() {
 
                 // Now iterate again, and dump any expanded program. If any program is hovered,
                 // patch it, and remember the original (so it can be restored next frame).
-                auto showVMEntry = [this](const SkVMBlitter::Key* key, skvm::Program* program) {
+                auto showVMEntry = [this](const SkVMBlitter::Key* key,
+                                          sk_sp<SkVMBlitter::CachedProgram>* cached) {
+                    // Skip programs still being compiled, or that couldn't be shared.
+                    skvm::Program* program = &(*cached)->fProgram;
+                    if (program->empty()) {
+                        return;
+                    }
                     SkString keyString = SkVMBlitter::DebugName(*key);
                     bool inTreeNode = ImGui::TreeNode(keyString.c_str());
                     bool hovered = ImGui::IsItemHovered();